@@ -0,0 +1,445 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include "dsp/OptoCompressor.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+
+#if JUCE_LINUX
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+#if JUCE_INTEL
+ #include <x86intrin.h>
+#endif
+
+/**
+ * DSP benchmark
+ *
+ * Drives OptoCompressor and AuDemoProcessor::processBlock over a matrix of
+ * sample rates, block sizes, channel counts, modes and signal levels, and
+ * writes one JSON record per case:
+ *
+ * - nsPerSample: wall time per sample frame (best of the repetitions)
+ * - instructionsPerSample: user-space instructions retired (perf_event_open;
+ *   null where unavailable)
+ * - cyclesPerBlock: CPU cycles (perf_event_open), or TSC ticks on x86 when
+ *   perf counters are unavailable; cycleSource says which
+ *
+ * With --compare=<baseline.json>, cases whose ns/sample (or instructions/sample,
+ * when both runs have them) grew by more than --threshold percent are listed
+ * and the exit code is 1.
+ *
+ * Usage: LA2ATeroBench [--output=<file.json>] [--compare=<baseline.json>]
+ *                      [--threshold=10] [--seconds=0.25] [--quick]
+ */
+namespace
+{
+//==============================================================================
+// Hardware counters for the calling thread (Linux only)
+class PerfCounter
+{
+public:
+    explicit PerfCounter(juce::uint64 config)
+    {
+       #if JUCE_LINUX
+        perf_event_attr attributes {};
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        fd = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+       #else
+        juce::ignoreUnused(config);
+       #endif
+    }
+
+    ~PerfCounter()
+    {
+       #if JUCE_LINUX
+        if (fd >= 0)
+            close(fd);
+       #endif
+    }
+
+    bool isAvailable() const { return fd >= 0; }
+
+    void start()
+    {
+       #if JUCE_LINUX
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+       #endif
+    }
+
+    juce::uint64 stop()
+    {
+        juce::uint64 count = 0;
+
+       #if JUCE_LINUX
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+                count = 0;
+        }
+       #endif
+
+        return count;
+    }
+
+private:
+    int fd = -1;
+
+    JUCE_DECLARE_NON_COPYABLE(PerfCounter)
+};
+
+#if JUCE_LINUX
+constexpr juce::uint64 INSTRUCTIONS = PERF_COUNT_HW_INSTRUCTIONS;
+constexpr juce::uint64 CYCLES = PERF_COUNT_HW_CPU_CYCLES;
+#else
+constexpr juce::uint64 INSTRUCTIONS = 0;
+constexpr juce::uint64 CYCLES = 0;
+#endif
+
+juce::uint64 readTimestampCounter()
+{
+   #if JUCE_INTEL
+    return __rdtsc();
+   #else
+    return 0;
+   #endif
+}
+
+//==============================================================================
+struct Case
+{
+    juce::String engine;        // "compressor" or "processor"
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    int numChannels = 2;
+    juce::String mode;          // "comp", "limit" or "british"
+    juce::String signal;        // "quiet", "moderate" or "heavy"
+
+    juce::String getKey() const
+    {
+        return engine + "/" + juce::String(juce::roundToInt(sampleRate)) + "/" + juce::String(blockSize) + "/"
+             + juce::String(numChannels) + "ch/" + mode + "/" + signal;
+    }
+};
+
+struct Result
+{
+    double nsPerSample = 0.0;
+    double instructionsPerSample = -1.0;   // < 0: not measured
+    double cyclesPerBlock = 0.0;
+};
+
+// Band-limited noise at the signal's level: below the threshold (quiet), a few
+// dB of gain reduction (moderate), or deep in it (heavy)
+juce::AudioBuffer<float> makeSignal(const juce::String& signal, int numChannels, int numSamples)
+{
+    const float levelDb = signal == "quiet" ? -50.0f : signal == "moderate" ? -20.0f : -3.0f;
+    const float gain = juce::Decibels::decibelsToGain(levelDb) * 1.7f;   // Peak-ish to RMS of the filtered noise
+
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+    juce::Random random(42);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float state = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            state = 0.7f * state + 0.3f * (2.0f * random.nextFloat() - 1.0f);
+            buffer.setSample(ch, i, gain * state);
+        }
+    }
+
+    return buffer;
+}
+
+// Runs process(block) over the whole buffer, block by block
+template <typename ProcessFn>
+void processInBlocks(juce::AudioBuffer<float>& buffer, int blockSize, ProcessFn&& process)
+{
+    for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+    {
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start,
+                                       juce::jmin(blockSize, buffer.getNumSamples() - start));
+        process(block);
+    }
+}
+
+class Bench
+{
+public:
+    Bench(double secondsPerCase, int repetitionCount)
+        : seconds(secondsPerCase), repetitions(repetitionCount) {}
+
+    bool hasInstructionCounts() const { return instructions.isAvailable(); }
+    const char* getCycleSource() const { return cycles.isAvailable() ? "perf" : "tsc"; }
+
+    Result run(const Case& benchCase)
+    {
+        const int numSamples = juce::jmax(benchCase.blockSize, static_cast<int>(benchCase.sampleRate * seconds));
+        const auto stimulus = makeSignal(benchCase.signal, benchCase.numChannels, numSamples);
+        juce::AudioBuffer<float> work(benchCase.numChannels, numSamples);
+
+        if (benchCase.engine == "compressor")
+        {
+            OptoCompressor compressor;
+            compressor.setPeakReduction(60.0f);
+            compressor.setGain(6.0f);
+            compressor.setLimitMode(benchCase.mode == "limit");
+            compressor.setBritishMode(benchCase.mode == "british");
+            compressor.prepare(benchCase.sampleRate, benchCase.blockSize, benchCase.numChannels);
+
+            return measure(benchCase, stimulus, work, [&compressor](juce::AudioBuffer<float>& block) {
+                compressor.processBlock(block);
+            });
+        }
+
+        AuDemoProcessor processor;
+        auto& apvts = processor.getApvts();
+
+        auto set = [&apvts](const char* id, float value) {
+            auto* parameter = apvts.getParameter(id);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        };
+
+        set("peakReduction", 60.0f);
+        set("gain", 6.0f);
+        set("limitMode", benchCase.mode != "comp" ? 1.0f : 0.0f);
+        set("compMode", benchCase.mode != "limit" ? 1.0f : 0.0f);
+
+        processor.setPlayConfigDetails(benchCase.numChannels, benchCase.numChannels, benchCase.sampleRate, benchCase.blockSize);
+        processor.prepareToPlay(benchCase.sampleRate, benchCase.blockSize);
+
+        juce::MidiBuffer midi;
+        return measure(benchCase, stimulus, work, [&processor, &midi](juce::AudioBuffer<float>& block) {
+            processor.processBlock(block, midi);
+        });
+    }
+
+private:
+    template <typename ProcessFn>
+    Result measure(const Case& benchCase, const juce::AudioBuffer<float>& stimulus,
+                   juce::AudioBuffer<float>& work, ProcessFn&& process)
+    {
+        const int numSamples = stimulus.getNumSamples();
+        const int numBlocks = (numSamples + benchCase.blockSize - 1) / benchCase.blockSize;
+        Result best;
+        best.nsPerSample = std::numeric_limits<double>::max();
+
+        // First pass warms caches and envelopes and isn't counted
+        for (int repetition = -1; repetition < repetitions; ++repetition)
+        {
+            work.makeCopyOf(stimulus, true);
+
+            instructions.start();
+            cycles.start();
+            const auto tscStart = readTimestampCounter();
+            const auto start = std::chrono::steady_clock::now();
+
+            processInBlocks(work, benchCase.blockSize, process);
+
+            const auto end = std::chrono::steady_clock::now();
+            const auto tscEnd = readTimestampCounter();
+            const auto cycleCount = cycles.stop();
+            const auto instructionCount = instructions.stop();
+
+            if (repetition < 0)
+                continue;
+
+            const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+            if (ns / numSamples < best.nsPerSample)
+            {
+                best.nsPerSample = ns / numSamples;
+                best.cyclesPerBlock = static_cast<double>(cycles.isAvailable() ? cycleCount : tscEnd - tscStart) / numBlocks;
+
+                if (instructions.isAvailable())
+                    best.instructionsPerSample = static_cast<double>(instructionCount) / numSamples;
+            }
+        }
+
+        return best;
+    }
+
+    double seconds;
+    int repetitions;
+    PerfCounter instructions { INSTRUCTIONS };
+    PerfCounter cycles { CYCLES };
+};
+
+std::vector<Case> buildMatrix(bool quick)
+{
+    const std::vector<double> sampleRates = quick ? std::vector<double> { 48000.0 }
+                                                  : std::vector<double> { 44100.0, 48000.0, 96000.0, 192000.0 };
+    const std::vector<int> blockSizes = quick ? std::vector<int> { 1, 64, 512 }
+                                              : std::vector<int> { 1, 16, 64, 256, 1024, 8192 };
+
+    std::vector<Case> cases;
+
+    for (const char* engine : { "compressor", "processor" })
+        for (auto sampleRate : sampleRates)
+            for (auto blockSize : blockSizes)
+                for (int numChannels : { 1, 2 })
+                    for (const char* mode : { "comp", "limit", "british" })
+                        for (const char* signal : { "quiet", "moderate", "heavy" })
+                            cases.push_back({ engine, sampleRate, blockSize, numChannels, mode, signal });
+
+    return cases;
+}
+
+juce::var toJson(const Case& benchCase, const Result& result)
+{
+    auto* object = new juce::DynamicObject();
+    object->setProperty("key", benchCase.getKey());
+    object->setProperty("engine", benchCase.engine);
+    object->setProperty("sampleRate", benchCase.sampleRate);
+    object->setProperty("blockSize", benchCase.blockSize);
+    object->setProperty("channels", benchCase.numChannels);
+    object->setProperty("mode", benchCase.mode);
+    object->setProperty("signal", benchCase.signal);
+    object->setProperty("nsPerSample", result.nsPerSample);
+    object->setProperty("instructionsPerSample", result.instructionsPerSample >= 0.0 ? juce::var(result.instructionsPerSample) : juce::var());
+    object->setProperty("cyclesPerBlock", result.cyclesPerBlock);
+    return juce::var(object);
+}
+
+// Returns the number of regressions
+int compareWithBaseline(const juce::var& current, const juce::var& baseline, double thresholdPercent)
+{
+    std::map<juce::String, juce::var> baselineCases;
+    if (auto* cases = baseline["cases"].getArray())
+        for (const auto& record : *cases)
+            baselineCases[record["key"].toString()] = record;
+
+    int regressions = 0;
+    int compared = 0;
+    const double limit = 1.0 + thresholdPercent / 100.0;
+
+    auto check = [&](const juce::var& now, const juce::var& then, const char* metric) {
+        const auto a = now[metric];
+        const auto b = then[metric];
+
+        if (a.isVoid() || b.isVoid() || static_cast<double>(b) <= 0.0)
+            return false;
+
+        const double ratio = static_cast<double>(a) / static_cast<double>(b);
+        if (ratio <= limit)
+            return false;
+
+        std::cout << "REGRESSION " << now["key"].toString() << " " << metric << " "
+                  << juce::String(static_cast<double>(b), 2) << " -> " << juce::String(static_cast<double>(a), 2)
+                  << " (+" << juce::String((ratio - 1.0) * 100.0, 1) << "%)" << std::endl;
+        return true;
+    };
+
+    if (auto* cases = current["cases"].getArray())
+    {
+        for (const auto& record : *cases)
+        {
+            const auto found = baselineCases.find(record["key"].toString());
+            if (found == baselineCases.end())
+                continue;
+
+            ++compared;
+            const bool slower = check(record, found->second, "nsPerSample");
+            const bool moreInstructions = check(record, found->second, "instructionsPerSample");
+
+            if (slower || moreInstructions)
+                ++regressions;
+        }
+    }
+
+    std::cout << "Compared " << compared << " cases against the baseline (threshold " << thresholdPercent
+              << "%): " << regressions << " regression(s)" << std::endl;
+    return regressions;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    const bool quick = args.containsOption("--quick");
+    const double seconds = args.containsOption("--seconds") ? juce::jmax(0.01, args.getValueForOption("--seconds").getDoubleValue()) : 0.25;
+    const double threshold = args.containsOption("--threshold") ? args.getValueForOption("--threshold").getDoubleValue() : 10.0;
+
+    Bench bench(seconds, 3);
+    const auto cases = buildMatrix(quick);
+
+    std::cerr << "LA2ATero DSP benchmark: " << cases.size() << " cases, instructions "
+              << (bench.hasInstructionCounts() ? "counted" : "unavailable") << ", cycles from "
+              << bench.getCycleSource() << std::endl;
+
+    juce::Array<juce::var> records;
+    for (const auto& benchCase : cases)
+    {
+        const auto result = bench.run(benchCase);
+        records.add(toJson(benchCase, result));
+        std::cerr << benchCase.getKey().paddedRight(' ', 44) << juce::String(result.nsPerSample, 2).paddedLeft(' ', 9) << " ns/sample" << std::endl;
+    }
+
+    // Per-instance object sizes; the hot working set is what the opto cell path
+    // of each instance touches every sample (the output stage is on top)
+    auto* footprint = new juce::DynamicObject();
+    footprint->setProperty("optoCompressorBytes", static_cast<int>(sizeof(OptoCompressor)));
+    footprint->setProperty("optoCompressorHotBytes", static_cast<int>(OptoCompressor::getHotWorkingSetBytes()));
+    footprint->setProperty("abCompressorBytes", static_cast<int>(sizeof(ABCompressor)));
+    footprint->setProperty("processorBytes", static_cast<int>(sizeof(AuDemoProcessor)));
+
+    std::cerr << "Footprint: OptoCompressor " << sizeof(OptoCompressor) << " bytes ("
+              << OptoCompressor::getHotWorkingSetBytes() << " per sample in the opto cell path), ABCompressor "
+              << sizeof(ABCompressor) << ", AuDemoProcessor " << sizeof(AuDemoProcessor) << std::endl;
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("version", 1);
+    root->setProperty("cycleSource", bench.getCycleSource());
+    root->setProperty("footprint", juce::var(footprint));
+    root->setProperty("cases", records);
+    const juce::var report(root);
+
+    const auto json = juce::JSON::toString(report);
+
+    if (args.containsOption("--output"))
+    {
+        const auto outputFile = args.getFileForOption("--output");
+        if (! outputFile.replaceWithText(json))
+        {
+            std::cerr << "Can't write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    if (args.containsOption("--compare"))
+    {
+        const auto baselineFile = args.getFileForOption("--compare");
+        const auto baseline = juce::JSON::parse(baselineFile.loadFileAsString());
+
+        if (! baseline.isObject())
+        {
+            std::cerr << "Can't read baseline " << baselineFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        return compareWithBaseline(report, baseline, threshold) > 0 ? 1 : 0;
+    }
+
+    return 0;
+}
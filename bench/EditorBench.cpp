@@ -0,0 +1,192 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+#include "HarnessHelpers.h"
+#include <functional>
+#include <iostream>
+#include <vector>
+
+/**
+ * Editor open-latency benchmark
+ *
+ * Constructs the editor and paints it once into an offscreen image, many times,
+ * and reports p50/p99 of constructor, first paint and total open time. After
+ * the first paint the message loop runs until the raster cache has delivered
+ * the background renders that paint queued and the editor's timer has made its
+ * first meter update, which gives the time until the editor is complete and
+ * live (from its startup timeline).
+ *
+ * Memory per editor is the resident-size growth with MEMORY_EDITORS editors
+ * open at once.
+ *
+ * Usage: LA2ATeroEditorBench [--iterations=N]
+ */
+namespace
+{
+using HarnessHelpers::Percentiles;
+using HarnessHelpers::summarise;
+using HarnessHelpers::residentBytes;
+
+constexpr int MEMORY_EDITORS = 32;
+constexpr int MESSAGE_LOOP_TIMEOUT_MS = 2000;
+
+// Runs the message loop until done() holds; false on timeout
+bool runMessageLoopUntil(const std::function<bool()>& done)
+{
+    const auto end = juce::Time::getMillisecondCounterHiRes() + MESSAGE_LOOP_TIMEOUT_MS;
+
+    while (! done())
+    {
+        if (juce::Time::getMillisecondCounterHiRes() > end)
+            return false;
+
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(1);
+    }
+
+    return true;
+}
+
+void paintOffscreen(juce::Component& component)
+{
+    juce::Image target(juce::Image::ARGB, component.getWidth(), component.getHeight(), true);
+    juce::Graphics g(target);
+    component.paintEntireComponent(g, true);
+}
+
+void printRow(const char* scenario, const char* phase, const Percentiles& p)
+{
+    std::cout << juce::String(scenario).paddedRight(' ', 6)
+              << juce::String(phase).paddedRight(' ', 12)
+              << " p50 " << juce::String(p.p50, 3).paddedLeft(' ', 8) << " ms"
+              << "  p99 " << juce::String(p.p99, 3).paddedLeft(' ', 8) << " ms"
+              << "  max " << juce::String(p.max, 3).paddedLeft(' ', 8) << " ms" << std::endl;
+}
+
+// Opens an editor the way a host does: construct, first paint, then the
+// message loop until the background rasters and the first meter update are in
+struct OpenedEditor
+{
+    std::unique_ptr<AuDemoEditor> editor;
+    double constructMs = 0.0;
+    double paintMs = 0.0;
+    double rastersReadyMs = 0.0;
+    bool complete = false;
+};
+
+OpenedEditor openEditor(AuDemoProcessor& processor)
+{
+    OpenedEditor opened;
+
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+    opened.editor.reset(dynamic_cast<AuDemoEditor*>(processor.createEditor()));
+    const auto constructed = juce::Time::getMillisecondCounterHiRes();
+
+    paintOffscreen(*opened.editor);
+    const auto painted = juce::Time::getMillisecondCounterHiRes();
+
+    juce::SharedResourcePointer<SharedGuiResources> resources;
+    const bool rastersReady = runMessageLoopUntil([&resources] {
+        return resources->getRasterCache().getNumPendingRenders() == 0;
+    });
+    const auto ready = juce::Time::getMillisecondCounterHiRes();
+
+    auto* editor = opened.editor.get();
+    const bool meterUpdated = runMessageLoopUntil([editor] {
+        return editor->getStartupTimeline().firstMeterUpdate >= 0.0;
+    });
+
+    opened.constructMs = constructed - start;
+    opened.paintMs = painted - constructed;
+    opened.rastersReadyMs = ready - start;
+    opened.complete = rastersReady && meterUpdated;
+    return opened;
+}
+
+bool runScenario(const char* scenario, AuDemoProcessor& processor, int iterations)
+{
+    std::vector<double> constructMs, paintMs, openMs, rastersReadyMs, firstMeterMs;
+    for (auto* samples : { &constructMs, &paintMs, &openMs, &rastersReadyMs, &firstMeterMs })
+        samples->reserve(static_cast<size_t>(iterations));
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        const auto opened = openEditor(processor);
+
+        if (! opened.complete)
+        {
+            std::cerr << scenario << ": editor not complete after " << MESSAGE_LOOP_TIMEOUT_MS << " ms" << std::endl;
+            return false;
+        }
+
+        constructMs.push_back(opened.constructMs);
+        paintMs.push_back(opened.paintMs);
+        openMs.push_back(opened.constructMs + opened.paintMs);
+        rastersReadyMs.push_back(opened.rastersReadyMs);
+        firstMeterMs.push_back(opened.editor->getStartupTimeline().firstMeterUpdate);
+    }
+
+    printRow(scenario, "construct", summarise(constructMs));
+    printRow(scenario, "first paint", summarise(paintMs));
+    printRow(scenario, "open", summarise(openMs));
+    printRow(scenario, "rasters", summarise(rastersReadyMs));
+    printRow(scenario, "first meter", summarise(firstMeterMs));
+    return true;
+}
+
+// Resident growth per editor with several open at once (after their first
+// paint and rasters, so lazily created images are included)
+void reportMemory(AuDemoProcessor& processor)
+{
+    std::vector<OpenedEditor> editors;
+    editors.reserve(MEMORY_EDITORS);
+
+    const auto before = residentBytes();
+
+    for (int i = 0; i < MEMORY_EDITORS; ++i)
+        editors.push_back(openEditor(processor));
+
+    const auto after = residentBytes();
+    const auto sharedBytes = editors.front().editor->getSharedMemoryBytes();
+
+    std::cout << juce::String("warm").paddedRight(' ', 6) << "memory       ";
+
+    if (before > 0 && after > before)
+        std::cout << juce::String(static_cast<double>(after - before) / 1024.0 / MEMORY_EDITORS, 1)
+                  << " KiB per editor (resident, " << MEMORY_EDITORS << " open)";
+    else
+        std::cout << "resident size not available";
+
+    std::cout << ", shared cache " << sharedBytes << " bytes" << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    int iterations = 200;
+    if (args.containsOption("--iterations"))
+        iterations = juce::jmax(1, args.getValueForOption("--iterations").getIntValue());
+
+    AuDemoProcessor processor;
+    processor.prepareToPlay(48000.0, 512);
+
+    std::cout << "LA2ATero editor open latency, " << iterations << " iterations" << std::endl;
+
+    // Cold: each editor is the only one open, so shared resources are rebuilt every time
+    if (! runScenario("cold", processor, iterations))
+        return 1;
+
+    // Warm: another editor keeps the shared look-and-feel, typefaces and rasters alive
+    {
+        const auto keepAlive = openEditor(processor);
+
+        if (! runScenario("warm", processor, iterations))
+            return 1;
+
+        reportMemory(processor);
+    }
+
+    return 0;
+}
@@ -0,0 +1,433 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include "dsp/OptoCompressor.h"
+#include "HarnessHelpers.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Host scaling benchmark
+ *
+ * Loads the built LA2ATero VST3 N times through VST3PluginFormatHeadless and
+ * drives every instance from a simulated audio callback, spread over a worker
+ * pool the way a multi-threaded host does. The same session is then run with
+ * AuDemoProcessor compiled in (no plugin wrapper) and with bare
+ * OptoCompressors, so the per-instance cost splits into DSP, processor
+ * (APVTS, metering, A/B, output stage) and VST3 wrapper.
+ *
+ * Reports per layer: instantiation time (first, p50, p99), resident memory per
+ * instance, aggregate time per callback (p50, p99, max, as % of the buffer
+ * deadline) and the mean processing time per instance per block.
+ *
+ * Usage: LA2ATeroHostBench [--plugin=<LA2ATero.vst3>] [--instances=N]
+ *                          [--threads=N] [--block=N] [--rate=Hz] [--seconds=S]
+ */
+namespace
+{
+using HarnessHelpers::Percentiles;
+using HarnessHelpers::summarise;
+using HarnessHelpers::residentBytes;
+
+// Nanosecond clock: JUCE's high resolution ticks are microseconds on Linux,
+// coarser than a bare OptoCompressor instantiation
+using Clock = std::chrono::steady_clock;
+
+double elapsedMicroseconds(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+//==============================================================================
+/** One way of running an LA2ATero instance: hosted VST3, direct processor or bare DSP */
+class Layer
+{
+public:
+    explicit Layer(const char* layerName) : name(layerName) {}
+    virtual ~Layer() = default;
+
+    virtual bool addInstance(double sampleRate, int blockSize, juce::String& error) = 0;
+    virtual void prepare(double sampleRate, int blockSize) = 0;
+    virtual void process(size_t index, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) = 0;
+
+    const char* name;
+    std::vector<double> createUs;
+    size_t bytesPerInstance = 0;
+};
+
+class ProcessorLayer : public Layer
+{
+public:
+    using Factory = std::function<std::unique_ptr<juce::AudioProcessor>(double, int, juce::String&)>;
+
+    // Parameter name and normalised value. Set by name because a hosted VST3
+    // expects its own state format from setStateInformation, not the plugin's.
+    using Settings = std::vector<std::pair<juce::String, float>>;
+
+    ProcessorLayer(const char* layerName, Factory factoryToUse, const Settings& settingsToApply)
+        : Layer(layerName), factory(std::move(factoryToUse)), settings(settingsToApply) {}
+
+    ~ProcessorLayer() override
+    {
+        for (auto& instance : instances)
+            instance->releaseResources();
+    }
+
+    bool addInstance(double sampleRate, int blockSize, juce::String& error) override
+    {
+        const auto start = Clock::now();
+        auto instance = factory(sampleRate, blockSize, error);
+        if (instance == nullptr)
+            return false;
+
+        for (auto* parameter : instance->getParameters())
+            for (const auto& [parameterName, value] : settings)
+                if (parameter->getName(64) == parameterName)
+                    parameter->setValueNotifyingHost(value);
+
+        createUs.push_back(elapsedMicroseconds(start));
+        instances.push_back(std::move(instance));
+        return true;
+    }
+
+    void prepare(double sampleRate, int blockSize) override
+    {
+        for (auto& instance : instances)
+        {
+            instance->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+            instance->prepareToPlay(sampleRate, blockSize);
+        }
+    }
+
+    void process(size_t index, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) override
+    {
+        midi.clear();
+        instances[index]->processBlock(buffer, midi);
+    }
+
+private:
+    Factory factory;
+    Settings settings;
+    std::vector<std::unique_ptr<juce::AudioProcessor>> instances;
+};
+
+class DspLayer : public Layer
+{
+public:
+    DspLayer(float peakReductionToUse, float gainToUse)
+        : Layer("dsp"), peakReduction(peakReductionToUse), gain(gainToUse) {}
+
+    bool addInstance(double, int, juce::String&) override
+    {
+        const auto start = Clock::now();
+        auto compressor = std::make_unique<OptoCompressor>();
+        compressor->setPeakReduction(peakReduction);
+        compressor->setGain(gain);
+        createUs.push_back(elapsedMicroseconds(start));
+        compressors.push_back(std::move(compressor));
+        return true;
+    }
+
+    void prepare(double sampleRate, int blockSize) override
+    {
+        for (auto& compressor : compressors)
+            compressor->prepare(sampleRate, blockSize, 2);
+    }
+
+    void process(size_t index, juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override
+    {
+        compressors[index]->processBlock(buffer);
+    }
+
+private:
+    float peakReduction, gain;
+    std::vector<std::unique_ptr<OptoCompressor>> compressors;
+};
+
+//==============================================================================
+/**
+ * Simulated host callback: every instance is processed once per callback, the
+ * instances being taken in turn by the calling thread and numThreads - 1
+ * spinning workers, like a host's audio worker group. Each instance has its
+ * own buffer, refilled from the shared input before its (timed) process call.
+ */
+class CallbackPool
+{
+public:
+    CallbackPool(int numThreads, int blockSize, size_t maxInstances)
+        : workers(static_cast<size_t>(numThreads))
+    {
+        input.setSize(2, blockSize);
+        juce::Random random(0x4c41);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(ch, i, 0.5f * (2.0f * random.nextFloat() - 1.0f));
+
+        buffers.reserve(maxInstances);
+        for (size_t i = 0; i < maxInstances; ++i)
+            buffers.emplace_back(2, blockSize);
+
+        for (int w = 1; w < numThreads; ++w)
+            threads.emplace_back([this, w] { workerLoop(static_cast<size_t>(w)); });
+    }
+
+    ~CallbackPool()
+    {
+        stopping.store(true);
+        generation.fetch_add(1);
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    // Runs one callback over numInstances instances of the layer; returns its wall time in us
+    double runCallback(Layer& layer, size_t numInstances)
+    {
+        const auto start = Clock::now();
+
+        // A worker still leaving the previous callback may take a job as soon as
+        // nextJob is reset, so everything else is published first
+        currentLayer = &layer;
+        jobCount.store(numInstances);
+        pending.store(numInstances);
+        nextJob.store(0);
+        generation.fetch_add(1);
+
+        runJobs(0);
+
+        while (pending.load() > 0)
+            std::this_thread::yield();
+
+        return elapsedMicroseconds(start);
+    }
+
+    // Sum over all instances and callbacks of the timed process calls, since the last reset
+    double takeProcessingSeconds()
+    {
+        Clock::duration total {};
+        for (auto& worker : workers)
+            total += std::exchange(worker.processingTime, Clock::duration {});
+
+        return std::chrono::duration<double>(total).count();
+    }
+
+private:
+    struct alignas(64) Worker
+    {
+        Clock::duration processingTime {};
+        juce::MidiBuffer midi;
+    };
+
+    void runJobs(size_t workerIndex)
+    {
+        auto& worker = workers[workerIndex];
+
+        for (auto job = nextJob.fetch_add(1); job < jobCount.load(); job = nextJob.fetch_add(1))
+        {
+            auto& buffer = buffers[job];
+            for (int ch = 0; ch < 2; ++ch)
+                buffer.copyFrom(ch, 0, input, ch, 0, input.getNumSamples());
+
+            const auto start = Clock::now();
+            currentLayer->process(job, buffer, worker.midi);
+            worker.processingTime += Clock::now() - start;
+
+            pending.fetch_sub(1);
+        }
+    }
+
+    void workerLoop(size_t workerIndex)
+    {
+        auto seen = generation.load();
+
+        for (;;)
+        {
+            int spins = 0;
+            while (generation.load() == seen)
+                if (++spins > 1000)
+                    std::this_thread::yield();
+
+            seen = generation.load();
+            if (stopping.load())
+                return;
+
+            runJobs(workerIndex);
+        }
+    }
+
+    juce::AudioBuffer<float> input;
+    std::vector<juce::AudioBuffer<float>> buffers;
+    std::vector<Worker> workers;
+    std::vector<std::thread> threads;
+
+    Layer* currentLayer = nullptr;
+    std::atomic<size_t> jobCount { 0 };
+    std::atomic<size_t> nextJob { 0 };
+    std::atomic<size_t> pending { 0 };
+    std::atomic<juce::uint32> generation { 0 };
+    std::atomic<bool> stopping { false };
+};
+
+//==============================================================================
+struct LayerResult
+{
+    Percentiles create, callback;
+    double firstCreateUs = 0.0;
+    double usPerInstanceBlock = 0.0;
+    size_t bytesPerInstance = 0;
+};
+
+bool instantiate(Layer& layer, int instances, double sampleRate, int blockSize)
+{
+    const auto before = residentBytes();
+    juce::String error;
+
+    for (int i = 0; i < instances; ++i)
+    {
+        if (! layer.addInstance(sampleRate, blockSize, error))
+        {
+            std::cerr << layer.name << ": instance " << i << " failed: " << error << std::endl;
+            return false;
+        }
+    }
+
+    layer.prepare(sampleRate, blockSize);
+
+    const auto after = residentBytes();
+    layer.bytesPerInstance = after > before ? (after - before) / static_cast<size_t>(instances) : 0;
+    return true;
+}
+
+LayerResult run(Layer& layer, CallbackPool& pool, size_t instances, int numCallbacks)
+{
+    LayerResult result;
+    result.create = summarise(layer.createUs);
+    result.firstCreateUs = layer.createUs.front();
+    result.bytesPerInstance = layer.bytesPerInstance;
+
+    // Untimed warm-up: caches, lazily built tables, denormal-free steady state
+    for (int i = 0; i < juce::jmax(1, numCallbacks / 10); ++i)
+        pool.runCallback(layer, instances);
+
+    pool.takeProcessingSeconds();
+
+    std::vector<double> callbackUs;
+    callbackUs.reserve(static_cast<size_t>(numCallbacks));
+
+    for (int i = 0; i < numCallbacks; ++i)
+        callbackUs.push_back(pool.runCallback(layer, instances));
+
+    result.callback = summarise(callbackUs);
+    result.usPerInstanceBlock = pool.takeProcessingSeconds() * 1.0e6 / (static_cast<double>(instances) * numCallbacks);
+    return result;
+}
+
+void printResult(const char* name, const LayerResult& r, double deadlineUs)
+{
+    auto us = [](double value, int width = 9) { return juce::String(value, 1).paddedLeft(' ', width); };
+
+    std::cout << juce::String(name).paddedRight(' ', 10)
+              << "create first " << us(r.firstCreateUs) << " us  p50 " << us(r.create.p50) << " us  p99 " << us(r.create.p99) << " us"
+              << "  memory " << (r.bytesPerInstance > 0 ? juce::String(static_cast<double>(r.bytesPerInstance) / 1024.0, 1) + " KiB/instance"
+                                                          : juce::String("n/a")) << std::endl;
+
+    std::cout << juce::String().paddedRight(' ', 10)
+              << "callback p50 " << us(r.callback.p50) << " us  p99 " << us(r.callback.p99) << " us  max " << us(r.callback.max) << " us"
+              << "  (p99 " << juce::String(100.0 * r.callback.p99 / deadlineUs, 1) << "% of " << juce::String(deadlineUs, 0) << " us)"
+              << "  per instance " << juce::String(r.usPerInstanceBlock, 2) << " us/block" << std::endl;
+}
+
+void printOverhead(const char* what, const LayerResult& outer, const LayerResult& inner)
+{
+    const double extraUs = outer.usPerInstanceBlock - inner.usPerInstanceBlock;
+    const double extraKiB = (static_cast<double>(outer.bytesPerInstance) - static_cast<double>(inner.bytesPerInstance)) / 1024.0;
+
+    std::cout << juce::String(what).paddedRight(' ', 22)
+              << juce::String(extraUs, 2).paddedLeft(' ', 8) << " us/block per instance ("
+              << juce::String(inner.usPerInstanceBlock > 0.0 ? 100.0 * extraUs / inner.usPerInstanceBlock : 0.0, 1) << "%), "
+              << juce::String(extraKiB, 1) << " KiB, create p50 +"
+              << juce::String(outer.create.p50 - inner.create.p50, 1) << " us" << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    auto option = [&args](const char* name, const juce::String& fallback) {
+        return args.containsOption(name) ? args.getValueForOption(name) : fallback;
+    };
+
+    const juce::String pluginPath = option("--plugin", LA2A_VST3_PATH);
+    const int instances = juce::jmax(1, option("--instances", "300").getIntValue());
+    const int threads = juce::jmax(1, option("--threads", juce::String(juce::SystemStats::getNumPhysicalCpus())).getIntValue());
+    const int blockSize = juce::jmax(1, option("--block", "512").getIntValue());
+    const double sampleRate = juce::jmax(8000.0, option("--rate", "48000").getDoubleValue());
+    const double seconds = juce::jmax(0.1, option("--seconds", "2").getDoubleValue());
+
+    juce::VST3PluginFormatHeadless format;
+    juce::OwnedArray<juce::PluginDescription> types;
+    format.findAllTypesForFile(types, pluginPath);
+
+    if (types.isEmpty())
+    {
+        std::cerr << "No VST3 plugin found at " << pluginPath << " (build the AuDemo_VST3 target, or pass --plugin=)" << std::endl;
+        return 1;
+    }
+
+    const auto description = *types.getFirst();
+
+    // Every instance of every layer runs the same non-trivial setting
+    constexpr float peakReduction = 55.0f;
+    constexpr float gain = 6.0f;
+    ProcessorLayer::Settings settings;
+    {
+        AuDemoProcessor source;
+        for (const auto& [id, value] : { std::pair { "peakReduction", peakReduction }, std::pair { "gain", gain } })
+        {
+            auto* parameter = source.getApvts().getParameter(id);
+            settings.emplace_back(parameter->getName(64), parameter->convertTo0to1(value));
+        }
+    }
+
+    DspLayer dsp(peakReduction, gain);
+    ProcessorLayer processor("processor", [](double, int, juce::String&) -> std::unique_ptr<juce::AudioProcessor> {
+        return std::make_unique<AuDemoProcessor>();
+    }, settings);
+    ProcessorLayer vst3("vst3", [&format, &description](double rate, int block, juce::String& error) -> std::unique_ptr<juce::AudioProcessor> {
+        return format.createInstanceFromDescription(description, rate, block, error);
+    }, settings);
+
+    // All layers stay alive to the end, so each resident-memory delta is its own
+    Layer* layers[] = { &dsp, &processor, &vst3 };
+    for (auto* layer : layers)
+        if (! instantiate(*layer, instances, sampleRate, blockSize))
+            return 1;
+
+    const auto numInstances = static_cast<size_t>(instances);
+    const int numCallbacks = juce::jmax(10, static_cast<int>(seconds * sampleRate / blockSize));
+    const double deadlineUs = 1.0e6 * blockSize / sampleRate;
+    CallbackPool pool(threads, blockSize, numInstances);
+
+    std::cout << "LA2ATero host scaling: " << instances << " instances of " << description.name << " " << description.version
+              << ", " << threads << " threads, " << blockSize << " samples at " << sampleRate << " Hz, "
+              << numCallbacks << " callbacks" << std::endl;
+
+    LayerResult results[3];
+    for (size_t i = 0; i < 3; ++i)
+    {
+        results[i] = run(*layers[i], pool, numInstances, numCallbacks);
+        printResult(layers[i]->name, results[i], deadlineUs);
+    }
+
+    std::cout << std::endl;
+    printOverhead("processor over dsp", results[1], results[0]);
+    printOverhead("vst3 wrapper", results[2], results[1]);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include "HarnessHelpers.h"
+#include <chrono>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+/**
+ * Instantiation benchmark
+ *
+ * Times AuDemoProcessor construction and destruction the way hosts do it:
+ * the first instance in the process (which also starts the shared timer and
+ * analysis threads), scan-style instances created and destroyed one at a time,
+ * and a session of instances that stay alive until all have been created.
+ * Reports p50/p99 per instance and the session total.
+ *
+ * With --max-p50 / --max-p99 (microseconds) it exits with 1 when scan-style
+ * construction is slower, so CI can hold the line.
+ *
+ * Usage: LA2ATeroInstantiationBench [--count=N] [--max-p50=us] [--max-p99=us]
+ */
+namespace
+{
+using HarnessHelpers::Percentiles;
+using HarnessHelpers::summarise;
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMicroseconds(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+void printRow(const char* mode, const char* phase, const Percentiles& p)
+{
+    std::cout << juce::String(mode).paddedRight(' ', 9)
+              << juce::String(phase).paddedRight(' ', 10)
+              << " p50 " << juce::String(p.p50, 2).paddedLeft(' ', 8) << " us"
+              << "  p99 " << juce::String(p.p99, 2).paddedLeft(' ', 8) << " us"
+              << "  total " << juce::String(p.total / 1000.0, 2).paddedLeft(' ', 8) << " ms" << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    int count = 1000;
+    if (args.containsOption("--count"))
+        count = juce::jmax(1, args.getValueForOption("--count").getIntValue());
+
+    const auto numInstances = static_cast<size_t>(count);
+    std::cout << "LA2ATero instantiation, " << count << " constructions" << std::endl;
+
+    // The first instance pays for process-wide setup; it stays alive, as an
+    // open session would keep it, for the measurements that follow
+    auto start = Clock::now();
+    auto first = std::make_unique<AuDemoProcessor>();
+    std::cout << "first instance " << juce::String(elapsedMicroseconds(start), 2) << " us" << std::endl;
+
+    // Scan-style: each instance is destroyed before the next is created
+    std::vector<double> constructUs, destroyUs;
+    constructUs.reserve(numInstances);
+    destroyUs.reserve(numInstances);
+
+    for (size_t i = 0; i < numInstances; ++i)
+    {
+        start = Clock::now();
+        auto processor = std::make_unique<AuDemoProcessor>();
+        constructUs.push_back(elapsedMicroseconds(start));
+
+        start = Clock::now();
+        processor.reset();
+        destroyUs.push_back(elapsedMicroseconds(start));
+    }
+
+    const auto isolated = summarise(constructUs);
+    printRow("isolated", "construct", isolated);
+    printRow("isolated", "destroy", summarise(destroyUs));
+
+    // Session: every instance is alive until the whole session has been loaded
+    std::vector<std::unique_ptr<AuDemoProcessor>> session;
+    session.reserve(numInstances);
+    constructUs.clear();
+    destroyUs.clear();
+
+    for (size_t i = 0; i < numInstances; ++i)
+    {
+        start = Clock::now();
+        session.push_back(std::make_unique<AuDemoProcessor>());
+        constructUs.push_back(elapsedMicroseconds(start));
+    }
+
+    for (auto& processor : session)
+    {
+        start = Clock::now();
+        processor.reset();
+        destroyUs.push_back(elapsedMicroseconds(start));
+    }
+
+    printRow("session", "construct", summarise(constructUs));
+    printRow("session", "destroy", summarise(destroyUs));
+
+    int result = 0;
+
+    for (const auto& [option, value, name] : { std::tuple { "--max-p50", isolated.p50, "p50" },
+                                               std::tuple { "--max-p99", isolated.p99, "p99" } })
+    {
+        if (! args.containsOption(option))
+            continue;
+
+        const double limit = args.getValueForOption(option).getDoubleValue();
+        if (value > limit)
+        {
+            std::cout << "FAIL: construction " << name << " " << juce::String(value, 2)
+                      << " us is over " << juce::String(limit, 2) << " us" << std::endl;
+            result = 1;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,119 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include "PluginState.h"
+#include "HarnessHelpers.h"
+#include <iostream>
+#include <vector>
+
+/**
+ * Session save/load benchmark
+ *
+ * Builds a session of prepared instances with varied settings and times
+ * getStateInformation / setStateInformation for each one, in the binary
+ * format and in the legacy XML format it replaced. Reports p50/p99 per
+ * instance, the whole-session total and the blob sizes.
+ *
+ * Usage: LA2ATeroStateBench [--instances=N]
+ */
+namespace
+{
+using HarnessHelpers::Percentiles;
+using HarnessHelpers::summarise;
+
+void printRow(const char* format, const char* phase, const Percentiles& p)
+{
+    std::cout << juce::String(format).paddedRight(' ', 8)
+              << juce::String(phase).paddedRight(' ', 6)
+              << " p50 " << juce::String(p.p50, 2).paddedLeft(' ', 8) << " us"
+              << "  p99 " << juce::String(p.p99, 2).paddedLeft(' ', 8) << " us"
+              << "  session " << juce::String(p.total / 1000.0, 2).paddedLeft(' ', 8) << " ms" << std::endl;
+}
+
+double elapsedMicroseconds(juce::int64 startTicks)
+{
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e6;
+}
+
+// The encoding used before PluginState: APVTS tree -> XML -> copyXmlToBinary
+void writeLegacyXml(AuDemoProcessor& processor, juce::MemoryBlock& destData)
+{
+    if (auto xml = processor.getApvts().copyState().createXml())
+        juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+}
+
+void randomiseParameters(AuDemoProcessor& processor, juce::Random& random)
+{
+    for (auto* parameter : processor.getParameters())
+        parameter->setValueNotifyingHost(random.nextFloat());
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    int instances = 400;
+    if (args.containsOption("--instances"))
+        instances = juce::jmax(1, args.getValueForOption("--instances").getIntValue());
+
+    juce::Random random(0x4c41);
+    std::vector<std::unique_ptr<AuDemoProcessor>> session;
+    session.reserve(static_cast<size_t>(instances));
+
+    for (int i = 0; i < instances; ++i)
+    {
+        session.push_back(std::make_unique<AuDemoProcessor>());
+        session.back()->prepareToPlay(48000.0, 512);
+        randomiseParameters(*session.back(), random);
+    }
+
+    std::cout << "LA2ATero session save/load, " << instances << " instances" << std::endl;
+
+    struct Format
+    {
+        const char* name;
+        void (*write)(AuDemoProcessor&, juce::MemoryBlock&);
+    };
+
+    const Format formats[] = {
+        { "binary", [](AuDemoProcessor& processor, juce::MemoryBlock& destData) { processor.getStateInformation(destData); } },
+        { "xml", writeLegacyXml },
+    };
+
+    for (const auto& format : formats)
+    {
+        std::vector<juce::MemoryBlock> blobs(session.size());
+        std::vector<double> saveUs, loadUs;
+        saveUs.reserve(session.size());
+        loadUs.reserve(session.size());
+
+        for (size_t i = 0; i < session.size(); ++i)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            format.write(*session[i], blobs[i]);
+            saveUs.push_back(elapsedMicroseconds(start));
+        }
+
+        // Load each blob into the next instance so every load changes the state
+        for (size_t i = 0; i < session.size(); ++i)
+        {
+            const auto& blob = blobs[(i + 1) % blobs.size()];
+            const auto start = juce::Time::getHighResolutionTicks();
+            session[i]->setStateInformation(blob.getData(), static_cast<int>(blob.getSize()));
+            loadUs.push_back(elapsedMicroseconds(start));
+        }
+
+        size_t totalBytes = 0;
+        for (const auto& blob : blobs)
+            totalBytes += blob.getSize();
+
+        printRow(format.name, "save", summarise(saveUs));
+        printRow(format.name, "load", summarise(loadUs));
+        std::cout << juce::String(format.name).paddedRight(' ', 8)
+                  << "size   " << (totalBytes / session.size()) << " bytes/instance, session "
+                  << totalBytes << " bytes" << std::endl;
+    }
+
+    return 0;
+}
@@ -1,29 +1,24 @@
 #include "PluginEditor.h"
 
 AuDemoEditor::AuDemoEditor(AuDemoProcessor& p)
-    : AudioProcessorEditor(&p), processorRef(p)
+    : AudioProcessorEditor(&p), processorRef(p), analyzerDisplay(p.getSpectrumAnalyzer())
 {
-    setLookAndFeel(&la2aLookAndFeel);
+    setLookAndFeel(&sharedResources->getLookAndFeel());
+
+    // Label font heights are set in resized(); the typefaces come from the
+    // shared look-and-feel, which loaded them once for all editors
 
     // Title - TELETERONIX branding
     titleLabel.setText("TELETERONIX", juce::dontSendNotification);
-    titleLabel.setFont(juce::Font(juce::FontOptions(24.0f).withStyle("Bold Italic")));
     titleLabel.setJustificationType(juce::Justification::centred);
     titleLabel.setColour(juce::Label::textColourId, LA2ALookAndFeel::TELETRONIX_RED);
     addAndMakeVisible(titleLabel);
 
     subtitleLabel.setText("JEEJEEING AMPLIFIER", juce::dontSendNotification);
-    subtitleLabel.setFont(juce::Font(juce::FontOptions(11.0f)));
     subtitleLabel.setJustificationType(juce::Justification::centred);
     subtitleLabel.setColour(juce::Label::textColourId, LA2ALookAndFeel::TEXT_DARK);
     addAndMakeVisible(subtitleLabel);
 
-    // DEBUG label
-    debugLabel.setFont(juce::Font(juce::FontOptions(10.0f)));
-    debugLabel.setJustificationType(juce::Justification::centredLeft);
-    debugLabel.setColour(juce::Label::textColourId, juce::Colours::red);
-    addAndMakeVisible(debugLabel);
-
     // VU Meter
     addAndMakeVisible(vuMeter);
 
@@ -44,6 +39,32 @@ AuDemoEditor::AuDemoEditor(AuDemoProcessor& p)
     };
     addAndMakeVisible(meterModeButton);
 
+    // History graph, analyzer and loudness panel share the meter's bounds; the
+    // HIST, SPEC and LUFS buttons swap one of them in for the meter
+    addChildComponent(historyGraph);
+    addChildComponent(analyzerDisplay);
+    addChildComponent(loudnessPanel);
+
+    loudnessPanel.onReset = [this]() {
+        processorRef.resetLoudness();
+    };
+
+    for (auto* viewButton : { &historyButton, &analyzerButton, &loudnessButton })
+    {
+        viewButton->setClickingTogglesState(true);
+        viewButton->setColour(juce::TextButton::buttonColourId, LA2ALookAndFeel::TEXT_DARK);
+        viewButton->setColour(juce::TextButton::textColourOffId, LA2ALookAndFeel::FACEPLATE);
+        viewButton->onClick = [this, viewButton]() {
+            if (viewButton->getToggleState())
+                for (auto* other : { &historyButton, &analyzerButton, &loudnessButton })
+                    if (other != viewButton)
+                        other->setToggleState(false, juce::dontSendNotification);
+
+            updateMeterView();
+        };
+        addAndMakeVisible(viewButton);
+    }
+
     // Gain knob - large, left side
     gainSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
     gainSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
@@ -52,7 +73,6 @@ AuDemoEditor::AuDemoEditor(AuDemoProcessor& p)
     addAndMakeVisible(gainSlider);
 
     gainLabel.setText("GAIN", juce::dontSendNotification);
-    gainLabel.setFont(juce::Font(10.0f, juce::Font::bold));
     gainLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(gainLabel);
 
@@ -64,7 +84,6 @@ AuDemoEditor::AuDemoEditor(AuDemoProcessor& p)
     addAndMakeVisible(peakReductionSlider);
 
     peakReductionLabel.setText("PEAK REDUCTION", juce::dontSendNotification);
-    peakReductionLabel.setFont(juce::Font(9.0f, juce::Font::bold));
     peakReductionLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(peakReductionLabel);
 
@@ -74,12 +93,10 @@ AuDemoEditor::AuDemoEditor(AuDemoProcessor& p)
     addAndMakeVisible(mixSlider);
 
     mixLabel.setText("DRY", juce::dontSendNotification);
-    mixLabel.setFont(juce::Font(juce::FontOptions(8.0f).withStyle("Bold")));
     mixLabel.setJustificationType(juce::Justification::centredRight);
     addAndMakeVisible(mixLabel);
 
     mixLabelWet.setText("WET", juce::dontSendNotification);
-    mixLabelWet.setFont(juce::Font(juce::FontOptions(8.0f).withStyle("Bold")));
     mixLabelWet.setJustificationType(juce::Justification::centredLeft);
     addAndMakeVisible(mixLabelWet);
 
@@ -91,6 +108,38 @@ AuDemoEditor::AuDemoEditor(AuDemoProcessor& p)
     compButton.setButtonText("COMP");
     addAndMakeVisible(compButton);
 
+    // TP button - next to LIMIT, engages the true-peak ceiling in Limit mode
+    truePeakCeilingButton.setButtonText("TP");
+    addAndMakeVisible(truePeakCeilingButton);
+
+    // True-peak max readout - above the meter
+    truePeakButton.setColour(juce::TextButton::buttonColourId, LA2ALookAndFeel::TEXT_DARK);
+    truePeakButton.setColour(juce::TextButton::textColourOffId, LA2ALookAndFeel::FACEPLATE);
+    truePeakButton.onClick = [this]() {
+        processorRef.resetTruePeakMax();
+    };
+    addAndMakeVisible(truePeakButton);
+
+    // DSP load overlay - hidden until the DSP button is pressed
+    addChildComponent(loadOverlay);
+    loadButton.setClickingTogglesState(true);
+    loadButton.setColour(juce::TextButton::buttonColourId, LA2ALookAndFeel::TEXT_DARK);
+    loadButton.setColour(juce::TextButton::textColourOffId, LA2ALookAndFeel::FACEPLATE);
+    loadButton.onClick = [this]() {
+        loadOverlay.setVisible(loadButton.getToggleState());
+    };
+    addAndMakeVisible(loadButton);
+
+    // A/B button - bottom right, crossfades to the other settings slot
+    abButton.setColour(juce::TextButton::buttonColourId, LA2ALookAndFeel::TEXT_DARK);
+    abButton.setColour(juce::TextButton::textColourOffId, LA2ALookAndFeel::FACEPLATE);
+    abButton.setButtonText(processorRef.getABSlot() == 0 ? "A" : "B");
+    abButton.onClick = [this]() {
+        processorRef.selectABSlot(1 - processorRef.getABSlot());
+        abButton.setButtonText(processorRef.getABSlot() == 0 ? "A" : "B");
+    };
+    addAndMakeVisible(abButton);
+
     // Parameter attachments
     peakReductionAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         processorRef.getApvts(), "peakReduction", peakReductionSlider);
@@ -102,11 +151,20 @@ AuDemoEditor::AuDemoEditor(AuDemoProcessor& p)
         processorRef.getApvts(), "limitMode", limitButton);
     compModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         processorRef.getApvts(), "compMode", compButton);
+    truePeakCeilingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        processorRef.getApvts(), "tpCeiling", truePeakCeilingButton);
 
     startTimerHz(30);
 
-    // Rack-mount proportions
-    setSize(800, 250);
+    // Rack-mount proportions, freely resizable at a fixed aspect ratio
+    setResizable(true, true);
+    setResizeLimits(BASE_WIDTH / 2, BASE_HEIGHT / 2, BASE_WIDTH * 2, BASE_HEIGHT * 2);
+    if (auto* aspectConstrainer = getConstrainer())
+        aspectConstrainer->setFixedAspectRatio(static_cast<double>(BASE_WIDTH) / BASE_HEIGHT);
+
+    setSize(BASE_WIDTH, BASE_HEIGHT);
+
+    markStartupEvent(startupTimeline.constructed);
 }
 
 AuDemoEditor::~AuDemoEditor()
@@ -115,28 +173,125 @@ AuDemoEditor::~AuDemoEditor()
     setLookAndFeel(nullptr);
 }
 
+void AuDemoEditor::markStartupEvent(double& event)
+{
+    if (event >= 0.0)
+        return;
+
+    event = juce::Time::getMillisecondCounterHiRes() - openStartMs;
+}
+
+void AuDemoEditor::updateMeterView()
+{
+    const bool showHistory = historyButton.getToggleState();
+    const bool showAnalyzer = analyzerButton.getToggleState();
+    const bool showLoudness = loudnessButton.getToggleState();
+
+    // Hiding the analyzer display also stops the analyzer
+    historyGraph.setVisible(showHistory);
+    analyzerDisplay.setVisible(showAnalyzer);
+    loudnessPanel.setVisible(showLoudness);
+    vuMeter.setVisible(! showHistory && ! showAnalyzer && ! showLoudness);
+
+    historyGraph.update();
+    analyzerDisplay.update();
+}
+
 void AuDemoEditor::timerCallback()
 {
-    float gr = processorRef.getGainReductionDb();
-    float out = processorRef.getOutputLevel();
+    const auto meters = processorRef.getMeterSnapshot();
 
     if (vuMeter.getMode() == VUMeter::Mode::GainReduction)
-        vuMeter.setLevel(gr);
+        vuMeter.setLevel(meters.gainReductionDb);
     else
-        vuMeter.setLevel(out);
+        vuMeter.setLevel(meters.outputLevelDb);
+
+    markStartupEvent(startupTimeline.firstMeterUpdate);
+
+    // True-peak readout, in 0.1 dB steps
+    const float truePeakMaxDb = std::round(meters.truePeakMaxDb * 10.0f) / 10.0f;
+    if (! juce::exactlyEqual(truePeakMaxDb, shownTruePeakMaxDb))
+    {
+        shownTruePeakMaxDb = truePeakMaxDb;
+        truePeakButton.setButtonText(truePeakMaxDb > -99.0f ? "TP MAX " + juce::String(truePeakMaxDb, 1) + " dBTP"
+                                                            : juce::String("TP MAX -- dBTP"));
+    }
 
-    // DEBUG: Show input and metering values
-    float inLevel = processorRef.getDebugInputLevel();
-    debugLabel.setText("IN: " + juce::String(inLevel, 3) + " | GR: " + juce::String(gr, 1) + " | OUT: " + juce::String(out, 1),
-                       juce::dontSendNotification);
+    // Drain per-block history (always, so the FIFO never fills while the graph is hidden)
+    const double sampleRate = processorRef.getSampleRate() > 0.0 ? processorRef.getSampleRate() : 44100.0;
+    std::optional<BlockTelemetry> latest;
+    processorRef.getTelemetryFifo().popAll([this, sampleRate, &latest](const BlockTelemetry& record) {
+        historyGraph.addFrame(record, sampleRate);
+        latest = record;
+    });
+    historyGraph.update();
+
+    // Transfer curve follows the parameters; the dot follows the detector
+    if (analyzerDisplay.isVisible())
+    {
+        auto& apvts = processorRef.getApvts();
+        const bool limitOn = apvts.getRawParameterValue("limitMode")->load() > 0.5f;
+        const bool compOn = apvts.getRawParameterValue("compMode")->load() > 0.5f;
+        analyzerDisplay.setTransferCurve(apvts.getRawParameterValue("peakReduction")->load(),
+                                         OptoCompressor::getRatio(limitOn && ! compOn, limitOn && compOn));
+
+        if (latest.has_value())
+            analyzerDisplay.setOperatingPoint(juce::Decibels::gainToDecibels(latest->inputRms, -100.0f),
+                                              meters.gainReductionDb);
+    }
+
+    analyzerDisplay.update();
+
+    if (loudnessPanel.isVisible())
+        loudnessPanel.setReadings(processorRef.getLoudnessReadings());
+
+    if (loadOverlay.isVisible())
+    {
+        loadOverlay.setStats(processorRef.getDspLoadStats());
+        if (latest.has_value())
+            loadOverlay.setInputInfo(latest->numChannels, latest->inputPeak);
+    }
 }
 
 void AuDemoEditor::paint(juce::Graphics& g)
 {
-    auto bounds = getLocalBounds().toFloat();
+    // The faceplate is static, so it is rendered once per size and scale factor
+    // and shared between every open editor. After a resize the previous raster is
+    // drawn scaled while the new one renders in the background.
+    const auto scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto painter = [layout = faceplateLayout, resources = &sharedResources.get()](juce::Graphics& fg) {
+        drawFaceplate(fg, layout, *resources);
+    };
+
+    juce::Image faceplateImage;
+
+    if (sharedResources->getRasterCache().contains("faceplate", scaleFactor))
+    {
+        juce::Component::SafePointer<AuDemoEditor> safeThis(this);
+        faceplateImage = sharedResources->getCachedImageAsync("faceplate", getWidth(), getHeight(), scaleFactor,
+                                                              std::move(painter), [safeThis] {
+                                                                  if (safeThis != nullptr)
+                                                                      safeThis->repaint();
+                                                              });
+    }
+    else
+    {
+        // Nothing to scale yet (first editor to open)
+        faceplateImage = sharedResources->getCachedImage("faceplate", getWidth(), getHeight(), scaleFactor, painter);
+    }
+
+    g.drawImage(faceplateImage, getLocalBounds().toFloat());
+
+    markStartupEvent(startupTimeline.firstPaint);
+}
+
+void AuDemoEditor::drawFaceplate(juce::Graphics& g, const FaceplateLayout& layout, SharedGuiResources& resources)
+{
+    auto bounds = layout.bounds;
+    auto s = layout.scale;
 
     // Black rack ears on sides
-    float earWidth = 25.0f;
+    float earWidth = 25.0f * s;
     g.setColour(LA2ALookAndFeel::RACK_EAR);
     g.fillRect(0.0f, 0.0f, earWidth, bounds.getHeight());
     g.fillRect(bounds.getWidth() - earWidth, 0.0f, earWidth, bounds.getHeight());
@@ -145,9 +300,9 @@ void AuDemoEditor::paint(juce::Graphics& g)
     g.setColour(juce::Colour(0xFF333333));
     for (int i = 0; i < 3; ++i)
     {
-        float slotY = 30.0f + i * 80.0f;
-        g.fillRoundedRectangle(8.0f, slotY, 10.0f, 25.0f, 3.0f);
-        g.fillRoundedRectangle(bounds.getWidth() - 18.0f, slotY, 10.0f, 25.0f, 3.0f);
+        float slotY = (30.0f + i * 80.0f) * s;
+        g.fillRoundedRectangle(8.0f * s, slotY, 10.0f * s, 25.0f * s, 3.0f * s);
+        g.fillRoundedRectangle(bounds.getWidth() - 18.0f * s, slotY, 10.0f * s, 25.0f * s, 3.0f * s);
     }
 
     // Main faceplate area
@@ -162,18 +317,18 @@ void AuDemoEditor::paint(juce::Graphics& g)
 
     // Top edge highlight
     g.setColour(juce::Colour(0xFFDDDDDD));
-    g.fillRect(faceplate.getX(), faceplate.getY(), faceplate.getWidth(), 3.0f);
+    g.fillRect(faceplate.getX(), faceplate.getY(), faceplate.getWidth(), 3.0f * s);
 
     // Bottom shadow
     g.setColour(juce::Colour(0xFF888888));
-    g.fillRect(faceplate.getX(), faceplate.getBottom() - 3.0f, faceplate.getWidth(), 3.0f);
+    g.fillRect(faceplate.getX(), faceplate.getBottom() - 3.0f * s, faceplate.getWidth(), 3.0f * s);
 
     // Corner screws
-    float screwRadius = 5.0f;
+    float screwRadius = 5.0f * s;
     auto drawScrew = [&](float cx, float cy) {
         // Screw shadow
         g.setColour(juce::Colour(0x40000000));
-        g.fillEllipse(cx - screwRadius + 1, cy - screwRadius + 1, screwRadius * 2, screwRadius * 2);
+        g.fillEllipse(cx - screwRadius + s, cy - screwRadius + s, screwRadius * 2, screwRadius * 2);
         // Screw body
         juce::ColourGradient screwGrad(
             juce::Colour(0xFFCCCCCC), cx - screwRadius, cy - screwRadius,
@@ -182,25 +337,25 @@ void AuDemoEditor::paint(juce::Graphics& g)
         g.fillEllipse(cx - screwRadius, cy - screwRadius, screwRadius * 2, screwRadius * 2);
         // Slot
         g.setColour(juce::Colour(0xFF444444));
-        g.fillRect(cx - screwRadius * 0.7f, cy - 1.0f, screwRadius * 1.4f, 2.0f);
+        g.fillRect(cx - screwRadius * 0.7f, cy - s, screwRadius * 1.4f, 2.0f * s);
     };
 
-    float screwInset = 15.0f;
+    float screwInset = 15.0f * s;
     drawScrew(faceplate.getX() + screwInset, faceplate.getY() + screwInset);
     drawScrew(faceplate.getRight() - screwInset, faceplate.getY() + screwInset);
     drawScrew(faceplate.getX() + screwInset, faceplate.getBottom() - screwInset);
     drawScrew(faceplate.getRight() - screwInset, faceplate.getBottom() - screwInset);
 
     // Draw knob scale markings on faceplate
-    drawKnobScale(g, gainKnobCenter, gainKnobRadius + 15.0f, 0, 100);
-    drawKnobScale(g, peakReductionKnobCenter, peakReductionKnobRadius + 15.0f, 0, 100);
+    drawKnobScale(g, resources, layout.gainKnobCenter, layout.gainKnobRadius + 15.0f * s, s, 0, 100);
+    drawKnobScale(g, resources, layout.peakReductionKnobCenter, layout.peakReductionKnobRadius + 15.0f * s, s, 0, 100);
 }
 
-void AuDemoEditor::drawKnobScale(juce::Graphics& g, juce::Point<float> center,
-                                  float radius, int minVal, int maxVal)
+void AuDemoEditor::drawKnobScale(juce::Graphics& g, SharedGuiResources& resources, juce::Point<float> center,
+                                 float radius, float scale, int minVal, int maxVal)
 {
     g.setColour(LA2ALookAndFeel::TEXT_DARK);
-    g.setFont(9.0f);
+    g.setFont(resources.getFont(9.0f * scale));
 
     float startAngle = juce::MathConstants<float>::pi * 0.75f;
     float endAngle = juce::MathConstants<float>::pi * 2.25f;
@@ -211,7 +366,7 @@ void AuDemoEditor::drawKnobScale(juce::Graphics& g, juce::Point<float> center,
         float normalized = i / 10.0f;
         float angle = startAngle + normalized * (endAngle - startAngle);
 
-        float tickInner = radius - 8.0f;
+        float tickInner = radius - 8.0f * scale;
         float tickOuter = radius;
 
         float cosA = std::cos(angle - juce::MathConstants<float>::halfPi);
@@ -223,18 +378,18 @@ void AuDemoEditor::drawKnobScale(juce::Graphics& g, juce::Point<float> center,
         float y2 = center.y + tickOuter * sinA;
 
         bool major = (i % 2 == 0);
-        g.drawLine(x1, y1, x2, y2, major ? 1.5f : 1.0f);
+        g.drawLine(x1, y1, x2, y2, (major ? 1.5f : 1.0f) * scale);
 
         // Number labels for major ticks
         if (major)
         {
             int value = minVal + (i * (maxVal - minVal)) / 10;
-            float labelRadius = radius + 10.0f;
+            float labelRadius = radius + 10.0f * scale;
             float lx = center.x + labelRadius * cosA;
             float ly = center.y + labelRadius * sinA;
 
             g.drawText(juce::String(value),
-                      static_cast<int>(lx - 12), static_cast<int>(ly - 6), 24, 12,
+                      juce::Rectangle<float>(lx - 12.0f * scale, ly - 6.0f * scale, 24.0f * scale, 12.0f * scale),
                       juce::Justification::centred);
         }
     }
@@ -243,28 +398,54 @@ void AuDemoEditor::drawKnobScale(juce::Graphics& g, juce::Point<float> center,
 void AuDemoEditor::resized()
 {
     auto bounds = getLocalBounds();
-    float earWidth = 25.0f;
+
+    // Everything below is laid out in 800x250 reference units
+    const float s = static_cast<float>(getWidth()) / static_cast<float>(BASE_WIDTH);
+    auto px = [s](float v) { return juce::roundToInt(v * s); };
+
+    float earWidth = 25.0f * s;
     auto faceplate = bounds.toFloat().reduced(earWidth, 0.0f);
 
+    // Label sizes follow the layout; the look-and-feel supplies the typefaces at paint time
+    titleLabel.setFont(juce::FontOptions(24.0f * s, juce::Font::bold | juce::Font::italic));
+    subtitleLabel.setFont(juce::FontOptions(11.0f * s));
+    gainLabel.setFont(juce::FontOptions(10.0f * s, juce::Font::bold));
+    peakReductionLabel.setFont(juce::FontOptions(9.0f * s, juce::Font::bold));
+    mixLabel.setFont(juce::FontOptions(8.0f * s, juce::Font::bold));
+    mixLabelWet.setFont(juce::FontOptions(8.0f * s, juce::Font::bold));
+
     // Title area - centered
-    titleLabel.setBounds(static_cast<int>(faceplate.getX()), 6, static_cast<int>(faceplate.getWidth()), 28);
-    subtitleLabel.setBounds(static_cast<int>(faceplate.getX()), 32, static_cast<int>(faceplate.getWidth()), 16);
+    titleLabel.setBounds(static_cast<int>(faceplate.getX()), px(6), static_cast<int>(faceplate.getWidth()), px(28));
+    subtitleLabel.setBounds(static_cast<int>(faceplate.getX()), px(32), static_cast<int>(faceplate.getWidth()), px(16));
+
+    // DSP load button - bottom left, with its overlay above it
+    loadButton.setBounds(static_cast<int>(faceplate.getX()) + px(10), bounds.getHeight() - px(20), px(32), px(14));
+    loadOverlay.setBounds(static_cast<int>(faceplate.getX()) + px(10), bounds.getHeight() - px(108), px(200), px(84));
 
-    // DEBUG label - bottom left
-    debugLabel.setBounds(static_cast<int>(faceplate.getX()) + 10, bounds.getHeight() - 20, 200, 16);
+    // A/B button - bottom right
+    abButton.setBounds(static_cast<int>(faceplate.getRight()) - px(42), bounds.getHeight() - px(20), px(32), px(14));
 
     // VU Meter - center (define first to use for knob positioning)
-    int meterWidth = 180;
-    int meterHeight = 120;
+    int meterWidth = px(180);
+    int meterHeight = px(120);
     int meterX = static_cast<int>(faceplate.getCentreX() - meterWidth / 2);
     int meterY = static_cast<int>((bounds.getHeight() - meterHeight) / 2);
     vuMeter.setBounds(meterX, meterY, meterWidth, meterHeight);
+    historyGraph.setBounds(vuMeter.getBounds());
+    analyzerDisplay.setBounds(vuMeter.getBounds());
+    loudnessPanel.setBounds(vuMeter.getBounds());
 
-    // Meter mode button
-    meterModeButton.setBounds(meterX + meterWidth / 2 - 20, meterY + meterHeight + 5, 40, 18);
+    // Meter mode and view buttons
+    meterModeButton.setBounds(meterX + meterWidth / 2 - px(20), meterY + meterHeight + px(5), px(40), px(18));
+    analyzerButton.setBounds(meterX, meterY + meterHeight + px(5), px(40), px(18));
+    historyButton.setBounds(meterX + meterWidth - px(40), meterY + meterHeight + px(5), px(40), px(18));
+
+    // LUFS view button and true-peak readout - above the meter
+    loudnessButton.setBounds(meterX, meterY - px(16), px(40), px(14));
+    truePeakButton.setBounds(meterX + meterWidth / 2 - px(45), meterY - px(16), px(90), px(14));
 
     // Gain knob - centered between left faceplate edge and meter left edge
-    int gainKnobSize = 100;
+    int gainKnobSize = px(100);
     float leftAreaStart = faceplate.getX();
     float leftAreaEnd = static_cast<float>(meterX);
     float gainCenterX = (leftAreaStart + leftAreaEnd) / 2.0f;
@@ -272,12 +453,10 @@ void AuDemoEditor::resized()
     int gainX = static_cast<int>(gainCenterX - gainKnobSize / 2.0f);
     int gainY = static_cast<int>(gainCenterY - gainKnobSize / 2.0f);
     gainSlider.setBounds(gainX, gainY, gainKnobSize, gainKnobSize);
-    gainLabel.setBounds(gainX, gainY + gainKnobSize - 5, gainKnobSize, 20);
-    gainKnobCenter = {gainCenterX, gainCenterY};
-    gainKnobRadius = gainKnobSize / 2.0f - 10.0f;
+    gainLabel.setBounds(gainX, gainY + gainKnobSize - px(5), gainKnobSize, px(20));
 
     // Peak Reduction knob - centered between meter right edge and right faceplate edge
-    int prKnobSize = 100;
+    int prKnobSize = px(100);
     float rightAreaStart = static_cast<float>(meterX + meterWidth);
     float rightAreaEnd = faceplate.getRight();
     float prCenterX = (rightAreaStart + rightAreaEnd) / 2.0f;
@@ -285,26 +464,35 @@ void AuDemoEditor::resized()
     int prX = static_cast<int>(prCenterX - prKnobSize / 2.0f);
     int prY = static_cast<int>(prCenterY - prKnobSize / 2.0f);
     peakReductionSlider.setBounds(prX, prY, prKnobSize, prKnobSize);
-    peakReductionLabel.setBounds(prX - 10, prY + prKnobSize - 5, prKnobSize + 20, 20);
-    peakReductionKnobCenter = {prCenterX, prCenterY};
-    peakReductionKnobRadius = prKnobSize / 2.0f - 10.0f;
+    peakReductionLabel.setBounds(prX - px(10), prY + prKnobSize - px(5), prKnobSize + px(20), px(20));
+
+    faceplateLayout.bounds = bounds.toFloat();
+    faceplateLayout.scale = s;
+    faceplateLayout.gainKnobCenter = {gainCenterX, gainCenterY};
+    faceplateLayout.gainKnobRadius = gainKnobSize / 2.0f - 10.0f * s;
+    faceplateLayout.peakReductionKnobCenter = {prCenterX, prCenterY};
+    faceplateLayout.peakReductionKnobRadius = prKnobSize / 2.0f - 10.0f * s;
 
     // COMP button - below Gain knob (with space for label)
-    int buttonWidth = 60;
-    int buttonHeight = 24;
+    int buttonWidth = px(60);
+    int buttonHeight = px(24);
     compButton.setBounds(static_cast<int>(gainCenterX - buttonWidth / 2),
-                         gainY + gainKnobSize + 20, buttonWidth, buttonHeight);
+                         gainY + gainKnobSize + px(20), buttonWidth, buttonHeight);
 
     // LIMIT button - below Peak Reduction knob (with space for label)
     limitButton.setBounds(static_cast<int>(prCenterX - buttonWidth / 2),
-                          prY + prKnobSize + 20, buttonWidth, buttonHeight);
+                          prY + prKnobSize + px(20), buttonWidth, buttonHeight);
+
+    // TP button - right of LIMIT
+    truePeakCeilingButton.setBounds(static_cast<int>(prCenterX) + px(34),
+                                    prY + prKnobSize + px(23), px(28), px(18));
 
     // Mix fader - horizontal, below the meter
-    int mixFaderWidth = 120;
-    int mixFaderHeight = 20;
+    int mixFaderWidth = px(120);
+    int mixFaderHeight = px(20);
     int mixX = meterX + (meterWidth - mixFaderWidth) / 2;
-    int mixY = meterY + meterHeight + 25;
+    int mixY = meterY + meterHeight + px(25);
     mixSlider.setBounds(mixX, mixY, mixFaderWidth, mixFaderHeight);
-    mixLabel.setBounds(mixX - 32, mixY, 30, mixFaderHeight);
-    mixLabelWet.setBounds(mixX + mixFaderWidth + 2, mixY, 30, mixFaderHeight);
+    mixLabel.setBounds(mixX - px(32), mixY, px(30), mixFaderHeight);
+    mixLabelWet.setBounds(mixX + mixFaderWidth + px(2), mixY, px(30), mixFaderHeight);
 }
@@ -2,7 +2,13 @@
 
 #include "PluginProcessor.h"
 #include "ui/VUMeter.h"
+#include "ui/HistoryGraph.h"
+#include "ui/AnalyzerDisplay.h"
+#include "ui/LoadOverlay.h"
+#include "ui/LoudnessPanel.h"
 #include "ui/LA2ALookAndFeel.h"
+#include "ui/SharedGuiResources.h"
+#include <optional>
 
 class AuDemoEditor : public juce::AudioProcessorEditor, private juce::Timer
 {
@@ -13,20 +19,73 @@ public:
     void paint(juce::Graphics&) override;
     void resized() override;
 
+    // Startup timeline, in ms since the constructor was entered (-1 = not reached yet)
+    struct StartupTimeline
+    {
+        double constructed = -1.0;
+        double firstPaint = -1.0;
+        double firstMeterUpdate = -1.0;
+    };
+
+    // Open-time and memory reporting (per-editor memory is measured by LA2ATeroEditorBench)
+    const StartupTimeline& getStartupTimeline() const { return startupTimeline; }
+    double getOpenTimeMs() const { return startupTimeline.constructed; }
+    size_t getSharedMemoryBytes() const { return sharedResources->getCachedImageBytes(); }
+
 private:
     void timerCallback() override;
-    void drawKnobScale(juce::Graphics& g, juce::Point<float> center,
-                       float radius, int minVal, int maxVal);
+    void markStartupEvent(double& event);
+    void updateMeterView();
+
+    // Everything the faceplate painter needs, captured by value so the raster
+    // cache can render it on its background thread
+    struct FaceplateLayout
+    {
+        juce::Rectangle<float> bounds;
+        float scale = 1.0f;
+        juce::Point<float> gainKnobCenter;
+        float gainKnobRadius = 0.0f;
+        juce::Point<float> peakReductionKnobCenter;
+        float peakReductionKnobRadius = 0.0f;
+    };
+
+    static void drawFaceplate(juce::Graphics& g, const FaceplateLayout& layout, SharedGuiResources& resources);
+    static void drawKnobScale(juce::Graphics& g, SharedGuiResources& resources, juce::Point<float> center,
+                              float radius, float scale, int minVal, int maxVal);
+
+    // Reference size: all layout constants are in these units and scaled in resized()
+    static constexpr int BASE_WIDTH = 800;
+    static constexpr int BASE_HEIGHT = 250;
 
     AuDemoProcessor& processorRef;
 
-    // Look and Feel
-    LA2ALookAndFeel la2aLookAndFeel;
+    // Declared before the shared resources, so the timeline includes building them
+    double openStartMs = juce::Time::getMillisecondCounterHiRes();
+    StartupTimeline startupTimeline;
+
+    // Look and Feel, fonts and raster caches (shared by all editor instances)
+    juce::SharedResourcePointer<SharedGuiResources> sharedResources;
 
     // VU Meter
     VUMeter vuMeter;
     juce::TextButton meterModeButton{"GR"};
 
+    // History graph (shown in place of the VU meter)
+    HistoryGraph historyGraph;
+    juce::TextButton historyButton{"HIST"};
+
+    // Spectrum and transfer curve (also shown in place of the VU meter)
+    AnalyzerDisplay analyzerDisplay;
+    juce::TextButton analyzerButton{"SPEC"};
+
+    // Loudness readout (also shown in place of the VU meter)
+    LoudnessPanel loudnessPanel;
+    juce::TextButton loudnessButton{"LUFS"};
+
+    // Held true-peak readout above the meter (click to reset)
+    juce::TextButton truePeakButton;
+    float shownTruePeakMaxDb = 1.0f;
+
     // Knobs
     juce::Slider peakReductionSlider;
     juce::Slider gainSlider;
@@ -39,17 +98,21 @@ private:
     juce::Label mixLabelWet;
     juce::Label titleLabel;
     juce::Label subtitleLabel;
-    juce::Label debugLabel;  // DEBUG
+
+    // DSP load overlay, toggled by the DSP button
+    LoadOverlay loadOverlay;
+    juce::TextButton loadButton{"DSP"};
+
+    // A/B comparison slot
+    juce::TextButton abButton{"A"};
 
     // Mode buttons
     juce::ToggleButton limitButton;
     juce::ToggleButton compButton;
+    juce::ToggleButton truePeakCeilingButton;   // True-peak ceiling (Limit mode)
 
     // Knob scale positions (for drawing)
-    juce::Point<float> gainKnobCenter;
-    float gainKnobRadius = 0.0f;
-    juce::Point<float> peakReductionKnobCenter;
-    float peakReductionKnobRadius = 0.0f;
+    FaceplateLayout faceplateLayout;
 
     // Parameter attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> peakReductionAttachment;
@@ -57,6 +120,7 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mixAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> limitModeAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> compModeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> truePeakCeilingAttachment;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AuDemoEditor)
 };
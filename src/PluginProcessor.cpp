@@ -1,5 +1,110 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "PluginState.h"
+
+namespace
+{
+    const juce::Identifier TRUE_PEAK_MAX_ID { "truePeakMaxDb" };
+    const juce::Identifier AB_SLOTS_TYPE { "ABSlots" };
+    const juce::Identifier SELECTED_SLOT_ID { "selected" };
+    const juce::Identifier SLOT_USED_ID { "used" };
+
+    // setCurrentProgram() must not block on the audio thread
+    static_assert(std::atomic<juce::uint64>::is_always_lock_free);
+
+    juce::uint64 makeProgramRequest(juce::uint32 generation, int index)
+    {
+        return (static_cast<juce::uint64>(generation) << 32) | static_cast<juce::uint32>(index);
+    }
+
+    juce::uint32 getRequestGeneration(juce::uint64 request) { return static_cast<juce::uint32>(request >> 32); }
+    int getRequestIndex(juce::uint64 request) { return static_cast<int>(request & 0xffffffff); }
+
+    // Generations wrap, so they are compared by difference
+    bool isNewer(juce::uint32 generation, juce::uint32 than)
+    {
+        return static_cast<juce::int32>(generation - than) > 0;
+    }
+
+    bool isValidProgram(const PresetBank* bank, int index)
+    {
+        return bank != nullptr && juce::isPositiveAndBelow(index, bank->getNumPresets());
+    }
+
+    // Index in bank of the preset at index in previous, or -1 if it is gone
+    int findSamePreset(const PresetBank& previous, const PresetBank& bank, int index)
+    {
+        if (! isValidProgram(&previous, index))
+            return -1;
+
+        for (int i = 0; i < bank.getNumPresets(); ++i)
+            if (bank.getPreset(i).name == previous.getPreset(index).name)
+                return i;
+
+        return -1;
+    }
+
+    // Wait-free, unlike MessageManager::isThisTheMessageThread()
+    bool isMessageThread()
+    {
+        auto* messageManager = juce::MessageManager::getInstanceWithoutCreating();
+        return messageManager != nullptr && messageManager->getCurrentMessageThread() == juce::Thread::getCurrentThreadId();
+    }
+}
+
+/**
+ * Copies program changes made off the message thread into the parameters
+ *
+ * One timer for the whole process, shared by every instance. A request only
+ * sets an atomic flag (wait-free, so the audio thread can do it); the timer
+ * callback is a flag check unless a request is pending. The timer runs while
+ * any instance exists and a MessageManager is there to drive it.
+ */
+class AuDemoProcessor::ParameterSync : private juce::Timer
+{
+public:
+    ParameterSync() = default;
+    ~ParameterSync() override { stopTimer(); }
+
+    void add(AuDemoProcessor* processor)
+    {
+        const juce::ScopedLock lock(processorsLock);
+        processors.add(processor);
+
+        if (! isTimerRunning() && juce::MessageManager::getInstanceWithoutCreating() != nullptr)
+            startTimer(INTERVAL_MS);
+    }
+
+    void remove(AuDemoProcessor* processor)
+    {
+        const juce::ScopedLock lock(processorsLock);
+        processors.removeFirstMatchingValue(processor);
+
+        if (processors.isEmpty())
+            stopTimer();
+    }
+
+    void requestCopy() { copyRequested.store(true, std::memory_order_release); }
+
+private:
+    static constexpr int INTERVAL_MS = 50;
+
+    void timerCallback() override
+    {
+        if (! copyRequested.exchange(false, std::memory_order_acquire))
+            return;
+
+        const juce::ScopedLock lock(processorsLock);
+        for (auto* processor : processors)
+            processor->copyProgramToParameters();
+    }
+
+    juce::CriticalSection processorsLock;
+    juce::Array<AuDemoProcessor*> processors;
+    std::atomic<bool> copyRequested { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSync)
+};
 
 AuDemoProcessor::AuDemoProcessor()
     : AudioProcessor(BusesProperties()
@@ -13,63 +118,74 @@ AuDemoProcessor::AuDemoProcessor()
     limitModeParam = apvts.getRawParameterValue("limitMode");
     compModeParam = apvts.getRawParameterValue("compMode");
     mixParam = apvts.getRawParameterValue("mix");
+    tpCeilingParam = apvts.getRawParameterValue("tpCeiling");
+    tpCeilingDbParam = apvts.getRawParameterValue("tpCeilingDb");
 
-    // Ensure input bus is enabled
-    if (auto* bus = getBus(true, 0))
-        bus->enable();
+    parameterSync->add(this);
+    sharedPresetBank->addListener(this);
 }
 
 AuDemoProcessor::~AuDemoProcessor()
 {
+    sharedPresetBank->removeListener(this);
+    parameterSync->remove(this);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout AuDemoProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    // Peak Reduction (0-100)
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID{"peakReduction", 1},
-        "Peak Reduction",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("")));
-
-    // Gain (-10 to +40 dB)
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID{"gain", 1},
-        "Gain",
-        juce::NormalisableRange<float>(-10.0f, 40.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    // Limit mode button
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID{"limitMode", 1},
-        "Limit Mode",
-        false));
-
-    // Comp mode button
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID{"compMode", 1},
-        "Comp Mode",
-        true));  // Default to comp mode on
-
-    // Mix (0-100%)
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID{"mix", 1},
-        "Mix",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
-        100.0f,
-        juce::AudioParameterFloatAttributes().withLabel("%")));
-
-    // Meter mode (not automated, UI only)
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID{"meterMode", 1},
-        "Meter Mode",
-        false));
-
-    return {params.begin(), params.end()};
+    // Parameter metadata is immutable, so it is built once per process and
+    // shared: every instance copies the ref-counted strings and the ranges
+    // instead of rebuilding them
+    struct ParameterSpec
+    {
+        juce::String id;
+        juce::String name;
+        juce::NormalisableRange<float> range;   // Unused for bool parameters
+        float defaultValue;
+        juce::String label;
+        bool isBool;
+    };
+
+    static const ParameterSpec specs[] = {
+        // Peak Reduction (0-100)
+        { "peakReduction", "Peak Reduction", { 0.0f, 100.0f, 0.1f }, 0.0f, "", false },
+
+        // Gain (-10 to +40 dB)
+        { "gain", "Gain", { -10.0f, 40.0f, 0.1f }, 0.0f, "dB", false },
+
+        // Limit mode button
+        { "limitMode", "Limit Mode", {}, 0.0f, "", true },
+
+        // Comp mode button (default on)
+        { "compMode", "Comp Mode", {}, 1.0f, "", true },
+
+        // Mix (0-100%)
+        { "mix", "Mix", { 0.0f, 100.0f, 0.1f }, 100.0f, "%", false },
+
+        // True-peak ceiling (active in Limit mode)
+        { "tpCeiling", "True Peak Ceiling", {}, 0.0f, "", true },
+
+        // True-peak ceiling level (-6 to 0 dBTP)
+        { "tpCeilingDb", "True Peak Ceiling Level", { -6.0f, 0.0f, 0.1f }, -1.0f, "dBTP", false },
+
+        // Meter mode (not automated, UI only)
+        { "meterMode", "Meter Mode", {}, 0.0f, "", true },
+    };
+
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    for (const auto& spec : specs)
+    {
+        if (spec.isBool)
+            layout.add(std::make_unique<juce::AudioParameterBool>(
+                juce::ParameterID{spec.id, 1}, spec.name, spec.defaultValue > 0.5f));
+        else
+            layout.add(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID{spec.id, 1}, spec.name, spec.range, spec.defaultValue,
+                juce::AudioParameterFloatAttributes().withLabel(spec.label)));
+    }
+
+    return layout;
 }
 
 const juce::String AuDemoProcessor::getName() const
@@ -81,15 +197,163 @@ bool AuDemoProcessor::acceptsMidi() const { return false; }
 bool AuDemoProcessor::producesMidi() const { return false; }
 bool AuDemoProcessor::isMidiEffect() const { return false; }
 double AuDemoProcessor::getTailLengthSeconds() const { return 0.0; }
-int AuDemoProcessor::getNumPrograms() { return 1; }
-int AuDemoProcessor::getCurrentProgram() { return 0; }
-void AuDemoProcessor::setCurrentProgram(int) {}
-const juce::String AuDemoProcessor::getProgramName(int) { return {}; }
+int AuDemoProcessor::getNumPrograms() { return getPresetBank().getNumPresets(); }
+int AuDemoProcessor::getCurrentProgram() { return currentProgram.load(); }
+
+const juce::String AuDemoProcessor::getProgramName(int index)
+{
+    const auto& bank = getPresetBank();
+    return juce::isPositiveAndBelow(index, bank.getNumPresets()) ? bank.getPreset(index).name : juce::String();
+}
+
 void AuDemoProcessor::changeProgramName(int, const juce::String&) {}
 
+void AuDemoProcessor::setCurrentProgram(int index)
+{
+    // May be called on the audio thread (e.g. a VST3 program-change
+    // parameter), so posting the request is wait-free: no locks, no messages.
+    // Off the message thread the bank isn't built here; a host asks for the
+    // program list before it selects from it.
+    const bool onMessageThread = isMessageThread();
+
+    if (! isValidProgram(onMessageThread ? &getPresetBank() : sharedPresetBank->getBankIfBuilt(), index))
+        return;
+
+    currentProgram.store(index);
+    programRequest.store(makeProgramRequest(nextGeneration(), index));
+
+    if (onMessageThread)
+        copyProgramToParameters();
+    else
+        parameterSync->requestCopy();
+}
+
+void AuDemoProcessor::selectABSlot(int slot)
+{
+    slot = juce::jlimit(0, ABCompressor::NUM_SLOTS - 1, slot);
+    const int previous = selectedSlot.load();
+
+    if (slot == previous)
+        return;
+
+    // A program change still on its way to the parameters belongs to the slot being left
+    copyProgramToParameters();
+
+    // The slot being left keeps the current settings; a slot used for the
+    // first time starts as a copy of them
+    slotValues[static_cast<size_t>(previous)] = readParameters();
+
+    if (! slotUsed[static_cast<size_t>(slot)])
+    {
+        slotValues[static_cast<size_t>(slot)] = slotValues[static_cast<size_t>(previous)];
+        slotUsed[static_cast<size_t>(slot)] = true;
+    }
+
+    selectedSlot.store(slot);
+
+    const auto& values = slotValues[static_cast<size_t>(slot)];
+    const auto generation = nextGeneration();
+
+    auto& snapshot = slotSnapshots.getWriteBuffer();
+    snapshot.values = values;
+    snapshot.slot = slot;
+    snapshot.generation = generation;
+    slotSnapshots.publish();
+
+    setParameters(values);
+    appliedSnapshotGeneration.store(generation, std::memory_order_release);
+}
+
+juce::uint32 AuDemoProcessor::nextGeneration()
+{
+    return snapshotGeneration.fetch_add(1) + 1;
+}
+
+void AuDemoProcessor::holdValues(const PresetValues& values, juce::uint32 generation)
+{
+    if (holdingSnapshot && ! isNewer(generation, heldGeneration))
+        return;
+
+    heldValues = values;
+    heldGeneration = generation;
+    holdingSnapshot = true;
+}
+
+void AuDemoProcessor::copyProgramToParameters()
+{
+    // Nothing to do unless the last program request is newer than what the parameters hold
+    const auto request = programRequest.load();
+    const auto generation = getRequestGeneration(request);
+
+    if (! isNewer(generation, appliedSnapshotGeneration.load(std::memory_order_relaxed)))
+        return;
+
+    const auto* bank = sharedPresetBank->getBankIfBuilt();
+    const int index = getRequestIndex(request);
+
+    if (isValidProgram(bank, index))
+        setParameters(bank->getPreset(index).values);
+
+    // The audio thread goes back to the parameters once they hold the values
+    appliedSnapshotGeneration.store(generation, std::memory_order_release);
+}
+
+void AuDemoProcessor::setParameters(const PresetValues& values)
+{
+    auto setParameter = [this](const char* id, float value) {
+        if (auto* parameter = apvts.getParameter(id))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    };
+
+    setParameter("peakReduction", values.peakReduction);
+    setParameter("gain", values.gain);
+    setParameter("limitMode", values.limitMode ? 1.0f : 0.0f);
+    setParameter("compMode", values.compMode ? 1.0f : 0.0f);
+    setParameter("mix", values.mix);
+    setParameter("tpCeiling", values.tpCeiling ? 1.0f : 0.0f);
+    setParameter("tpCeilingDb", values.tpCeilingDb);
+}
+
+bool AuDemoProcessor::saveUserPreset(const juce::String& name)
+{
+    if (! PresetBank::saveUserPreset(PresetBank::getDefaultUserDirectory(), name, readParameters()))
+        return false;
+
+    sharedPresetBank->rescan();
+    return true;
+}
+
+void AuDemoProcessor::presetBankChanged(const PresetBank& previous, const PresetBank& bank)
+{
+    // A program keeps its name across a rescan; its index moves when user
+    // presets sorting before it were added or removed. A request still on its
+    // way is moved with it, keeping its generation.
+    const int program = findSamePreset(previous, bank, currentProgram.load());
+    currentProgram.store(juce::jmax(0, program));
+
+    auto request = programRequest.load();
+    const int requested = findSamePreset(previous, bank, getRequestIndex(request));
+
+    if (requested >= 0 && requested != getRequestIndex(request))
+        programRequest.compare_exchange_strong(request, makeProgramRequest(getRequestGeneration(request), requested));
+
+    updateHostDisplay(ChangeDetails().withProgramChanged(true));
+}
+
 void AuDemoProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    compressor.prepare(sampleRate, samplesPerBlock);
+    compressor.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    setLatencySamples(compressor.getLatencySamples());
+    spectrumAnalyzer.prepare(sampleRate);
+    loudnessMeter.prepare(sampleRate, getTotalNumOutputChannels());
+    loadMonitor.prepare(sampleRate, samplesPerBlock);
+
+   #if LA2A_TELEMETRY_LOG
+    // Opened here rather than in the constructor, so instances a host only
+    // scans or never plays don't create log files
+    if (telemetryLogger == nullptr)
+        telemetryLogger = TelemetryLogger::createFromEnvironment();
+   #endif
 
     // DEBUG: Log bus configuration
     DBG("prepareToPlay called:");
@@ -127,6 +391,12 @@ bool AuDemoProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 
 void AuDemoProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
+   #if LA2A_AUDIO_THREAD_GUARD
+    // Reports any allocation or mutex lock until this block returns
+    const AudioThreadGuard::ScopedRealtime realtimeScope;
+   #endif
+
+    const DspLoadMonitor::ScopedBlock loadScope(loadMonitor, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
 
     auto totalNumInputChannels = getTotalNumInputChannels();
@@ -140,50 +410,108 @@ void AuDemoProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiB
     if (totalNumInputChannels == 0)
         return;
 
-    // Track input level for debugging
-    float maxInput = 0.0f;
-    for (int ch = 0; ch < totalNumInputChannels; ++ch)
+    // NaN/Inf from the host or an upstream plugin would latch in the
+    // analyzer, loudness and compressor filters; zero it before anything runs
+    if (SampleSanitizer::sanitize(buffer))
+        nonFiniteEvents.fetch_add(1, std::memory_order_relaxed);
+
+    // Program and A/B changes are adopted whole at the block boundary, the
+    // newer one winning; their values are used until the parameters have them.
+    // The applied generation is read before the parameters and they before the
+    // requests: parameters the writer had only partly set either come with a
+    // request that is held, or aren't read at all.
+    const auto applied = appliedSnapshotGeneration.load(std::memory_order_acquire);
+    const auto parameters = readParameters();
+
+    if (slotSnapshots.fetch())
     {
-        auto* data = buffer.getReadPointer(ch);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            float absVal = std::abs(data[i]);
-            if (absVal > maxInput) maxInput = absVal;
-        }
+        const auto& snapshot = slotSnapshots.getReadBuffer();
+        compressor.select(snapshot.slot);
+        holdValues(snapshot.values, snapshot.generation);
     }
-    debugInputChannels.store(totalNumInputChannels);
-    debugInputLevel.store(maxInput);
 
-    // Update compressor parameters
-    compressor.setPeakReduction(peakReductionParam->load());
-    compressor.setGain(gainParam->load());
+    const auto request = programRequest.load();
+    if (request != adoptedProgramRequest)
+    {
+        adoptedProgramRequest = request;
 
-    // Handle compression modes: COMP, LIMIT, or BRITISH (both)
-    bool limitOn = limitModeParam->load() > 0.5f;
-    bool compOn = compModeParam->load() > 0.5f;
+        const auto* bank = sharedPresetBank->getBankIfBuilt();
+        const int index = getRequestIndex(request);
 
-    if (limitOn && compOn)
+        if (isValidProgram(bank, index))
+            holdValues(bank->getPreset(index).values, getRequestGeneration(request));
+    }
+
+    if (holdingSnapshot && ! isNewer(heldGeneration, applied))
+        holdingSnapshot = false;
+
+    applyParameters(holdingSnapshot ? heldValues : parameters);
+    compressor.setHighQuality(isNonRealtime());
+
+    // Process audio (the analyzer calls are a flag check unless it is showing)
+    spectrumAnalyzer.pushInput(buffer);
+    compressor.processBlock(buffer);
+    spectrumAnalyzer.pushOutput(buffer);
+    loudnessMeter.process(buffer);
+
+    // Publish the block's telemetry (dropped if the editor isn't draining)
+    const auto& stats = compressor.getLastBlockStats();
+    if (stats.stateRecovered)
+        nonFiniteEvents.fetch_add(1, std::memory_order_relaxed);
+
+    const BlockTelemetry telemetry { stats.inputPeak, stats.inputRms, stats.outputPeak, stats.outputRms,
+                                     stats.minGainDb, stats.maxGainDb, totalNumInputChannels,
+                                     stats.numSamples, loadScope.getElapsedNs(),
+                                     nonFiniteEvents.load(std::memory_order_relaxed) };
+    telemetryFifo.push(telemetry);
+
+   #if LA2A_TELEMETRY_LOG
+    if (telemetryLogger != nullptr)
+        telemetryLogger->push(telemetry);
+   #endif
+}
+
+PresetValues AuDemoProcessor::readParameters() const
+{
+    PresetValues values;
+    values.peakReduction = peakReductionParam->load();
+    values.gain = gainParam->load();
+    values.limitMode = limitModeParam->load() > 0.5f;
+    values.compMode = compModeParam->load() > 0.5f;
+    values.mix = mixParam->load();
+    values.tpCeiling = tpCeilingParam->load() > 0.5f;
+    values.tpCeilingDb = tpCeilingDbParam->load();
+    return values;
+}
+
+void AuDemoProcessor::applyParameters(const PresetValues& values)
+{
+    auto& active = compressor.getActive();
+
+    active.setPeakReduction(values.peakReduction);
+    active.setGain(values.gain);
+
+    // Handle compression modes: COMP, LIMIT, or BRITISH (both)
+    if (values.limitMode && values.compMode)
     {
         // British mode (1176 all-buttons-in style) - aggressive compression
-        compressor.setBritishMode(true);
-        compressor.setLimitMode(false);
+        active.setBritishMode(true);
+        active.setLimitMode(false);
     }
-    else if (limitOn)
+    else if (values.limitMode)
     {
-        compressor.setBritishMode(false);
-        compressor.setLimitMode(true);
+        active.setBritishMode(false);
+        active.setLimitMode(true);
     }
     else
     {
         // Comp mode or neither (default to comp behavior)
-        compressor.setBritishMode(false);
-        compressor.setLimitMode(false);
+        active.setBritishMode(false);
+        active.setLimitMode(false);
     }
 
-    compressor.setMix(mixParam->load());
-
-    // Process audio
-    compressor.processBlock(buffer);
+    active.setMix(values.mix);
+    active.setTruePeakCeiling(values.limitMode && values.tpCeiling, values.tpCeilingDb);
 }
 
 bool AuDemoProcessor::hasEditor() const { return true; }
@@ -196,15 +524,66 @@ juce::AudioProcessorEditor* AuDemoProcessor::createEditor()
 void AuDemoProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    state.setProperty(TRUE_PEAK_MAX_ID, compressor.getMeterSnapshot().truePeakMaxDb, nullptr);
+
+    // Both A/B slots and the selection; the selected slot's values are the parameters
+    const int selected = selectedSlot.load();
+    juce::ValueTree slots(AB_SLOTS_TYPE);
+    slots.setProperty(SELECTED_SLOT_ID, selected, nullptr);
+
+    for (int slot = 0; slot < ABCompressor::NUM_SLOTS; ++slot)
+    {
+        const auto index = static_cast<size_t>(slot);
+        auto values = PresetBank::toValueTree({}, slot == selected ? readParameters() : slotValues[index]);
+        slots.appendChild(values.setProperty(SLOT_USED_ID, slotUsed[index], nullptr), nullptr);
+    }
+
+    state.appendChild(slots, nullptr);
+    PluginState::write(state, destData);
 }
 
 void AuDemoProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
-    if (xml != nullptr && xml->hasTagName(apvts.state.getType()))
-        apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    // Binary state, or the XML blobs written before the binary format existed
+    auto state = PluginState::read(data, sizeInBytes, apvts.state.getType());
+
+    if (state.isValid())
+    {
+        // Held true-peak max travels with the session, not as a parameter
+        if (state.hasProperty(TRUE_PEAK_MAX_ID))
+            compressor.setTruePeakMax(static_cast<float>(state[TRUE_PEAK_MAX_ID]));
+        else
+            compressor.resetTruePeakMax();
+
+        state.removeProperty(TRUE_PEAK_MAX_ID, nullptr);
+
+        // A/B slots; states saved before they were stored select A, with B unused
+        const auto slots = state.getChildWithName(AB_SLOTS_TYPE);
+        const int selected = juce::jlimit(0, ABCompressor::NUM_SLOTS - 1, static_cast<int>(slots.getProperty(SELECTED_SLOT_ID, 0)));
+
+        for (int slot = 0; slot < ABCompressor::NUM_SLOTS; ++slot)
+        {
+            const auto index = static_cast<size_t>(slot);
+            const auto values = slots.getChild(slot);
+            slotValues[index] = PresetBank::fromValueTree(values);
+            slotUsed[index] = slot == selected || static_cast<bool>(values.getProperty(SLOT_USED_ID, false));
+        }
+
+        state.removeChild(slots, nullptr);
+        apvts.replaceState(state);
+        selectedSlot.store(selected);
+        slotValues[static_cast<size_t>(selected)] = readParameters();
+
+        // The compressor switches to the loaded slot at the next block, as for an A/B switch
+        auto& snapshot = slotSnapshots.getWriteBuffer();
+        snapshot.values = slotValues[static_cast<size_t>(selected)];
+        snapshot.slot = selected;
+        snapshot.generation = nextGeneration();
+        slotSnapshots.publish();
+
+        // Loaded state wins over a program change that hasn't reached the parameters yet
+        appliedSnapshotGeneration.store(snapshotGeneration.load(), std::memory_order_release);
+    }
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -1,9 +1,24 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
-#include "dsp/OptoCompressor.h"
-
-class AuDemoProcessor : public juce::AudioProcessor
+#include "PresetBank.h"
+#include "dsp/ABCompressor.h"
+#include "dsp/BlockTelemetry.h"
+#include "dsp/SpectrumAnalyzer.h"
+#include "dsp/DspLoadMonitor.h"
+#include "dsp/LoudnessMeter.h"
+#include "dsp/TripleBuffer.h"
+
+#if LA2A_TELEMETRY_LOG
+ #include "dsp/TelemetryLogger.h"
+#endif
+
+#if LA2A_AUDIO_THREAD_GUARD
+ #include "dsp/AudioThreadGuard.h"
+#endif
+
+class AuDemoProcessor : public juce::AudioProcessor,
+                        private SharedPresetBank::Listener
 {
 public:
     AuDemoProcessor();
@@ -37,17 +52,54 @@ public:
 
     juce::AudioProcessorValueTreeState& getApvts() { return apvts; }
 
+    // Programs are the factory presets followed by the user presets. The bank
+    // is built by the first program query (see SharedPresetBank)
+    const PresetBank& getPresetBank() const { return sharedPresetBank->getBank(); }
+
+    // Message thread: saves the current settings as a user preset and rescans
+    // the bank, so every instance lists it
+    bool saveUserPreset(const juce::String& name);
+
+    // A/B comparison (message thread). Each slot keeps its own settings and
+    // compressor state; switching crossfades between them. Both slots and the
+    // selection are saved with the state.
+    int getABSlot() const { return selectedSlot.load(); }
+    void selectABSlot(int slot);
+
     // Metering access for UI
-    float getGainReductionDb() const { return compressor.getGainReductionDb(); }
-    float getOutputLevel() const { return compressor.getOutputLevel(); }
+    MeterSnapshot getMeterSnapshot() const { return compressor.getMeterSnapshot(); }
+    void resetTruePeakMax() { compressor.resetTruePeakMax(); }
+
+    // Output loudness (computed on the analysis thread)
+    LoudnessMeter::Readings getLoudnessReadings() const { return loudnessMeter.getReadings(); }
+    void resetLoudness() { loudnessMeter.resetIntegrated(); }
 
-    // Debug info
-    int getDebugInputChannels() const { return debugInputChannels.load(); }
-    float getDebugInputLevel() const { return debugInputLevel.load(); }
+    // Per-block telemetry (audio thread pushes, editor drains)
+    TelemetryFifo& getTelemetryFifo() { return telemetryFifo; }
+
+    // Blocks with NaN/Inf input (zeroed before processing) or a compressor
+    // state reset, since construction (any thread)
+    int getNumNonFiniteEvents() const { return nonFiniteEvents.load(std::memory_order_relaxed); }
+
+    // Input/output spectrum (idle unless an editor activates it)
+    SpectrumAnalyzer& getSpectrumAnalyzer() { return spectrumAnalyzer; }
+
+    // Audio thread load of this instance (any thread)
+    DspLoadMonitor::Stats getDspLoadStats() const { return loadMonitor.getStats(); }
+    void resetDspLoadStats() { loadMonitor.requestReset(); }
 
 private:
     juce::AudioProcessorValueTreeState apvts;
-    OptoCompressor compressor;
+    ABCompressor compressor;
+    TelemetryFifo telemetryFifo;
+    SpectrumAnalyzer spectrumAnalyzer;
+    LoudnessMeter loudnessMeter;
+    DspLoadMonitor loadMonitor;
+    std::atomic<int> nonFiniteEvents { 0 };
+
+   #if LA2A_TELEMETRY_LOG
+    std::unique_ptr<TelemetryLogger> telemetryLogger;  // From the first prepareToPlay; null unless LA2A_TELEMETRY_LOG is set
+   #endif
 
     // Parameter pointers for efficient access
     std::atomic<float>* peakReductionParam = nullptr;
@@ -55,10 +107,49 @@ private:
     std::atomic<float>* limitModeParam = nullptr;
     std::atomic<float>* compModeParam = nullptr;
     std::atomic<float>* mixParam = nullptr;
-
-    // Debug
-    std::atomic<int> debugInputChannels{0};
-    std::atomic<float> debugInputLevel{0.0f};
+    std::atomic<float>* tpCeilingParam = nullptr;
+    std::atomic<float>* tpCeilingDbParam = nullptr;
+
+    // Program and A/B changes reach the audio thread as a whole, at a block
+    // boundary. setCurrentProgram() posts the program index and a generation
+    // in programRequest (wait-free, it may run on the audio thread); A/B
+    // switches publish a snapshot. The audio thread adopts the newer of the two
+    // and holds those values until the parameters have them too. On the
+    // message thread the parameters are set straight away; a program change
+    // from any other thread is copied by the process-wide ParameterSync.
+    struct ParameterSnapshot
+    {
+        PresetValues values;
+        int slot = 0;
+        juce::uint32 generation = 0;
+    };
+
+    class ParameterSync;
+
+    juce::SharedResourcePointer<SharedPresetBank> sharedPresetBank;
+    juce::SharedResourcePointer<ParameterSync> parameterSync;
+    std::atomic<int> currentProgram { 0 };
+    std::atomic<juce::uint32> snapshotGeneration { 0 };             // Last generation handed out
+    std::atomic<juce::uint64> programRequest { 0 };                 // Generation << 32 | program index
+    TripleBuffer<ParameterSnapshot> slotSnapshots;                  // Written by the message thread (A/B switch, state load)
+    std::atomic<juce::uint32> appliedSnapshotGeneration { 0 };
+    PresetValues heldValues;                                        // Audio thread
+    juce::uint32 heldGeneration = 0;                                // Audio thread
+    juce::uint64 adoptedProgramRequest = 0;                         // Audio thread
+    bool holdingSnapshot = false;                                   // Audio thread
+
+    // A/B slot settings (message thread)
+    std::atomic<int> selectedSlot { 0 };
+    std::array<PresetValues, ABCompressor::NUM_SLOTS> slotValues {};
+    std::array<bool, ABCompressor::NUM_SLOTS> slotUsed { true, false };
+
+    juce::uint32 nextGeneration();
+    void holdValues(const PresetValues& values, juce::uint32 generation);
+    void copyProgramToParameters();
+    void setParameters(const PresetValues& values);
+    PresetValues readParameters() const;
+    void applyParameters(const PresetValues& values);
+    void presetBankChanged(const PresetBank& previous, const PresetBank& bank) override;
 
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
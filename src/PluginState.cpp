@@ -0,0 +1,69 @@
+#include "PluginState.h"
+
+namespace PluginState
+{
+    void write(const juce::ValueTree& state, juce::MemoryBlock& destData)
+    {
+        destData.reset();
+
+        {
+            juce::MemoryOutputStream out(destData, false);
+            out.writeInt(static_cast<int>(MAGIC));
+            out.writeInt(static_cast<int>(CURRENT_VERSION));
+            out.writeInt(0);
+            state.writeToStream(out);
+        }
+
+        // Go back and fill in the payload size
+        static_cast<juce::uint32*>(destData.getData())[2]
+            = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint32>(destData.getSize()) - HEADER_SIZE);
+    }
+
+    bool isBinary(const void* data, int sizeInBytes)
+    {
+        return data != nullptr && sizeInBytes >= HEADER_SIZE && juce::ByteOrder::littleEndianInt(data) == MAGIC;
+    }
+
+    static juce::ValueTree readBinary(const void* data, int sizeInBytes)
+    {
+        const auto* bytes = static_cast<const char*>(data);
+        const auto version = juce::ByteOrder::littleEndianInt(bytes + 4);
+        const auto payloadSize = static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + 8));
+
+        // A later version may have changed the payload's meaning, so it isn't guessed at
+        if (version == 0 || version > CURRENT_VERSION || payloadSize <= 0 || payloadSize > sizeInBytes - HEADER_SIZE)
+            return {};
+
+        // Version 1 is the only layout so far; later versions migrate here
+        return juce::ValueTree::readFromData(bytes + HEADER_SIZE, static_cast<size_t>(payloadSize));
+    }
+
+    static juce::ValueTree readLegacyXml(const void* data, int sizeInBytes)
+    {
+        // Same layout AudioProcessor::getXmlFromBinary reads: magic, string length, UTF-8 XML
+        if (sizeInBytes <= 8 || juce::ByteOrder::littleEndianInt(data) != LEGACY_XML_MAGIC)
+            return {};
+
+        const auto stringLength = static_cast<int>(juce::ByteOrder::littleEndianInt(static_cast<const char*>(data) + 4));
+        if (stringLength <= 0)
+            return {};
+
+        const auto text = juce::String::fromUTF8(static_cast<const char*>(data) + 8, juce::jmin(sizeInBytes - 8, stringLength));
+
+        if (auto xml = juce::parseXML(text))
+            return juce::ValueTree::fromXml(*xml);
+
+        return {};
+    }
+
+    juce::ValueTree read(const void* data, int sizeInBytes, const juce::Identifier& expectedType)
+    {
+        if (data == nullptr || sizeInBytes <= 0)
+            return {};
+
+        auto state = isBinary(data, sizeInBytes) ? readBinary(data, sizeInBytes)
+                                                 : readLegacyXml(data, sizeInBytes);
+
+        return state.hasType(expectedType) ? state : juce::ValueTree();
+    }
+}
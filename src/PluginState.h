@@ -0,0 +1,31 @@
+#pragma once
+
+#include <juce_data_structures/juce_data_structures.h>
+
+/**
+ * Plugin State Encoding
+ *
+ * Current format (little-endian):
+ *   uint32 magic 'L2AS' | uint32 version | uint32 payload size | ValueTree::writeToStream payload
+ *
+ * The binary ValueTree payload is several times smaller than the XML it
+ * replaces and loads without any text parsing. read() also accepts the legacy
+ * blobs written by AudioProcessor::copyXmlToBinary (magic 0x21324356 + XML),
+ * so sessions saved by earlier versions still open.
+ */
+namespace PluginState
+{
+    static constexpr juce::uint32 MAGIC = 0x5341324c;             // "L2AS"
+    static constexpr juce::uint32 LEGACY_XML_MAGIC = 0x21324356;  // AudioProcessor::copyXmlToBinary
+    static constexpr juce::uint32 CURRENT_VERSION = 1;
+    static constexpr int HEADER_SIZE = 12;
+
+    void write(const juce::ValueTree& state, juce::MemoryBlock& destData);
+
+    // Returns an invalid tree if the data is unreadable, comes from a newer
+    // format version, or its root isn't expectedType
+    juce::ValueTree read(const void* data, int sizeInBytes, const juce::Identifier& expectedType);
+
+    // True if the data starts with the current binary header (any version)
+    bool isBinary(const void* data, int sizeInBytes);
+}
@@ -0,0 +1,207 @@
+#include "PresetBank.h"
+#include "PluginState.h"
+#include <algorithm>
+#include <map>
+
+namespace
+{
+    const juce::Identifier PRESET_TYPE { "Preset" };
+    const juce::Identifier INDEX_TYPE { "PresetIndex" };
+    const juce::Identifier NAME_ID { "name" };
+    const juce::Identifier FILE_ID { "file" };
+    const juce::Identifier SIZE_ID { "size" };
+    const juce::Identifier MODIFIED_ID { "modified" };
+    const juce::Identifier UNREADABLE_ID { "unreadable" };
+
+    struct FactoryPreset
+    {
+        const char* name;
+        PresetValues values;
+    };
+
+    //                              PR      Gain    Limit  Comp   Mix     TP     TP dB
+    const FactoryPreset factoryPresets[] = {
+        { "Init",                 { 0.0f,  0.0f,  false, true,  100.0f, false, -1.0f } },
+        { "Vocal Leveler",        { 45.0f, 6.0f,  false, true,  100.0f, false, -1.0f } },
+        { "Gentle Mix Bus",       { 25.0f, 2.0f,  false, true,  100.0f, false, -1.0f } },
+        { "Bass Smoother",        { 55.0f, 7.5f,  false, true,  100.0f, false, -1.0f } },
+        { "Drum Bus Glue",        { 40.0f, 4.0f,  false, true,  70.0f,  false, -1.0f } },
+        { "Peak Limiter",         { 60.0f, 8.0f,  true,  false, 100.0f, false, -1.0f } },
+        { "Broadcast -1 dBTP",    { 50.0f, 10.0f, true,  false, 100.0f, true,  -1.0f } },
+        { "British Crush",        { 75.0f, 12.0f, true,  true,  100.0f, false, -1.0f } },
+        { "Parallel Drums",       { 80.0f, 14.0f, true,  true,  40.0f,  false, -1.0f } },
+    };
+}
+
+PresetBank::PresetBank(const juce::File& userDirectory)
+{
+    for (const auto& preset : factoryPresets)
+        presets.push_back({ preset.name, preset.values });
+
+    numFactoryPresets = getNumPresets();
+
+    if (userDirectory != juce::File())
+        loadUserPresets(userDirectory);
+}
+
+juce::File PresetBank::getDefaultUserDirectory()
+{
+    // Resolved once per process
+    static const juce::File directory =
+       #if JUCE_MAC
+        juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("Audio/Presets/Tero/LA2ATero");
+       #else
+        juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("LA2ATero/Presets");
+       #endif
+
+    return directory;
+}
+
+juce::ValueTree PresetBank::toValueTree(const juce::String& name, const PresetValues& values)
+{
+    juce::ValueTree tree(PRESET_TYPE);
+    tree.setProperty(NAME_ID, name, nullptr);
+    tree.setProperty("peakReduction", values.peakReduction, nullptr);
+    tree.setProperty("gain", values.gain, nullptr);
+    tree.setProperty("limitMode", values.limitMode, nullptr);
+    tree.setProperty("compMode", values.compMode, nullptr);
+    tree.setProperty("mix", values.mix, nullptr);
+    tree.setProperty("tpCeiling", values.tpCeiling, nullptr);
+    tree.setProperty("tpCeilingDb", values.tpCeilingDb, nullptr);
+    return tree;
+}
+
+PresetValues PresetBank::fromValueTree(const juce::ValueTree& tree)
+{
+    // Values a preset doesn't mention keep their defaults
+    PresetValues values;
+    values.peakReduction = tree.getProperty("peakReduction", values.peakReduction);
+    values.gain = tree.getProperty("gain", values.gain);
+    values.limitMode = tree.getProperty("limitMode", values.limitMode);
+    values.compMode = tree.getProperty("compMode", values.compMode);
+    values.mix = tree.getProperty("mix", values.mix);
+    values.tpCeiling = tree.getProperty("tpCeiling", values.tpCeiling);
+    values.tpCeilingDb = tree.getProperty("tpCeilingDb", values.tpCeilingDb);
+    return values;
+}
+
+bool PresetBank::saveUserPreset(const juce::File& userDirectory, const juce::String& name, const PresetValues& values)
+{
+    if (name.trim().isEmpty() || ! userDirectory.createDirectory())
+        return false;
+
+    juce::MemoryBlock data;
+    PluginState::write(toValueTree(name.trim(), values), data);
+
+    const auto file = userDirectory.getChildFile(juce::File::createLegalFileName(name.trim()) + FILE_EXTENSION);
+    return file.replaceWithData(data.getData(), data.getSize());
+}
+
+const PresetBank& SharedPresetBank::getBank()
+{
+    if (const auto* bank = getBankIfBuilt())
+        return *bank;
+
+    const juce::ScopedLock scopedLock(lock);
+
+    if (banks.empty())
+        return build();
+
+    return *banks.back();
+}
+
+void SharedPresetBank::rescan()
+{
+    const PresetBank* previous = nullptr;
+    const PresetBank* bank = nullptr;
+    {
+        const juce::ScopedLock scopedLock(lock);
+        previous = banks.empty() ? nullptr : banks.back().get();
+        bank = &build();
+    }
+
+    // Nobody can hold programs from a bank that was never built
+    if (previous != nullptr)
+        listeners.call([previous, bank](Listener& listener) { listener.presetBankChanged(*previous, *bank); });
+}
+
+const PresetBank& SharedPresetBank::build()
+{
+    // Older banks stay alive: other threads may still be reading them
+    banks.push_back(std::make_unique<const PresetBank>(PresetBank::getDefaultUserDirectory()));
+    current.store(banks.back().get(), std::memory_order_release);
+    return *banks.back();
+}
+
+void PresetBank::loadUserPresets(const juce::File& userDirectory)
+{
+    const auto indexFile = userDirectory.getChildFile(INDEX_FILE_NAME);
+
+    // Cached entries by file name
+    std::map<juce::String, juce::ValueTree> cached;
+    {
+        juce::MemoryBlock data;
+        if (indexFile.loadFileAsData(data))
+        {
+            const auto index = PluginState::read(data.getData(), static_cast<int>(data.getSize()), INDEX_TYPE);
+
+            for (const auto& entry : index)
+                cached[entry[FILE_ID].toString()] = entry;
+        }
+    }
+
+    juce::ValueTree newIndex(INDEX_TYPE);
+    bool indexChanged = false;
+
+    for (const auto& file : userDirectory.findChildFiles(juce::File::findFiles, false, juce::String("*") + FILE_EXTENSION))
+    {
+        const auto size = file.getSize();
+        const auto modified = file.getLastModificationTime().toMilliseconds();
+        const auto found = cached.find(file.getFileName());
+        auto entry = found != cached.end() ? found->second : juce::ValueTree();
+
+        // A file is only parsed when it is new or has changed since it was indexed
+        if (! entry.isValid()
+            || static_cast<juce::int64>(entry[SIZE_ID]) != size
+            || static_cast<juce::int64>(entry[MODIFIED_ID]) != modified)
+        {
+            juce::MemoryBlock data;
+            file.loadFileAsData(data);
+            ++numFilesParsed;
+            indexChanged = true;
+
+            // A file that doesn't parse is indexed as unreadable, so it isn't read again until it changes
+            entry = PluginState::read(data.getData(), static_cast<int>(data.getSize()), PRESET_TYPE);
+            if (! entry.isValid())
+                entry = juce::ValueTree(PRESET_TYPE).setProperty(UNREADABLE_ID, true, nullptr);
+
+            entry.setProperty(FILE_ID, file.getFileName(), nullptr);
+            entry.setProperty(SIZE_ID, size, nullptr);
+            entry.setProperty(MODIFIED_ID, modified, nullptr);
+        }
+
+        newIndex.appendChild(entry.createCopy(), nullptr);
+    }
+
+    // Deleted files drop out of the index
+    if (newIndex.getNumChildren() != static_cast<int>(cached.size()))
+        indexChanged = true;
+
+    if (indexChanged)
+    {
+        juce::MemoryBlock data;
+        PluginState::write(newIndex, data);
+        indexFile.replaceWithData(data.getData(), data.getSize());
+    }
+
+    std::vector<Preset> userPresets;
+    for (const auto& entry : newIndex)
+        if (! entry[UNREADABLE_ID])
+            userPresets.push_back({ entry[NAME_ID].toString(), fromValueTree(entry) });
+
+    std::sort(userPresets.begin(), userPresets.end(), [](const Preset& a, const Preset& b) {
+        return a.name.compareNatural(b.name) < 0;
+    });
+
+    presets.insert(presets.end(), userPresets.begin(), userPresets.end());
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <juce_data_structures/juce_data_structures.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Sound-shaping parameter values of one preset
+ *
+ * Plain values (not normalised). Meter mode is a display preference, so it
+ * isn't part of a preset.
+ */
+struct PresetValues
+{
+    float peakReduction = 0.0f;
+    float gain = 0.0f;
+    bool limitMode = false;
+    bool compMode = true;
+    float mix = 100.0f;
+    bool tpCeiling = false;
+    float tpCeilingDb = -1.0f;
+};
+
+/**
+ * Factory and User Preset Bank
+ *
+ * Factory presets are compiled in. User presets are .la2apreset files (a
+ * PluginState blob) in one directory; their names and values are cached in an
+ * index file there, so building the bank only lists the directory and parses
+ * the files that were added or changed since the index was written. Files that
+ * don't parse are indexed too, and skipped until they change.
+ *
+ * Factory presets come first, then user presets sorted by name. The list
+ * doesn't change after construction, so it can be read from any thread.
+ */
+class PresetBank
+{
+public:
+    struct Preset
+    {
+        juce::String name;
+        PresetValues values;
+    };
+
+    static constexpr const char* FILE_EXTENSION = ".la2apreset";
+    static constexpr const char* INDEX_FILE_NAME = "presets.index";
+
+    // Pass an invalid File for factory presets only
+    explicit PresetBank(const juce::File& userDirectory);
+
+    static juce::File getDefaultUserDirectory();
+
+    int getNumPresets() const { return static_cast<int>(presets.size()); }
+    int getNumFactoryPresets() const { return numFactoryPresets; }
+    const Preset& getPreset(int index) const { return presets[static_cast<size_t>(index)]; }
+
+    // Number of user preset files parsed while building the bank (the rest came from the index)
+    int getNumFilesParsed() const { return numFilesParsed; }
+
+    // Writes a user preset file to the directory. The bank itself is not
+    // updated; the preset is listed by banks built from now on.
+    static bool saveUserPreset(const juce::File& userDirectory, const juce::String& name, const PresetValues& values);
+
+    static juce::ValueTree toValueTree(const juce::String& name, const PresetValues& values);
+    static PresetValues fromValueTree(const juce::ValueTree& tree);
+
+private:
+    void loadUserPresets(const juce::File& userDirectory);
+
+    std::vector<Preset> presets;
+    int numFactoryPresets = 0;
+    int numFilesParsed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
+
+/**
+ * The bank for the default user directory, shared by all instances in the
+ * process through juce::SharedResourcePointer
+ *
+ * Constructing it does no file I/O, so a host scan that never asks for the
+ * program list doesn't touch the preset directory: the bank is built on the
+ * first getBank(). rescan() builds it again from the index (cheap, only new or
+ * changed files are read) and tells the listeners, e.g. after a preset was
+ * saved. Banks are immutable and kept until the last instance has gone, so a
+ * bank obtained here stays valid even after a rescan.
+ */
+class SharedPresetBank
+{
+public:
+    struct Listener
+    {
+        virtual ~Listener() = default;
+
+        // Called on the thread that called rescan(), with the bank used before
+        virtual void presetBankChanged(const PresetBank& previous, const PresetBank& bank) = 0;
+    };
+
+    SharedPresetBank() = default;
+
+    // Builds the bank on the first call, so not for the audio thread
+    const PresetBank& getBank();
+
+    // Wait-free: nullptr until the bank has been built
+    const PresetBank* getBankIfBuilt() const { return current.load(std::memory_order_acquire); }
+
+    // Rebuilds the bank from the directory and notifies the listeners
+    void rescan();
+
+    void addListener(Listener* listener) { listeners.add(listener); }
+    void removeListener(Listener* listener) { listeners.remove(listener); }
+
+private:
+    juce::CriticalSection lock;
+    std::vector<std::unique_ptr<const PresetBank>> banks;   // Every bank built, the current one last
+    std::atomic<const PresetBank*> current { nullptr };
+    juce::ListenerList<Listener, juce::Array<Listener*, juce::CriticalSection>> listeners;
+
+    const PresetBank& build();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedPresetBank)
+};
@@ -0,0 +1,122 @@
+#include "ABCompressor.h"
+#include <cmath>
+
+void ABCompressor::prepare(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    for (auto& slot : slots)
+        slot.prepare(sampleRate, samplesPerBlock, numChannels);
+
+    // The incoming slot's lookahead delay starts empty, so it stays silent
+    // until the delay has filled with current audio, then fades in
+    fadeDelay = slots[0].getLatencySamples();
+    const int fadeSamples = juce::jmax(1, juce::roundToInt(sampleRate * CROSSFADE_SECONDS));
+    crossfadeLength = fadeDelay + fadeSamples;
+
+    fadeBuffer.setSize(juce::jmax(1, numChannels), crossfadeLength);
+    fadeInGains.assign(static_cast<size_t>(crossfadeLength), 0.0f);
+    fadeOutGains.assign(static_cast<size_t>(crossfadeLength), 1.0f);
+
+    for (int i = 0; i < fadeSamples; ++i)
+    {
+        const auto phase = juce::MathConstants<double>::halfPi * (i + 1) / fadeSamples;
+        fadeInGains[static_cast<size_t>(fadeDelay + i)] = static_cast<float>(std::sin(phase));
+        fadeOutGains[static_cast<size_t>(fadeDelay + i)] = static_cast<float>(std::cos(phase));
+    }
+
+    reset();
+}
+
+void ABCompressor::reset()
+{
+    for (auto& slot : slots)
+        slot.reset();
+
+    crossfadeRemaining = 0;
+    samplePosition = 0;
+}
+
+void ABCompressor::setHighQuality(bool shouldUseHighQuality)
+{
+    for (auto& slot : slots)
+        slot.setHighQuality(shouldUseHighQuality);
+}
+
+void ABCompressor::resetTruePeakMax()
+{
+    for (auto& slot : slots)
+        slot.resetTruePeakMax();
+}
+
+void ABCompressor::setTruePeakMax(float dB)
+{
+    for (auto& slot : slots)
+        slot.setTruePeakMax(dB);
+}
+
+void ABCompressor::select(int slot)
+{
+    slot = juce::jlimit(0, NUM_SLOTS - 1, slot);
+    if (slot == activeSlot)
+        return;
+
+    if (crossfadeRemaining > 0)
+    {
+        // Switching back mid-fade reverses the fade from where it is, so the
+        // two gains continue from their current values. Both delays are full
+        // by now, so there's no silent start; before the incoming slot became
+        // audible there is nothing to undo.
+        const int position = crossfadeLength - crossfadeRemaining;
+        crossfadeRemaining = juce::jmax(0, position - fadeDelay);
+    }
+    else
+    {
+        crossfadeRemaining = crossfadeLength;
+
+        // Envelope state is kept; audio left in the lookahead delay since the
+        // slot last ran is not
+        slots[static_cast<size_t>(slot)].resetOutputStage();
+    }
+
+    fadingSlot = activeSlot;
+    activeSlot = slot;
+    slots[static_cast<size_t>(activeSlot)].setSamplePosition(samplePosition);
+    meteredSlot.store(activeSlot, std::memory_order_relaxed);
+}
+
+void ABCompressor::processBlock(juce::AudioBuffer<float>& buffer)
+{
+    // The fade never spans more than crossfadeLength samples, which is what
+    // the fade buffer holds, so any block size works without reallocating
+    const int numChannels = juce::jmin(buffer.getNumChannels(), fadeBuffer.getNumChannels());
+    const int fadeSamples = juce::jmin(crossfadeRemaining, buffer.getNumSamples());
+
+    if (fadeSamples > 0)
+    {
+        // The outgoing slot only processes the fade region, from a copy of the input
+        for (int ch = 0; ch < numChannels; ++ch)
+            fadeBuffer.copyFrom(ch, 0, buffer, ch, 0, fadeSamples);
+
+        juce::AudioBuffer<float> fading(fadeBuffer.getArrayOfWritePointers(), numChannels, 0, fadeSamples);
+        slots[static_cast<size_t>(fadingSlot)].processBlock(fading);
+    }
+
+    slots[static_cast<size_t>(activeSlot)].processBlock(buffer);
+
+    if (fadeSamples > 0)
+    {
+        // Equal power: incoming * sin + outgoing * cos
+        const auto position = static_cast<size_t>(crossfadeLength - crossfadeRemaining);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* output = buffer.getWritePointer(ch);
+            juce::FloatVectorOperations::multiply(output, fadeInGains.data() + position, fadeSamples);
+            juce::FloatVectorOperations::addWithMultiply(output, fadeBuffer.getReadPointer(ch),
+                                                         fadeOutGains.data() + position, fadeSamples);
+        }
+
+        crossfadeRemaining -= fadeSamples;
+    }
+
+    samplePosition += buffer.getNumSamples();
+}
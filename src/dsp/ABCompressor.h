@@ -0,0 +1,66 @@
+#pragma once
+
+#include "OptoCompressor.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+ * A/B Compressor Slots
+ *
+ * Two complete OptoCompressor instances, each keeping its own settings and
+ * envelope state. Only the active slot runs, so A/B costs nothing in steady
+ * state. Selecting the other slot starts a 30 ms equal-power crossfade during
+ * which both run (after the incoming slot's lookahead delay has refilled); the
+ * outgoing slot then stops where it is and picks up from that state when it is
+ * selected again.
+ *
+ * The crossfade works on preallocated buffers and precomputed sin/cos gain
+ * tables, mixed with FloatVectorOperations.
+ */
+class ABCompressor
+{
+public:
+    static constexpr int NUM_SLOTS = 2;
+
+    ABCompressor() = default;
+
+    // Not the audio thread: prepares both slots and the crossfade buffers
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels);
+    void reset();
+
+    // Audio thread. Parameter setters go to the active slot.
+    OptoCompressor& getActive() { return slots[static_cast<size_t>(activeSlot)]; }
+    void select(int slot);
+    void setHighQuality(bool shouldUseHighQuality);
+    void processBlock(juce::AudioBuffer<float>& buffer);
+
+    int getActiveSlot() const { return activeSlot; }
+    bool isCrossfading() const { return crossfadeRemaining > 0; }
+    const OptoCompressor::BlockStats& getLastBlockStats() const { return slots[static_cast<size_t>(activeSlot)].getLastBlockStats(); }
+
+    // Any thread
+    int getLatencySamples() const { return slots[0].getLatencySamples(); }
+    MeterSnapshot getMeterSnapshot() const { return slots[static_cast<size_t>(meteredSlot.load(std::memory_order_relaxed))].getMeterSnapshot(); }
+    void resetTruePeakMax();
+    void setTruePeakMax(float dB);
+
+private:
+    std::array<OptoCompressor, NUM_SLOTS> slots;
+    int activeSlot = 0;
+    int fadingSlot = 0;
+    juce::int64 samplePosition = 0;     // Keeps a resumed slot on the sub-block grid
+    std::atomic<int> meteredSlot { 0 };
+
+    // Crossfade
+    juce::AudioBuffer<float> fadeBuffer;        // Outgoing slot's output (one crossfade long)
+    std::vector<float> fadeInGains;             // 0 for fadeDelay samples, then sin 0 -> 1
+    std::vector<float> fadeOutGains;            // 1 for fadeDelay samples, then cos 1 -> 0
+    int fadeDelay = 0;                          // Output stage latency
+    int crossfadeLength = 0;                    // fadeDelay + 30 ms
+    int crossfadeRemaining = 0;
+
+    static constexpr double CROSSFADE_SECONDS = 0.03;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ABCompressor)
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+ * Process-wide low-priority worker for metering analysis
+ *
+ * Held through juce::SharedResourcePointer, so every plugin instance shares a
+ * single thread. The thread only runs while at least one client is registered:
+ * it is started by the first addClient() and stopped by the last removeClient().
+ *
+ * addClient() and removeClient() are for the message thread (or any
+ * non-realtime thread); removeClient() blocks until the client's current
+ * time slice has finished.
+ */
+class AnalysisThread
+{
+public:
+    AnalysisThread() = default;
+
+    ~AnalysisThread()
+    {
+        thread.stopThread(2000);
+    }
+
+    void addClient(juce::TimeSliceClient* client)
+    {
+        const juce::ScopedLock sl(lock);
+        thread.addTimeSliceClient(client);
+
+        if (! thread.isThreadRunning())
+            thread.startThread(juce::Thread::Priority::low);
+    }
+
+    void removeClient(juce::TimeSliceClient* client)
+    {
+        const juce::ScopedLock sl(lock);
+        thread.removeTimeSliceClient(client);
+
+        if (thread.getNumClients() == 0)
+            thread.stopThread(2000);
+    }
+
+private:
+    juce::CriticalSection lock;
+    juce::TimeSliceThread thread { "LA2A analysis" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisThread)
+};
@@ -0,0 +1,286 @@
+#include "AudioThreadGuard.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if JUCE_LINUX
+ #include <dlfcn.h>
+ #include <malloc.h>
+ #include <pthread.h>
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+}
+#endif
+
+#if JUCE_WINDOWS
+ #include <malloc.h>
+#endif
+
+namespace
+{
+   #if JUCE_LINUX
+    // Static TLS: a dynamically allocated TLS block (the default in a dlopen'ed
+    // plugin) may itself be allocated on first access, from inside malloc
+    #define LA2A_GUARD_THREAD_LOCAL thread_local __attribute__((tls_model("initial-exec")))
+   #else
+    #define LA2A_GUARD_THREAD_LOCAL thread_local
+   #endif
+
+    LA2A_GUARD_THREAD_LOCAL bool isRealtime = false;
+    LA2A_GUARD_THREAD_LOCAL bool isReporting = false;
+    LA2A_GUARD_THREAD_LOCAL int* allocationCounter = nullptr;
+
+    std::atomic<int> numViolations { 0 };
+    std::atomic<bool> reportsEnabled { true };
+
+    bool shouldAbort()
+    {
+        static const bool abortOnViolation = [] {
+            const auto* value = std::getenv("LA2A_AUDIO_THREAD_GUARD_ABORT");
+            return value != nullptr && *value != '\0' && *value != '0';
+        }();
+
+        return abortOnViolation;
+    }
+
+    void report(const char* what)
+    {
+        // Reporting allocates; nothing it does is reported again
+        isReporting = true;
+
+        const int count = ++numViolations;
+
+        if (reportsEnabled.load() && count <= AudioThreadGuard::MAX_REPORTS)
+        {
+            const auto trace = juce::SystemStats::getStackBacktrace();
+            std::fprintf(stderr, "*** LA2ATero audio thread guard: %s inside processBlock (violation %d)\n%s\n",
+                         what, count, trace.toRawUTF8());
+            std::fflush(stderr);
+        }
+
+        if (shouldAbort())
+            std::abort();
+
+        isReporting = false;
+    }
+
+    void onAllocation(const char* what)
+    {
+        if (allocationCounter != nullptr)
+            ++*allocationCounter;
+
+        if (isRealtime && ! isReporting)
+            report(what);
+    }
+
+    void onRelease(const char* what, const void* p)
+    {
+        if (p != nullptr && isRealtime && ! isReporting)
+            report(what);
+    }
+
+    //==============================================================================
+    void* rawMalloc(size_t size)
+    {
+       #if JUCE_LINUX
+        return __libc_malloc(size);
+       #else
+        return std::malloc(size);
+       #endif
+    }
+
+    void rawFree(void* p)
+    {
+       #if JUCE_LINUX
+        __libc_free(p);
+       #else
+        std::free(p);
+       #endif
+    }
+
+    void* rawAlignedAlloc(size_t alignment, size_t size)
+    {
+       #if JUCE_LINUX
+        return __libc_memalign(alignment, size);
+       #elif JUCE_WINDOWS
+        return _aligned_malloc(size, alignment);
+       #else
+        void* p = nullptr;
+        return posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) == 0 ? p : nullptr;
+       #endif
+    }
+
+    void rawAlignedFree(void* p)
+    {
+       #if JUCE_WINDOWS
+        _aligned_free(p);
+       #else
+        rawFree(p);
+       #endif
+    }
+
+    void* newImpl(size_t size)
+    {
+        onAllocation("operator new");
+
+        if (auto* p = rawMalloc(size == 0 ? 1 : size))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    void* newAlignedImpl(size_t size, std::align_val_t alignment)
+    {
+        onAllocation("operator new");
+
+        if (auto* p = rawAlignedAlloc(static_cast<size_t>(alignment), size == 0 ? 1 : size))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    void deleteImpl(void* p)
+    {
+        onRelease("operator delete", p);
+        rawFree(p);
+    }
+
+    void deleteAlignedImpl(void* p)
+    {
+        onRelease("operator delete", p);
+        rawAlignedFree(p);
+    }
+}
+
+//==============================================================================
+AudioThreadGuard::ScopedRealtime::ScopedRealtime() : wasRealtime(isRealtime)
+{
+    isRealtime = true;
+}
+
+AudioThreadGuard::ScopedRealtime::~ScopedRealtime()
+{
+    isRealtime = wasRealtime;
+}
+
+int AudioThreadGuard::getNumViolations()
+{
+    return numViolations.load();
+}
+
+void AudioThreadGuard::setReportsEnabled(bool shouldPrint)
+{
+    reportsEnabled.store(shouldPrint);
+}
+
+int* AudioThreadGuard::setThreadAllocationCounter(int* counter)
+{
+    auto* previous = allocationCounter;
+    allocationCounter = counter;
+    return previous;
+}
+
+//==============================================================================
+void* operator new(size_t size) { return newImpl(size); }
+void* operator new[](size_t size) { return newImpl(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return newAlignedImpl(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return newAlignedImpl(size, alignment); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    try { return newImpl(size); } catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    try { return newImpl(size); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { deleteImpl(p); }
+void operator delete[](void* p) noexcept { deleteImpl(p); }
+void operator delete(void* p, size_t) noexcept { deleteImpl(p); }
+void operator delete[](void* p, size_t) noexcept { deleteImpl(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { deleteImpl(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { deleteImpl(p); }
+void operator delete(void* p, std::align_val_t) noexcept { deleteAlignedImpl(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { deleteAlignedImpl(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { deleteAlignedImpl(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { deleteAlignedImpl(p); }
+
+//==============================================================================
+#if JUCE_LINUX
+extern "C"
+{
+    void* malloc(size_t size) noexcept
+    {
+        onAllocation("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        onAllocation("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* p, size_t size) noexcept
+    {
+        onAllocation("realloc");
+        return __libc_realloc(p, size);
+    }
+
+    void free(void* p) noexcept
+    {
+        onRelease("free", p);
+        __libc_free(p);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        onAllocation("posix_memalign");
+
+        if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        onAllocation("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        using LockFunction = int (*)(pthread_mutex_t*);
+        static std::atomic<LockFunction> realLock { nullptr };
+
+        auto lock = realLock.load(std::memory_order_relaxed);
+        if (lock == nullptr)
+        {
+            lock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+
+            if (lock == nullptr || lock == &pthread_mutex_lock)
+                lock = reinterpret_cast<LockFunction>(dlsym(RTLD_DEFAULT, "pthread_mutex_lock"));
+
+            realLock.store(lock, std::memory_order_relaxed);
+        }
+
+        if (isRealtime && ! isReporting)
+            report("pthread_mutex_lock");
+
+        return lock(mutex);
+    }
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * Real-Time Safety Guard for the Audio Thread
+ *
+ * Only compiled into builds configured with LA2A_ENABLE_AUDIO_THREAD_GUARD.
+ * Such builds replace the global operator new/delete and, on Linux, malloc,
+ * calloc, realloc, free, posix_memalign, aligned_alloc and pthread_mutex_lock
+ * with versions that forward to the real ones, but first report (with a stack
+ * trace on stderr) any call made while the calling thread is inside a
+ * ScopedRealtime - which AuDemoProcessor::processBlock opens for its whole
+ * duration.
+ *
+ * Reports go to stderr (the first MAX_REPORTS of them; all are counted). With
+ * LA2A_AUDIO_THREAD_GUARD_ABORT=1 in the environment the process aborts at the
+ * first violation instead, for a core dump or a debugger stop.
+ *
+ * The interception covers code compiled into this binary (the plugin and the
+ * JUCE modules it builds), not calls made inside other shared libraries.
+ */
+class AudioThreadGuard
+{
+public:
+    static constexpr int MAX_REPORTS = 50;
+
+    // Marks the calling thread as real-time until destroyed. Nests.
+    class ScopedRealtime
+    {
+    public:
+        ScopedRealtime();
+        ~ScopedRealtime();
+
+    private:
+        bool wasRealtime;
+
+        ScopedRealtime(const ScopedRealtime&) = delete;
+        ScopedRealtime& operator=(const ScopedRealtime&) = delete;
+    };
+
+    // Violations since the process started (any thread)
+    static int getNumViolations();
+
+    // Whether violations are printed (they are always counted). For tests
+    // that provoke violations on purpose.
+    static void setReportsEnabled(bool shouldPrint);
+
+    // Counts every allocation the calling thread makes into *counter, real-time
+    // or not, until replaced; returns the previous counter. For tests.
+    static int* setThreadAllocationCounter(int* counter);
+
+private:
+    AudioThreadGuard() = delete;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "SpscFifo.h"
+
+/**
+ * Per-block telemetry record
+ *
+ * Pushed by the audio thread after every processed block. The editor drains
+ * it for the history graph and the DSP overlay; when built with
+ * LA2A_TELEMETRY_LOG, TelemetryLogger writes the same records to disk.
+ * The levels come from the compressor's own sample loop, so publishing a
+ * record costs no extra pass over the buffer.
+ */
+struct BlockTelemetry
+{
+    float inputPeak = 0.0f;         // Linear
+    float inputRms = 0.0f;
+    float outputPeak = 0.0f;
+    float outputRms = 0.0f;
+    float minGainDb = 0.0f;         // Deepest gain reduction (dB, <= 0)
+    float maxGainDb = 0.0f;         // Shallowest gain reduction (dB, <= 0)
+    int numChannels = 0;
+    int numSamples = 0;
+    juce::int64 processingNs = 0;   // processBlock() time up to the point the record was made
+    int nonFiniteEvents = 0;        // NaN/Inf blocks so far (cumulative, so dropped records lose nothing)
+};
+
+// Over a second of 64-sample blocks at 48 kHz; records are dropped if nobody is draining
+using TelemetryFifo = SpscFifo<BlockTelemetry, 1024>;
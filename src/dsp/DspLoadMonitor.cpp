@@ -0,0 +1,128 @@
+#include "DspLoadMonitor.h"
+
+DspLoadMonitor::DspLoadMonitor()
+{
+    nsPerTick = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+}
+
+void DspLoadMonitor::prepare(double newSampleRate, int maximumBlockSize)
+{
+    loadMeasurer.reset(newSampleRate, maximumBlockSize);
+    nsPerSample = newSampleRate > 0.0 ? 1.0e9 / newSampleRate : 0.0;
+    sampleRate.store(newSampleRate, std::memory_order_relaxed);
+    clear();
+}
+
+void DspLoadMonitor::clear()
+{
+    for (auto& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+
+    numBlocks.store(0, std::memory_order_relaxed);
+    totalNs.store(0, std::memory_order_relaxed);
+    worstNs.store(0, std::memory_order_relaxed);
+    worstBudgetProportion.store(0.0f, std::memory_order_relaxed);
+    maxBlockSize.store(0, std::memory_order_relaxed);
+    resetRequested.store(false, std::memory_order_relaxed);
+}
+
+int DspLoadMonitor::getBucketForNs(juce::uint64 ns)
+{
+    if (ns < FIRST_BUCKET_NS)
+        return 0;
+
+    // Four buckets per octave: the octave from the highest set bit,
+    // the quarter from the two bits below it
+    const auto clamped = static_cast<juce::uint32>(juce::jmin(ns, static_cast<juce::uint64>(0xffffffffu)));
+    const int octave = juce::findHighestSetBit(clamped);
+    const int quarter = static_cast<int>((clamped >> (octave - 2)) & 3u);
+    const int firstOctave = juce::findHighestSetBit(FIRST_BUCKET_NS);
+
+    return juce::jmin(NUM_BUCKETS - 1, 1 + (octave - firstOctave) * 4 + quarter);
+}
+
+double DspLoadMonitor::getBucketUpperNs(int bucket)
+{
+    if (bucket <= 0)
+        return static_cast<double>(FIRST_BUCKET_NS);
+
+    const int octave = juce::findHighestSetBit(FIRST_BUCKET_NS) + (bucket - 1) / 4;
+    const int quarter = (bucket - 1) % 4;
+    return std::ldexp(static_cast<double>(5 + quarter), octave - 2);
+}
+
+void DspLoadMonitor::recordBlock(juce::int64 elapsedTicks, int numSamples)
+{
+    if (resetRequested.load(std::memory_order_relaxed))
+        clear();
+
+    const double elapsedNs = static_cast<double>(elapsedTicks) * nsPerTick;
+    const auto ns = static_cast<juce::int64>(elapsedNs);
+
+    loadMeasurer.registerRenderTime(elapsedNs * 1.0e-6, numSamples);
+
+    increment(buckets[static_cast<size_t>(getBucketForNs(static_cast<juce::uint64>(juce::jmax<juce::int64>(0, ns))))], 1u);
+    increment(numBlocks, static_cast<juce::int64>(1));
+    increment(totalNs, ns);
+
+    if (ns > worstNs.load(std::memory_order_relaxed))
+        worstNs.store(ns, std::memory_order_relaxed);
+
+    if (numSamples > 0 && nsPerSample > 0.0)
+    {
+        const auto proportion = static_cast<float>(elapsedNs / (nsPerSample * numSamples));
+        if (proportion > worstBudgetProportion.load(std::memory_order_relaxed))
+            worstBudgetProportion.store(proportion, std::memory_order_relaxed);
+    }
+
+    lastBlockSize.store(numSamples, std::memory_order_relaxed);
+    if (numSamples > maxBlockSize.load(std::memory_order_relaxed))
+        maxBlockSize.store(numSamples, std::memory_order_relaxed);
+}
+
+DspLoadMonitor::Stats DspLoadMonitor::getStats() const
+{
+    Stats stats;
+    stats.loadProportion = loadMeasurer.getLoadAsProportion();
+    stats.overruns = loadMeasurer.getXRunCount();
+    stats.worstNs = static_cast<double>(worstNs.load(std::memory_order_relaxed));
+    stats.worstBudgetProportion = worstBudgetProportion.load(std::memory_order_relaxed);
+    stats.lastBlockSize = lastBlockSize.load(std::memory_order_relaxed);
+    stats.maxBlockSize = maxBlockSize.load(std::memory_order_relaxed);
+    stats.sampleRate = sampleRate.load(std::memory_order_relaxed);
+
+    std::array<juce::uint32, NUM_BUCKETS> counts {};
+    juce::int64 total = 0;
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    stats.numBlocks = total;
+
+    if (total == 0)
+        return stats;
+
+    stats.meanNs = static_cast<double>(totalNs.load(std::memory_order_relaxed))
+                 / static_cast<double>(juce::jmax<juce::int64>(1, numBlocks.load(std::memory_order_relaxed)));
+
+    auto percentile = [&](double fraction) {
+        const auto target = static_cast<juce::int64>(std::ceil(fraction * static_cast<double>(total)));
+        juce::int64 seen = 0;
+
+        for (int bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+        {
+            seen += counts[static_cast<size_t>(bucket)];
+            if (seen >= target)
+                return juce::jmin(getBucketUpperNs(bucket), stats.worstNs);
+        }
+
+        return stats.worstNs;
+    };
+
+    stats.p50Ns = percentile(0.50);
+    stats.p99Ns = percentile(0.99);
+    return stats;
+}
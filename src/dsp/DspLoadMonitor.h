@@ -0,0 +1,111 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Per-Instance Audio Thread Load Monitor
+ *
+ * Times every processBlock() call and feeds:
+ * - juce::AudioProcessLoadMeasurer (smoothed load, blocks over their own duration)
+ * - A fixed-bucket histogram of ns per block (quarter-octave buckets)
+ * - Worst block time and worst share of a block's real-time budget
+ * - Block size and sample rate context
+ *
+ * The audio thread is the only writer and never locks or allocates; every
+ * counter is a relaxed atomic, so getStats() can be called from any thread.
+ * The histogram is approximate while audio is running (counters are read one
+ * by one), which is fine for percentiles.
+ */
+class DspLoadMonitor
+{
+public:
+    static constexpr int NUM_BUCKETS = 64;
+    static constexpr juce::uint32 FIRST_BUCKET_NS = 256;   // Bucket 0 is everything below this
+
+    struct Stats
+    {
+        double loadProportion = 0.0;        // Smoothed block time / block duration
+        int overruns = 0;                   // Blocks that took longer than their own duration
+        juce::int64 numBlocks = 0;
+        double meanNs = 0.0;
+        double p50Ns = 0.0;                 // Upper edge of the percentile's bucket
+        double p99Ns = 0.0;
+        double worstNs = 0.0;
+        double worstBudgetProportion = 0.0; // Worst block time / that block's duration
+        int lastBlockSize = 0;
+        int maxBlockSize = 0;
+        double sampleRate = 0.0;
+    };
+
+    // Times one block; construct at the top of processBlock()
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(DspLoadMonitor& m, int numSamplesInBlock)
+            : monitor(m), numSamples(numSamplesInBlock), startTicks(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~ScopedBlock()
+        {
+            monitor.recordBlock(juce::Time::getHighResolutionTicks() - startTicks, numSamples);
+        }
+
+        // Time since construction, for per-block telemetry
+        juce::int64 getElapsedNs() const
+        {
+            return static_cast<juce::int64>(static_cast<double>(juce::Time::getHighResolutionTicks() - startTicks)
+                                            * monitor.nsPerTick);
+        }
+
+    private:
+        DspLoadMonitor& monitor;
+        int numSamples;
+        juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+    DspLoadMonitor();
+
+    // Not concurrent with processBlock(); clears all statistics
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    // Any thread: statistics are cleared by the audio thread at its next block
+    void requestReset() { resetRequested.store(true, std::memory_order_relaxed); }
+
+    Stats getStats() const;
+
+    // Bucket boundaries, for reporting
+    static int getBucketForNs(juce::uint64 ns);
+    static double getBucketUpperNs(int bucket);
+
+private:
+    void recordBlock(juce::int64 elapsedTicks, int numSamples);
+    void clear();
+
+    template <typename T>
+    static void increment(std::atomic<T>& value, T amount)
+    {
+        // Single writer, so a plain load/store is enough (no locked read-modify-write)
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    juce::AudioProcessLoadMeasurer loadMeasurer;
+    double nsPerTick = 1.0;
+    double nsPerSample = 0.0;
+
+    std::array<std::atomic<juce::uint32>, NUM_BUCKETS> buckets {};
+    std::atomic<juce::int64> numBlocks { 0 };
+    std::atomic<juce::int64> totalNs { 0 };
+    std::atomic<juce::int64> worstNs { 0 };
+    std::atomic<float> worstBudgetProportion { 0.0f };
+    std::atomic<int> lastBlockSize { 0 };
+    std::atomic<int> maxBlockSize { 0 };
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<bool> resetRequested { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspLoadMonitor)
+};
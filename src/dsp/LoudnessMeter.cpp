@@ -0,0 +1,306 @@
+#include "LoudnessMeter.h"
+#include <algorithm>
+#include <cmath>
+
+LoudnessMeter::LoudnessMeter()
+{
+    setSampleRate(44100.0);
+}
+
+LoudnessMeter::~LoudnessMeter()
+{
+    analysisThread->removeClient(this);
+}
+
+void LoudnessMeter::prepare(double sampleRate, int numChannels, bool useAnalysisThread)
+{
+    numPrepared = juce::jlimit(0, MAX_CHANNELS, numChannels);
+    setSampleRate(sampleRate);
+
+    if (useAnalysisThread)
+    {
+        resetIntegrated();
+        analysisThread->addClient(this);
+    }
+    else
+    {
+        // Nothing else touches the meter now, so start over directly
+        analysisThread->removeClient(this);
+        resetRequested.store(false);
+        steps.reset();
+        clearMeasurement();
+    }
+}
+
+void LoudnessMeter::setSampleRate(double sampleRate)
+{
+    stepLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    // BS.1770-4 K-weighting, recomputed for the actual sample rate
+    // (the standard tabulates both stages for 48 kHz only)
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        preFilter.b0 = Vec::expand((vh + vb * k / q + k * k) / a0);
+        preFilter.b1 = Vec::expand(2.0 * (k * k - vh) / a0);
+        preFilter.b2 = Vec::expand((vh - vb * k / q + k * k) / a0);
+        preFilter.a1 = Vec::expand(2.0 * (k * k - 1.0) / a0);
+        preFilter.a2 = Vec::expand((1.0 - k / q + k * k) / a0);
+    }
+
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        rlbFilter.b0 = Vec::expand(1.0);
+        rlbFilter.b1 = Vec::expand(-2.0);
+        rlbFilter.b2 = Vec::expand(1.0);
+        rlbFilter.a1 = Vec::expand(2.0 * (k * k - 1.0) / a0);
+        rlbFilter.a2 = Vec::expand((1.0 - k / q + k * k) / a0);
+    }
+
+    pre1 = pre2 = rlb1 = rlb2 = energy = Vec::expand(0.0);
+    samplesInStep = 0;
+}
+
+void LoudnessMeter::process(const juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), numPrepared);
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0)
+        return;
+
+    const float* channels[MAX_CHANNELS] = {};
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[ch] = buffer.getReadPointer(ch);
+
+    // Samples are interleaved a chunk at a time (one frame per SIMD register)
+    // before filtering, so each frame is a single aligned vector load
+    constexpr int lanes = static_cast<int>(Vec::SIMDNumElements);
+    alignas(Vec::SIMDRegisterSize) double frames[CHUNK_SIZE * lanes] = {};
+
+    // Locals so the filter state stays in registers through the loop
+    auto s1 = pre1, s2 = pre2, t1 = rlb1, t2 = rlb2, sum = energy;
+    const auto pb0 = preFilter.b0, pb1 = preFilter.b1, pb2 = preFilter.b2, pa1 = preFilter.a1, pa2 = preFilter.a2;
+    const auto ra1 = rlbFilter.a1, ra2 = rlbFilter.a2;
+
+    for (int start = 0; start < numSamples; start += CHUNK_SIZE)
+    {
+        const int num = juce::jmin(CHUNK_SIZE, numSamples - start);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int n = 0; n < num; ++n)
+                frames[n * lanes + ch] = static_cast<double>(channels[ch][start + n]);
+
+        for (int n = 0; n < num; ++n)
+        {
+            const auto x = Vec::fromRawArray(frames + n * lanes);
+
+            // Transposed direct form II, both stages. The feedback term is
+            // subtracted last to keep the loop-carried dependency short.
+            const auto y = pb0 * x + s1;
+            s1 = (pb1 * x + s2) - pa1 * y;
+            s2 = pb2 * x - pa2 * y;
+
+            const auto z = y + t1;
+            t1 = (t2 - (y + y)) - ra1 * z;
+            t2 = y - ra2 * z;
+
+            sum = Vec::multiplyAdd(sum, z, z);
+
+            if (++samplesInStep == stepLength)
+            {
+                // Dropped if the analysis thread has stalled; the meter then skips ahead
+                steps.push({ sum.sum(), stepLength });
+                sum = Vec::expand(0.0);
+                samplesInStep = 0;
+            }
+        }
+    }
+
+    pre1 = s1;
+    pre2 = s2;
+    rlb1 = t1;
+    rlb2 = t2;
+    energy = sum;
+}
+
+float LoudnessMeter::energyToLufs(double meanSquare)
+{
+    if (meanSquare <= 0.0)
+        return NO_LOUDNESS;
+
+    return juce::jmax(NO_LOUDNESS, static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)));
+}
+
+int LoudnessMeter::levelToBin(float lufs)
+{
+    const auto bin = static_cast<int>(std::floor((lufs - GatingHistogram::MIN_LUFS) / GatingHistogram::BIN_WIDTH));
+    return juce::jlimit(0, GatingHistogram::NUM_BINS - 1, bin);
+}
+
+void LoudnessMeter::GatingHistogram::clear()
+{
+    counts.fill(0);
+    energies.fill(0.0);
+    total = 0;
+}
+
+void LoudnessMeter::GatingHistogram::add(double energy)
+{
+    const float lufs = energyToLufs(energy);
+
+    // Absolute gate
+    if (lufs < MIN_LUFS)
+        return;
+
+    const auto bin = static_cast<size_t>(levelToBin(lufs));
+    ++counts[bin];
+    energies[bin] += energy;
+    ++total;
+}
+
+double LoudnessMeter::GatingHistogram::getMeanEnergyAbove(float lufs) const
+{
+    double energySum = 0.0;
+    juce::int64 count = 0;
+
+    for (int bin = levelToBin(lufs); bin < NUM_BINS; ++bin)
+    {
+        energySum += energies[static_cast<size_t>(bin)];
+        count += counts[static_cast<size_t>(bin)];
+    }
+
+    return count > 0 ? energySum / static_cast<double>(count) : 0.0;
+}
+
+void LoudnessMeter::clearMeasurement()
+{
+    recentSteps.fill(0.0);
+    recentPosition = 0;
+    numSteps = 0;
+    momentaryHistogram.clear();
+    shortTermHistogram.clear();
+    readings.write({});
+}
+
+void LoudnessMeter::addStep(double meanSquare)
+{
+    recentSteps[static_cast<size_t>(recentPosition)] = meanSquare;
+    recentPosition = (recentPosition + 1) % SHORT_TERM_STEPS;
+    ++numSteps;
+
+    // Gating blocks are the 400 ms momentary windows, one every 100 ms (75% overlap)
+    if (numSteps >= MOMENTARY_STEPS)
+    {
+        double momentary = 0.0;
+        for (int i = 1; i <= MOMENTARY_STEPS; ++i)
+            momentary += recentSteps[static_cast<size_t>((recentPosition - i + SHORT_TERM_STEPS) % SHORT_TERM_STEPS)];
+
+        momentaryHistogram.add(momentary / MOMENTARY_STEPS);
+    }
+
+    // Loudness range uses the 3 s short-term values at the same 10 Hz rate
+    if (numSteps >= SHORT_TERM_STEPS)
+    {
+        double shortTerm = 0.0;
+        for (const auto step : recentSteps)
+            shortTerm += step;
+
+        shortTermHistogram.add(shortTerm / SHORT_TERM_STEPS);
+    }
+}
+
+float LoudnessMeter::computeLoudnessRange() const
+{
+    const auto& histogram = shortTermHistogram;
+
+    if (histogram.total == 0)
+        return 0.0f;
+
+    // EBU Tech 3342: relative gate 20 LU below the mean, then the 10th to 95th percentile
+    const float gate = energyToLufs(histogram.getMeanEnergyAbove(GatingHistogram::MIN_LUFS)) - 20.0f;
+    const int firstBin = levelToBin(gate);
+
+    juce::int64 gated = 0;
+    for (int bin = firstBin; bin < GatingHistogram::NUM_BINS; ++bin)
+        gated += histogram.counts[static_cast<size_t>(bin)];
+
+    if (gated == 0)
+        return 0.0f;
+
+    auto percentileBin = [&](double proportion) {
+        const auto target = std::max(juce::int64 { 1 }, static_cast<juce::int64>(std::ceil(proportion * static_cast<double>(gated))));
+        juce::int64 cumulative = 0;
+
+        for (int bin = firstBin; bin < GatingHistogram::NUM_BINS; ++bin)
+        {
+            cumulative += histogram.counts[static_cast<size_t>(bin)];
+            if (cumulative >= target)
+                return bin;
+        }
+
+        return GatingHistogram::NUM_BINS - 1;
+    };
+
+    return static_cast<float>(percentileBin(0.95) - percentileBin(0.10)) * GatingHistogram::BIN_WIDTH;
+}
+
+int LoudnessMeter::useTimeSlice()
+{
+    analyse();
+    return ANALYSIS_INTERVAL_MS;
+}
+
+void LoudnessMeter::analyse()
+{
+    if (resetRequested.exchange(false))
+    {
+        steps.popAll([](const StepEnergy&) {});
+        clearMeasurement();
+    }
+
+    const int numNew = steps.popAll([this](const StepEnergy& step) {
+        addStep(step.sumSquares / static_cast<double>(step.numSamples));
+    });
+
+    if (numNew == 0)
+        return;
+
+    auto windowEnergy = [this](int numWindowSteps) {
+        double sum = 0.0;
+        for (int i = 1; i <= numWindowSteps; ++i)
+            sum += recentSteps[static_cast<size_t>((recentPosition - i + SHORT_TERM_STEPS) % SHORT_TERM_STEPS)];
+        return sum / numWindowSteps;
+    };
+
+    Readings newReadings;
+    newReadings.measuredSeconds = static_cast<float>(numSteps) * 0.1f;
+
+    if (numSteps >= MOMENTARY_STEPS)
+        newReadings.momentaryLufs = energyToLufs(windowEnergy(MOMENTARY_STEPS));
+
+    if (numSteps >= SHORT_TERM_STEPS)
+        newReadings.shortTermLufs = energyToLufs(windowEnergy(SHORT_TERM_STEPS));
+
+    if (momentaryHistogram.total > 0)
+    {
+        // Relative gate 10 LU below the absolute-gated mean
+        const float gate = energyToLufs(momentaryHistogram.getMeanEnergyAbove(GatingHistogram::MIN_LUFS)) - 10.0f;
+        newReadings.integratedLufs = energyToLufs(momentaryHistogram.getMeanEnergyAbove(gate));
+    }
+
+    newReadings.loudnessRange = computeLoudnessRange();
+    readings.write(newReadings);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include "AnalysisThread.h"
+#include "SeqLock.h"
+#include "SpscFifo.h"
+#include <array>
+#include <atomic>
+
+/**
+ * ITU-R BS.1770-4 / EBU R128 Loudness Meter
+ *
+ * - Audio thread: process() runs the two K-weighting biquads with one SIMD
+ *   lane per channel and accumulates the filtered energy. Every 100 ms it
+ *   pushes one energy record into a lock-free FIFO; nothing else happens there.
+ * - Analysis thread: momentary (400 ms) and short-term (3 s) loudness from the
+ *   last 4 / 30 records, gated integrated loudness and loudness range (EBU
+ *   Tech 3342) from 0.1 LU histograms, published through a SeqLock.
+ *
+ * The histograms keep memory constant however long the measurement runs; the
+ * integrated value still sums the actual block energies, so only the position
+ * of the relative gate is quantised.
+ */
+class LoudnessMeter : private juce::TimeSliceClient
+{
+public:
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr float NO_LOUDNESS = -100.0f;   // Not measured yet / below the absolute gate
+
+    struct Readings
+    {
+        float momentaryLufs = NO_LOUDNESS;
+        float shortTermLufs = NO_LOUDNESS;
+        float integratedLufs = NO_LOUDNESS;
+        float loudnessRange = 0.0f;     // LU
+        float measuredSeconds = 0.0f;   // Since the last reset
+    };
+
+    LoudnessMeter();
+    ~LoudnessMeter() override;
+
+    // Not the audio thread: resets the filters, starts a new measurement and
+    // (unless useAnalysisThread is false) registers with the analysis thread
+    void prepare(double sampleRate, int numChannels, bool useAnalysisThread = true);
+
+    // Audio thread
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    // Runs the gating analysis on the calling thread. Only for meters prepared
+    // without the analysis thread (offline use); call it after each process()
+    // so the FIFO never fills.
+    void analyse();
+
+    // Any thread: restarts integrated loudness and loudness range
+    void resetIntegrated() { resetRequested.store(true); }
+
+    // Any thread
+    Readings getReadings() const { return readings.read(); }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<double>;
+    static_assert(Vec::SIMDNumElements >= MAX_CHANNELS, "One SIMD lane per channel");
+
+    // Filtered energy of one 100 ms step, summed over channels
+    struct StepEnergy
+    {
+        double sumSquares = 0.0;
+        int numSamples = 0;
+    };
+
+    // Level histogram from the absolute gate up, with the energy in each bin
+    struct GatingHistogram
+    {
+        static constexpr float MIN_LUFS = -70.0f;
+        static constexpr float BIN_WIDTH = 0.1f;
+        static constexpr int NUM_BINS = 800;
+
+        void clear();
+        void add(double energy);
+
+        // Mean energy of all blocks at or above the given level
+        double getMeanEnergyAbove(float lufs) const;
+
+        std::array<juce::int64, NUM_BINS> counts {};
+        std::array<double, NUM_BINS> energies {};
+        juce::int64 total = 0;
+    };
+
+    int useTimeSlice() override;
+    void clearMeasurement();
+    void addStep(double meanSquare);
+    float computeLoudnessRange() const;
+
+    static float energyToLufs(double energy);
+    static int levelToBin(float lufs);
+
+    void setSampleRate(double sampleRate);
+
+    // Audio thread state
+    struct Biquad
+    {
+        Vec b0, b1, b2, a1, a2;
+    };
+
+    Biquad preFilter;       // High shelf (head effects)
+    Biquad rlbFilter;       // RLB high pass (numerator is always 1, -2, 1)
+    Vec pre1, pre2, rlb1, rlb2;
+    Vec energy;
+    int numPrepared = 0;
+    int stepLength = 4410;
+    static constexpr int CHUNK_SIZE = 64;
+    int samplesInStep = 0;
+
+    SpscFifo<StepEnergy, 128> steps;
+
+    // Analysis thread state
+    static constexpr int MOMENTARY_STEPS = 4;
+    static constexpr int SHORT_TERM_STEPS = 30;
+
+    std::array<double, SHORT_TERM_STEPS> recentSteps {};
+    int recentPosition = 0;
+    juce::int64 numSteps = 0;
+    GatingHistogram momentaryHistogram;     // Integrated loudness
+    GatingHistogram shortTermHistogram;     // Loudness range
+
+    std::atomic<bool> resetRequested { true };
+    SeqLock<Readings> readings;
+
+    juce::SharedResourcePointer<AnalysisThread> analysisThread;
+
+    static constexpr int ANALYSIS_INTERVAL_MS = 50;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
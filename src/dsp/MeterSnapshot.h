@@ -0,0 +1,33 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+/**
+ * Consistent set of meter values from one processed block
+ *
+ * Published by OptoCompressor through a SeqLock after every block, so the
+ * editor always sees values that belong together.
+ */
+struct MeterSnapshot
+{
+    static constexpr int MAX_CHANNELS = 2;
+
+    juce::uint64 blockSequence = 0;     // Increments once per processed block (0 = none yet)
+    int numChannels = 0;                // Channels metered (at most MAX_CHANNELS)
+
+    // Per channel, linear, over the block
+    std::array<float, MAX_CHANNELS> inputPeak {};
+    std::array<float, MAX_CHANNELS> inputRms {};
+    std::array<float, MAX_CHANNELS> outputPeak {};
+    std::array<float, MAX_CHANNELS> outputRms {};
+
+    float blockGainReductionDb = 0.0f;  // Deepest gain reduction in the block (<= 0)
+    float gainReductionDb = 0.0f;       // Smoothed gain reduction for the VU meter (<= 0)
+    float outputLevelDb = -80.0f;       // Smoothed output peak for the VU meter
+
+    // BS.1770 true peak of the output, all channels
+    float truePeakDb = -100.0f;         // This block
+    float truePeakMaxDb = -100.0f;      // Held since the last reset
+    float ceilingGainDb = 0.0f;         // Deepest true-peak ceiling gain in the block (<= 0)
+};
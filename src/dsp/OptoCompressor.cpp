@@ -3,85 +3,119 @@
 
 OptoCompressor::OptoCompressor()
 {
+    // With hundreds of instances processed in turn, each one's per-sample
+    // working set should cost two cache line fills
+    static_assert(sizeof(HotState) == 64, "Per-sample state should fill exactly one cache line");
+    static_assert(sizeof(Coefficients) == 64, "Coefficients should fit one cache line");
 }
 
-void OptoCompressor::prepare(double newSampleRate, int /*samplesPerBlock*/)
+void OptoCompressor::prepare(double newSampleRate, int samplesPerBlock, int numChannels)
 {
-    sampleRate = newSampleRate;
+    coefficients.sampleRate = newSampleRate;
     updateCoefficients();
+    outputStage.prepare(coefficients.sampleRate, numChannels, samplesPerBlock);
 
-    // Meter smoothing: ~100ms time constant
-    meterSmoothingCoeff = std::exp(-1.0f / (0.1f * static_cast<float>(sampleRate)));
+    // Meter smoothing: ~100ms time constant, stepped once per sub-block
+    coefficients.meterSmoothingCoeff = std::exp(-static_cast<float>(SUB_BLOCK_SIZE) / (0.1f * static_cast<float>(coefficients.sampleRate)));
+
+    state.makeupGain.reset(coefficients.sampleRate, PARAMETER_RAMP_SECONDS);
+    state.mix.reset(coefficients.sampleRate, PARAMETER_RAMP_SECONDS);
 
     reset();
 }
 
 void OptoCompressor::reset()
 {
-    optoCellState = 1.0f;      // Unity gain (no compression)
-    fastReleaseEnv = 1.0f;     // Unity gain
-    slowReleaseEnv = 1.0f;     // Unity gain
-    adaptiveReleaseTime = MIN_SLOW_RELEASE_MS;
+    state.optoCellState = 1.0f;      // Unity gain (no compression)
+    state.fastReleaseEnv = 1.0f;     // Unity gain
+    state.slowReleaseEnv = 1.0f;     // Unity gain
+    coefficients.adaptiveReleaseTime = MIN_SLOW_RELEASE_MS;
+    state.releasing = false;
     smoothedGR = 0.0f;
     smoothedOutput = 0.0f;
+    state.subBlockGR = 0.0f;
+    subBlockOutput = 0.0f;
+    snapParameters = true;
+    samplePosition = 0;
+    updateSlowRelease();
+    outputStage.reset();
 }
 
 void OptoCompressor::updateCoefficients()
 {
     // Attack coefficient (program-dependent, but base value)
     float attackMs = BASE_ATTACK_MS;
-    attackCoeff = std::exp(-1.0f / (attackMs * 0.001f * static_cast<float>(sampleRate)));
+    coefficients.attackCoeff = std::exp(-1.0f / (attackMs * 0.001f * static_cast<float>(coefficients.sampleRate)));
 
     // Fast release: fixed 60ms
-    fastReleaseCoeff = std::exp(-1.0f / (FAST_RELEASE_MS * 0.001f * static_cast<float>(sampleRate)));
+    coefficients.fastReleaseCoeff = std::exp(-1.0f / (FAST_RELEASE_MS * 0.001f * static_cast<float>(coefficients.sampleRate)));
+
+    // Sustained compression attacks twice as fast
+    coefficients.sustainedAttackCoeff = std::exp(-1.0f / (BASE_ATTACK_MS * 0.5f * 0.001f * static_cast<float>(coefficients.sampleRate)));
 
     // Slow release: adaptive, start at minimum
-    float slowMs = adaptiveReleaseTime;
-    slowReleaseCoeff = std::exp(-1.0f / (slowMs * 0.001f * static_cast<float>(sampleRate)));
+    float slowMs = coefficients.adaptiveReleaseTime;
+    coefficients.slowReleaseCoeff = std::exp(-1.0f / (slowMs * 0.001f * static_cast<float>(coefficients.sampleRate)));
+}
+
+void OptoCompressor::updateSlowRelease()
+{
+    // Adaptive slow release time based on how much compression occurred
+    float compressionDepth = 1.0f - state.optoCellState;
+    coefficients.adaptiveReleaseTime = MIN_SLOW_RELEASE_MS +
+        compressionDepth * (MAX_SLOW_RELEASE_MS - MIN_SLOW_RELEASE_MS);
+
+    coefficients.slowReleaseCoeff = std::exp(-1.0f / (coefficients.adaptiveReleaseTime * 0.001f * static_cast<float>(coefficients.sampleRate)));
 }
 
 void OptoCompressor::setPeakReduction(float value)
 {
-    peakReduction = juce::jlimit(0.0f, 100.0f, value);
+    pending.peakReduction = juce::jlimit(0.0f, 100.0f, value);
 }
 
 void OptoCompressor::setGain(float dB)
 {
-    makeupGain = juce::Decibels::decibelsToGain(juce::jlimit(-10.0f, 40.0f, dB));
+    pending.makeupGain = juce::Decibels::decibelsToGain(juce::jlimit(-10.0f, 40.0f, dB));
 }
 
 void OptoCompressor::setLimitMode(bool limit)
 {
-    limitMode = limit;
+    pending.limitMode = limit;
 }
 
 void OptoCompressor::setBritishMode(bool british)
 {
-    britishMode = british;
+    pending.britishMode = british;
 }
 
 void OptoCompressor::setMix(float percent)
 {
-    mix = juce::jlimit(0.0f, 100.0f, percent) / 100.0f;
+    pending.mix = juce::jlimit(0.0f, 100.0f, percent) / 100.0f;
 }
 
-float OptoCompressor::computeGain(float inputLevelDb)
+void OptoCompressor::setTruePeakCeiling(bool enabled, float ceilingDb)
 {
-    if (peakReduction <= 0.0f)
-        return 1.0f;
+    pending.ceilingEnabled = enabled;
+    pending.ceilingDb = juce::jlimit(-20.0f, 0.0f, ceilingDb);
+}
+
+float OptoCompressor::getRatio(bool limit, bool british)
+{
+    if (british)
+        return BRITISH_RATIO;  // Aggressive 1176-style
+    if (limit)
+        return LIMIT_RATIO;
+    return COMPRESS_RATIO;
+}
+
+float OptoCompressor::computeGainReductionDb(float inputLevelDb, float reduction, float ratio)
+{
+    if (reduction <= 0.0f)
+        return 0.0f;
 
     // Threshold derived from peak reduction
     // Higher peak reduction = lower threshold = more compression
-    float threshold = 0.0f - (peakReduction * 0.4f); // -40dB at max
-
-    // Ratio based on mode
-    float ratio;
-    if (britishMode)
-        ratio = BRITISH_RATIO;  // Aggressive 1176-style
-    else if (limitMode)
-        ratio = LIMIT_RATIO;
-    else
-        ratio = COMPRESS_RATIO;
+    float threshold = 0.0f - (reduction * 0.4f); // -40dB at max
 
     // Soft knee computation
     float kneeStart = threshold - KNEE_WIDTH_DB / 2.0f;
@@ -102,13 +136,21 @@ float OptoCompressor::computeGain(float inputLevelDb)
     }
     else
     {
-        // In knee - gradual compression
-        float kneePosition = (inputLevelDb - kneeStart) / KNEE_WIDTH_DB;
-        float kneeGain = kneePosition * kneePosition;
-        float excess = inputLevelDb - threshold;
-        gainReductionDb = kneeGain * excess * (1.0f - 1.0f / ratio);
+        // In knee - gradual compression. Quadratic from zero at the knee
+        // start, meeting the full-ratio line with the same slope at the knee end
+        float intoKnee = inputLevelDb - kneeStart;
+        gainReductionDb = (1.0f - 1.0f / ratio) * intoKnee * intoKnee / (2.0f * KNEE_WIDTH_DB);
     }
 
+    return gainReductionDb;
+}
+
+float OptoCompressor::computeGain(float inputLevelDb)
+{
+    if (state.peakReduction <= 0.0f)
+        return 1.0f;
+
+    const float gainReductionDb = computeGainReductionDb(inputLevelDb, state.peakReduction, getRatio(state.limitMode, state.britishMode));
     return juce::Decibels::decibelsToGain(-gainReductionDb);
 }
 
@@ -118,62 +160,116 @@ float OptoCompressor::processOpticalCell(float targetGain)
     // Attack is faster when signal is sustained (program-dependent)
     // Release has two stages: fast initial, slow tail
 
-    float currentGainDb = juce::Decibels::gainToDecibels(optoCellState + 0.0001f);
-    float targetGainDb = juce::Decibels::gainToDecibels(targetGain + 0.0001f);
-
-    if (targetGain < optoCellState)
+    if (targetGain < state.optoCellState)
     {
         // Attacking (gain reduction increasing)
         // Program-dependent: faster attack for sustained signals
-        float attackSpeed = attackCoeff;
+        float attackSpeed = coefficients.attackCoeff;
 
         // Adapt attack based on how long we've been compressing
-        if (slowReleaseEnv > 0.5f)
+        if (state.slowReleaseEnv > 0.5f)
         {
             // Sustained compression - speed up attack
-            attackSpeed = std::exp(-1.0f / (BASE_ATTACK_MS * 0.5f * 0.001f * static_cast<float>(sampleRate)));
+            attackSpeed = coefficients.sustainedAttackCoeff;
         }
 
-        optoCellState = attackSpeed * optoCellState + (1.0f - attackSpeed) * targetGain;
+        state.optoCellState = attackSpeed * state.optoCellState + (1.0f - attackSpeed) * targetGain;
+        state.releasing = false;
     }
     else
     {
         // Releasing (gain reduction decreasing)
         // Two-stage release: fast initial + slow tail
 
-        // Fast release envelope
-        fastReleaseEnv = fastReleaseCoeff * fastReleaseEnv + (1.0f - fastReleaseCoeff) * targetGain;
+        // Both stages start from where the cell is, not from wherever they
+        // were left at the end of the previous release
+        if (! state.releasing)
+        {
+            state.fastReleaseEnv = state.optoCellState;
+            state.slowReleaseEnv = state.optoCellState;
+            state.releasing = true;
+        }
 
-        // Adaptive slow release time based on how much compression occurred
-        float compressionDepth = 1.0f - optoCellState;
-        adaptiveReleaseTime = MIN_SLOW_RELEASE_MS +
-            compressionDepth * (MAX_SLOW_RELEASE_MS - MIN_SLOW_RELEASE_MS);
+        // Fast release envelope
+        state.fastReleaseEnv = coefficients.fastReleaseCoeff * state.fastReleaseEnv + (1.0f - coefficients.fastReleaseCoeff) * targetGain;
 
-        // Update slow release coefficient
-        slowReleaseCoeff = std::exp(-1.0f / (adaptiveReleaseTime * 0.001f * static_cast<float>(sampleRate)));
+        // Adaptive slow release: every sample offline, once per sub-block in
+        // realtime (it follows the slow envelope, and std::exp is the most
+        // expensive thing in this loop)
+        if (state.highQuality)
+            updateSlowRelease();
 
         // Slow release envelope
-        slowReleaseEnv = slowReleaseCoeff * slowReleaseEnv + (1.0f - slowReleaseCoeff) * targetGain;
+        state.slowReleaseEnv = coefficients.slowReleaseCoeff * state.slowReleaseEnv + (1.0f - coefficients.slowReleaseCoeff) * targetGain;
 
         // Combine: 40% fast, 60% slow (LA-2A characteristic)
-        optoCellState = 0.4f * fastReleaseEnv + 0.6f * slowReleaseEnv;
+        state.optoCellState = 0.4f * state.fastReleaseEnv + 0.6f * state.slowReleaseEnv;
     }
 
-    return optoCellState;
+    return state.optoCellState;
 }
 
-void OptoCompressor::processBlock(juce::AudioBuffer<float>& buffer)
+void OptoCompressor::beginSubBlock()
 {
-    const int numChannels = buffer.getNumChannels();
-    const int numSamples = buffer.getNumSamples();
+    state.peakReduction = pending.peakReduction;
+    state.limitMode = pending.limitMode;
+    state.britishMode = pending.britishMode;
+    state.makeupGain.setTargetValue(pending.makeupGain);
+    state.mix.setTargetValue(pending.mix);
+    outputStage.setCeiling(pending.ceilingEnabled, pending.ceilingDb);
+
+    if (snapParameters)
+    {
+        state.makeupGain.setCurrentAndTargetValue(pending.makeupGain);
+        state.mix.setCurrentAndTargetValue(pending.mix);
+        snapParameters = false;
+    }
 
-    if (numChannels == 0 || numSamples == 0)
-        return;
+    if (! state.highQuality)
+        updateSlowRelease();
+}
 
-    float maxGR = 0.0f;
-    float maxOutput = 0.0f;
+void OptoCompressor::endSubBlock()
+{
+    smoothedGR = coefficients.meterSmoothingCoeff * smoothedGR + (1.0f - coefficients.meterSmoothingCoeff) * state.subBlockGR;
+    smoothedOutput = coefficients.meterSmoothingCoeff * smoothedOutput + (1.0f - coefficients.meterSmoothingCoeff) * subBlockOutput;
+    state.subBlockGR = 0.0f;
+    subBlockOutput = 0.0f;
+
+    // Decaying tails (meters in silence, the cell under extreme reduction)
+    // stop at zero instead of going denormal, whatever the FTZ mode
+    smoothedGR = SampleSanitizer::flushToZero(smoothedGR);
+    smoothedOutput = SampleSanitizer::flushToZero(smoothedOutput);
+    state.optoCellState = SampleSanitizer::flushToZero(state.optoCellState);
+    state.fastReleaseEnv = SampleSanitizer::flushToZero(state.fastReleaseEnv);
+    state.slowReleaseEnv = SampleSanitizer::flushToZero(state.slowReleaseEnv);
+}
+
+bool OptoCompressor::isStateFinite() const
+{
+    return std::isfinite(state.optoCellState) && std::isfinite(state.fastReleaseEnv)
+        && std::isfinite(state.slowReleaseEnv) && std::isfinite(smoothedGR) && std::isfinite(smoothedOutput);
+}
+
+void OptoCompressor::recoverState(juce::AudioBuffer<float>& buffer, BlockLevels& levels)
+{
+    // Back to rest on the same grid position; the block is muted rather than
+    // passing on NaN/Inf, and its levels are dropped
+    const auto position = samplePosition;
+    reset();
+    samplePosition = position;
+
+    buffer.clear();
+    levels = BlockLevels();
+    levels.leastGR = 0.0f;
+}
+
+void OptoCompressor::processSamples(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, BlockLevels& levels)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numMetered = juce::jmin(numChannels, MeterSnapshot::MAX_CHANNELS);
 
-    for (int sample = 0; sample < numSamples; ++sample)
+    for (int sample = startSample; sample < startSample + numSamples; ++sample)
     {
         // Get input level (sum channels for stereo linking)
         float inputLevel = 0.0f;
@@ -181,7 +277,16 @@ void OptoCompressor::processBlock(juce::AudioBuffer<float>& buffer)
         {
             float s = buffer.getSample(ch, sample);
             inputLevel += s * s;
+            levels.maxInput = juce::jmax(levels.maxInput, std::abs(s));
+
+            if (ch < numMetered)
+            {
+                const auto index = static_cast<size_t>(ch);
+                levels.inputPeak[index] = juce::jmax(levels.inputPeak[index], std::abs(s));
+                levels.inputChannelSumSquares[index] += s * s;
+            }
         }
+        levels.inputSumSquares += inputLevel;
         inputLevel = std::sqrt(inputLevel / static_cast<float>(numChannels));
 
         // Convert to dB
@@ -198,30 +303,124 @@ void OptoCompressor::processBlock(juce::AudioBuffer<float>& buffer)
 
         // Track gain reduction for metering
         float grDb = juce::Decibels::gainToDecibels(gain);
-        if (grDb < maxGR)
-            maxGR = grDb;
+        levels.maxGR = juce::jmin(levels.maxGR, grDb);
+        levels.leastGR = juce::jmax(levels.leastGR, grDb);
+        state.subBlockGR = juce::jmin(state.subBlockGR, grDb);
 
         // Apply gain to all channels
+        const float sampleMakeup = state.makeupGain.getNextValue();
+        const float sampleMix = state.mix.getNextValue();
+
         for (int ch = 0; ch < numChannels; ++ch)
         {
             float dry = buffer.getSample(ch, sample);
-            float wet = dry * gain * makeupGain;
+            float wet = dry * gain * sampleMakeup;
 
             // Mix dry/wet
-            float output = dry * (1.0f - mix) + wet * mix;
+            float output = dry * (1.0f - sampleMix) + wet * sampleMix;
             buffer.setSample(ch, sample, output);
-
-            // Track output level
-            float outAbs = std::abs(output);
-            if (outAbs > maxOutput)
-                maxOutput = outAbs;
         }
     }
 
-    // Update meters with smoothing
-    smoothedGR = meterSmoothingCoeff * smoothedGR + (1.0f - meterSmoothingCoeff) * maxGR;
-    smoothedOutput = meterSmoothingCoeff * smoothedOutput + (1.0f - meterSmoothingCoeff) * maxOutput;
+    // Lookahead delay and true-peak ceiling; output levels are measured there
+    juce::AudioBuffer<float> section(buffer.getArrayOfWritePointers(), numChannels, startSample, numSamples);
+    outputStage.process(section);
+    const auto& output = outputStage.getLastStats();
+
+    for (size_t ch = 0; ch < static_cast<size_t>(numMetered); ++ch)
+    {
+        levels.output.peak[ch] = juce::jmax(levels.output.peak[ch], output.peak[ch]);
+        levels.output.sumSquares[ch] += output.sumSquares[ch];
+        subBlockOutput = juce::jmax(subBlockOutput, output.peak[ch]);
+    }
+
+    levels.output.truePeak = juce::jmax(levels.output.truePeak, output.truePeak);
+    levels.output.minGain = juce::jmin(levels.output.minGain, output.minGain);
+}
+
+void OptoCompressor::processBlock(juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    // Pick up a held true-peak value set or reset from another thread. Only
+    // written when there is a request, so the line isn't dirtied every block.
+    if (! juce::exactlyEqual(requestedTruePeakMaxDb.load(std::memory_order_relaxed), NO_REQUEST))
+    {
+        const float requestedMax = requestedTruePeakMaxDb.exchange(NO_REQUEST);
+        if (! juce::exactlyEqual(requestedMax, NO_REQUEST))
+            truePeakMaxDb = requestedMax;
+    }
+
+    // Per-channel levels for the meter snapshot (channels past MAX_CHANNELS are not metered)
+    const int numMetered = juce::jmin(numChannels, MeterSnapshot::MAX_CHANNELS);
+    BlockLevels levels;
+
+    for (int start = 0; start < numSamples;)
+    {
+        const int offset = static_cast<int>(samplePosition % SUB_BLOCK_SIZE);
+        const int num = juce::jmin(SUB_BLOCK_SIZE - offset, numSamples - start);
+
+        if (offset == 0)
+            beginSubBlock();
+
+        processSamples(buffer, start, num, levels);
+        samplePosition += num;
+        start += num;
+
+        if (offset + num == SUB_BLOCK_SIZE)
+            endSubBlock();
+    }
+
+    // One vectorized pass over the output; the output stage's filters see
+    // anything that went wrong upstream
+    const bool stateRecovered = ! isStateFinite() || SampleSanitizer::containsNonFinite(buffer);
+    if (stateRecovered)
+        recoverState(buffer, levels);
+
+    const auto& output = levels.output;
+    float maxOutput = 0.0f;
+    float outputSumSquares = 0.0f;
+
+    for (size_t ch = 0; ch < static_cast<size_t>(numMetered); ++ch)
+    {
+        maxOutput = juce::jmax(maxOutput, output.peak[ch]);
+        outputSumSquares += output.sumSquares[ch];
+    }
+
+    const float truePeakDb = juce::Decibels::gainToDecibels(output.truePeak, NO_TRUE_PEAK_DB);
+    truePeakMaxDb = juce::jmax(truePeakMaxDb, truePeakDb);
+
+    lastBlockStats.inputPeak = levels.maxInput;
+    lastBlockStats.inputRms = std::sqrt(levels.inputSumSquares / static_cast<float>(numSamples * numChannels));
+    lastBlockStats.outputPeak = maxOutput;
+    lastBlockStats.outputRms = std::sqrt(outputSumSquares / static_cast<float>(numSamples * numMetered));
+    lastBlockStats.minGainDb = levels.maxGR;
+    lastBlockStats.maxGainDb = juce::jmin(levels.leastGR, 0.0f);
+    lastBlockStats.numSamples = numSamples;
+    lastBlockStats.stateRecovered = stateRecovered;
+
+    // Publish everything the editor meters in one consistent snapshot
+    MeterSnapshot snapshot;
+    snapshot.blockSequence = ++blockSequence;
+    snapshot.numChannels = numMetered;
+
+    for (size_t ch = 0; ch < static_cast<size_t>(numMetered); ++ch)
+    {
+        snapshot.inputPeak[ch] = levels.inputPeak[ch];
+        snapshot.inputRms[ch] = std::sqrt(levels.inputChannelSumSquares[ch] / static_cast<float>(numSamples));
+        snapshot.outputPeak[ch] = output.peak[ch];
+        snapshot.outputRms[ch] = std::sqrt(output.sumSquares[ch] / static_cast<float>(numSamples));
+    }
 
-    currentGainReductionDb.store(smoothedGR);
-    currentOutputLevel.store(juce::Decibels::gainToDecibels(smoothedOutput + 0.0001f));
+    snapshot.blockGainReductionDb = levels.maxGR;
+    snapshot.gainReductionDb = smoothedGR;
+    snapshot.outputLevelDb = juce::Decibels::gainToDecibels(smoothedOutput + 0.0001f);
+    snapshot.truePeakDb = truePeakDb;
+    snapshot.truePeakMaxDb = truePeakMaxDb;
+    snapshot.ceilingGainDb = juce::Decibels::gainToDecibels(output.minGain, NO_TRUE_PEAK_DB);
+    meterSnapshot.write(snapshot);
 }
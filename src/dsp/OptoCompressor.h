@@ -1,6 +1,11 @@
 #pragma once
 
 #include <juce_audio_basics/juce_audio_basics.h>
+#include "MeterSnapshot.h"
+#include "SampleSanitizer.h"
+#include "SeqLock.h"
+#include "TruePeakLimiter.h"
+#include <array>
 #include <atomic>
 
 /**
@@ -11,6 +16,17 @@
  * - Two-stage release (fast 60ms + slow 1-15s adaptive)
  * - Soft knee compression curve
  * - Limit mode (high ratio) vs Compress mode (3:1)
+ * - Optional true-peak ceiling after makeup gain (see TruePeakLimiter)
+ *
+ * Blocks are processed in sub-blocks on a fixed 64-sample grid of absolute
+ * sample positions. Parameter changes take effect, and per-sub-block work
+ * (meter smoothing, the realtime slow-release update) happens, only at grid
+ * points, so the output doesn't depend on how the host splits the stream.
+ *
+ * If the envelopes or the output go non-finite (NaN/Inf input, or finite
+ * input large enough to overflow), the block is muted and the state reset, so
+ * one bad buffer costs one block instead of the channel. Envelope tails are
+ * flushed to zero at sub-block boundaries.
  */
 class OptoCompressor
 {
@@ -18,9 +34,13 @@ public:
     OptoCompressor();
     ~OptoCompressor() = default;
 
-    void prepare(double sampleRate, int samplesPerBlock);
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels);
     void reset();
 
+    // Clears the lookahead delay and ceiling state but keeps the opto envelope,
+    // for resuming after the compressor has been paused (A/B slots)
+    void resetOutputStage() { outputStage.reset(); }
+
     void processBlock(juce::AudioBuffer<float>& buffer);
 
     // Parameters
@@ -29,43 +49,147 @@ public:
     void setLimitMode(bool limit);         // true = limit, false = compress
     void setBritishMode(bool british);     // 1176-style all-buttons-in
     void setMix(float percent);            // 0-100
+    void setTruePeakCeiling(bool enabled, float ceilingDb);
+
+    // Offline rendering: update the adaptive release every sample instead of
+    // once per sub-block
+    void setHighQuality(bool shouldUseHighQuality) { state.highQuality = shouldUseHighQuality; }
+
+    // Aligns the sub-block grid when resuming a paused compressor (A/B slots)
+    void setSamplePosition(juce::int64 position) { samplePosition = position; }
+
+    // Fixed delay of the output stage, the same whether or not the ceiling is on
+    int getLatencySamples() const { return outputStage.getLatencySamples(); }
+
+    // Held true-peak maximum. Set/reset may be called from any thread and are
+    // applied at the start of the next block.
+    void resetTruePeakMax() { requestedTruePeakMaxDb.store(NO_TRUE_PEAK_DB); }
+    void setTruePeakMax(float dB) { requestedTruePeakMaxDb.store(juce::jmax(dB, NO_TRUE_PEAK_DB)); }
+
+    // Metering (thread-safe): all values from the most recent block
+    MeterSnapshot getMeterSnapshot() const { return meterSnapshot.read(); }
+
+    // Unsmoothed statistics of the last processed block (audio thread only)
+    struct BlockStats
+    {
+        float inputPeak = 0.0f;
+        float inputRms = 0.0f;
+        float outputPeak = 0.0f;
+        float outputRms = 0.0f;
+        float minGainDb = 0.0f;    // Deepest gain reduction in the block
+        float maxGainDb = 0.0f;    // Shallowest gain reduction in the block
+        int numSamples = 0;
+        bool stateRecovered = false;    // Went non-finite; the block was muted and the state reset
+    };
+
+    const BlockStats& getLastBlockStats() const { return lastBlockStats; }
 
-    // Metering (thread-safe)
-    float getGainReductionDb() const { return currentGainReductionDb.load(); }
-    float getOutputLevel() const { return currentOutputLevel.load(); }
+    // Static transfer curve (no attack/release): gain reduction in dB (>= 0)
+    // for a detector level. Pure functions, safe to call from any thread.
+    static float computeGainReductionDb(float inputLevelDb, float peakReduction, float ratio);
+    static float getRatio(bool limitMode, bool britishMode);
+
+    // Bytes of the detector and opto cell touched every sample (per-sample
+    // state and coefficients), for footprint reports. The output stage's delay
+    // lines and true-peak detectors are touched every sample too but not
+    // counted here: their size depends on the lookahead and channel count.
+    static constexpr size_t getHotWorkingSetBytes() { return sizeof(HotState) + sizeof(Coefficients); }
 
 private:
-    double sampleRate = 44100.0;
+    // Per-sample state, in one cache line: the opto cell and its release
+    // envelopes, the parameters in effect and the gain/mix ramps. Gain and mix
+    // act on the signal directly, so they are ramped (peak reduction and mode
+    // already reach the signal through the opto cell).
+    struct alignas(64) HotState
+    {
+        float optoCellState = 1.0f;      // Start at unity gain
+        float fastReleaseEnv = 1.0f;     // Start at unity gain
+        float slowReleaseEnv = 1.0f;     // Start at unity gain
+        float subBlockGR = 0.0f;         // Deepest GR so far in the current sub-block
+        float peakReduction = 0.0f;
+        bool releasing = false;          // Release stages are running (seeded from the cell)
+        bool limitMode = false;
+        bool britishMode = false;
+        bool highQuality = false;
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> makeupGain { 1.0f };
+        juce::SmoothedValue<float> mix { 1.0f };
+    };
 
-    // Opto-cell state variables (per channel for stereo linking)
-    float optoCellState = 1.0f;      // Start at unity gain
-    float fastReleaseEnv = 1.0f;     // Start at unity gain
-    float slowReleaseEnv = 1.0f;     // Start at unity gain
+    // Read every sample; written by prepare() and, for the adaptive slow
+    // release, once per sub-block
+    struct alignas(64) Coefficients
+    {
+        float attackCoeff = 0.0f;
+        float sustainedAttackCoeff = 0.0f;
+        float fastReleaseCoeff = 0.0f;
+        float slowReleaseCoeff = 0.0f;
+        float adaptiveReleaseTime = 1.0f;
+        float meterSmoothingCoeff = 0.0f;
+        double sampleRate = 44100.0;
+    };
 
-    // Adaptive timing state
-    float attackCoeff = 0.0f;
-    float fastReleaseCoeff = 0.0f;
-    float slowReleaseCoeff = 0.0f;
-    float adaptiveReleaseTime = 1.0f;
+    HotState state;
+    Coefficients coefficients;
 
-    // Parameters
-    float peakReduction = 0.0f;
-    float makeupGain = 1.0f;
-    bool limitMode = false;
-    bool britishMode = false;
-    float mix = 1.0f;
-
-    // Metering
-    std::atomic<float> currentGainReductionDb{0.0f};
-    std::atomic<float> currentOutputLevel{0.0f};
-    float meterSmoothingCoeff = 0.0f;
+    // Everything below is touched at most once per sub-block or block, or by
+    // other threads, and stays off the two lines above
+
+    // Parameters as last set; latched at the next sub-block boundary
+    struct Settings
+    {
+        float peakReduction = 0.0f;
+        float makeupGain = 1.0f;
+        bool limitMode = false;
+        bool britishMode = false;
+        float mix = 1.0f;
+        bool ceilingEnabled = false;
+        float ceilingDb = -1.0f;
+    };
+
+    Settings pending;
+
+    // The first block after reset() starts at the set values instead of ramping
+    bool snapParameters = true;
+
+    // Sub-block grid
+    static constexpr int SUB_BLOCK_SIZE = 64;
+    juce::int64 samplePosition = 0;
+
+    // Output stage (lookahead true-peak ceiling, output metering)
+    TruePeakLimiter outputStage;
+
+    // Metering (smoothed once per grid sub-block)
     float smoothedGR = 0.0f;
     float smoothedOutput = 0.0f;
+    float subBlockOutput = 0.0f;        // Output peak so far in the current sub-block
+    juce::uint64 blockSequence = 0;
+    float truePeakMaxDb = NO_TRUE_PEAK_DB;
+    std::atomic<float> requestedTruePeakMaxDb { NO_REQUEST };
+    BlockStats lastBlockStats;
+    SeqLock<MeterSnapshot> meterSnapshot;   // Own cache lines, away from the state above
+
+    // Accumulated over one host block for the block stats and meter snapshot
+    struct BlockLevels
+    {
+        float maxGR = 0.0f;
+        float leastGR = -1000.0f;
+        float maxInput = 0.0f;
+        float inputSumSquares = 0.0f;
+        std::array<float, MeterSnapshot::MAX_CHANNELS> inputPeak {};
+        std::array<float, MeterSnapshot::MAX_CHANNELS> inputChannelSumSquares {};
+        TruePeakLimiter::OutputStats output;
+    };
 
     // Internal methods
     float computeGain(float inputLevel);
     float processOpticalCell(float targetGain);
     void updateCoefficients();
+    void updateSlowRelease();
+    void beginSubBlock();
+    void endSubBlock();
+    void processSamples(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, BlockLevels& levels);
+    bool isStateFinite() const;
+    void recoverState(juce::AudioBuffer<float>& buffer, BlockLevels& levels);
 
     // Constants
     static constexpr float BASE_ATTACK_MS = 10.0f;
@@ -76,4 +200,7 @@ private:
     static constexpr float LIMIT_RATIO = 100.0f;
     static constexpr float BRITISH_RATIO = 20.0f;  // 1176 all-buttons-in style
     static constexpr float KNEE_WIDTH_DB = 6.0f;
+    static constexpr double PARAMETER_RAMP_SECONDS = 0.02;
+    static constexpr float NO_TRUE_PEAK_DB = -100.0f;
+    static constexpr float NO_REQUEST = 1000.0f;
 };
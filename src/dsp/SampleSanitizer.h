@@ -0,0 +1,82 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+#include <cstring>
+
+/**
+ * NaN/Inf Detection and Denormal Flushing
+ *
+ * A single NaN reaching a recursive filter or envelope stays there for good.
+ * containsNonFinite() is the per-block test: NaN and Inf are the only floats
+ * whose exponent bits are all set, and adding one to the exponent field
+ * carries into the sign bit for exactly those, so the test is an integer
+ * AND/ADD/OR reduction with no branches, which the compiler vectorizes. On
+ * clean input it costs about one load per sample. Only a block that fails it
+ * is scanned again to zero the bad samples.
+ *
+ * flushToZero() snaps decaying envelope tails to zero in code, so they never
+ * reach the denormal range whatever the host's (or the CPU's) FTZ/DAZ state.
+ */
+class SampleSanitizer
+{
+public:
+    // Envelope values below this are inaudible and are set to exactly zero
+    static constexpr float FLUSH_THRESHOLD = 1.0e-15f;
+
+    static bool containsNonFinite(const float* samples, int numSamples) noexcept
+    {
+        juce::uint32 carries = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            juce::uint32 bits;
+            std::memcpy(&bits, samples + i, sizeof(bits));
+            carries |= (bits & EXPONENT_MASK) + EXPONENT_LSB;
+        }
+
+        return (carries & SIGN_BIT) != 0;
+    }
+
+    static bool containsNonFinite(const juce::AudioBuffer<float>& buffer) noexcept
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            if (containsNonFinite(buffer.getReadPointer(ch), buffer.getNumSamples()))
+                return true;
+
+        return false;
+    }
+
+    // Replaces every NaN/Inf sample with silence. Returns true if there were any.
+    static bool sanitize(juce::AudioBuffer<float>& buffer) noexcept
+    {
+        bool found = false;
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            if (! containsNonFinite(buffer.getReadPointer(ch), buffer.getNumSamples()))
+                continue;
+
+            auto* samples = buffer.getWritePointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                if (! std::isfinite(samples[i]))
+                    samples[i] = 0.0f;
+
+            found = true;
+        }
+
+        return found;
+    }
+
+    static float flushToZero(float value) noexcept
+    {
+        return std::abs(value) < FLUSH_THRESHOLD ? 0.0f : value;
+    }
+
+private:
+    static constexpr juce::uint32 EXPONENT_MASK = 0x7f800000u;
+    static constexpr juce::uint32 EXPONENT_LSB = 0x00800000u;
+    static constexpr juce::uint32 SIGN_BIT = 0x80000000u;
+
+    SampleSanitizer() = delete;
+};
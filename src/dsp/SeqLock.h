@@ -0,0 +1,79 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+/**
+ * Single-writer sequence lock around a trivially-copyable value
+ *
+ * The writer never waits: it bumps the sequence to odd, stores the value and
+ * bumps it back to even. Readers copy the value and retry if the sequence was
+ * odd or changed meanwhile, so every read returns one complete write.
+ *
+ * The value is held as relaxed atomic words (no formal data race), and the
+ * whole object is aligned to and padded out to whole cache lines, so reader
+ * traffic never shares a line with the writer's other hot state.
+ */
+template <typename Value>
+class alignas(64) SeqLock
+{
+public:
+    SeqLock() { write(Value{}); }
+
+    // Writer side (one thread only)
+    void write(const Value& value)
+    {
+        std::array<juce::uint32, NUM_WORDS> buffer {};
+        std::memcpy(buffer.data(), &value, sizeof(Value));
+
+        const auto start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+            words[i].store(buffer[i], std::memory_order_relaxed);
+
+        sequence.store(start + 2, std::memory_order_release);
+    }
+
+    // Reader side (any number of threads)
+    Value read() const
+    {
+        std::array<juce::uint32, NUM_WORDS> buffer {};
+
+        for (;;)
+        {
+            const auto before = sequence.load(std::memory_order_acquire);
+
+            if ((before & 1u) == 0)
+            {
+                for (size_t i = 0; i < NUM_WORDS; ++i)
+                    buffer[i] = words[i].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (sequence.load(std::memory_order_relaxed) == before)
+                    break;
+            }
+
+            std::this_thread::yield();
+        }
+
+        Value value;
+        std::memcpy(static_cast<void*>(&value), buffer.data(), sizeof(Value));
+        return value;
+    }
+
+private:
+    static_assert(std::is_trivially_copyable_v<Value>, "SeqLock values are copied bytewise");
+
+    static constexpr size_t NUM_WORDS = (sizeof(Value) + sizeof(juce::uint32) - 1) / sizeof(juce::uint32);
+
+    std::atomic<juce::uint32> sequence { 0 };
+    std::array<std::atomic<juce::uint32>, NUM_WORDS> words {};
+
+    JUCE_DECLARE_NON_COPYABLE(SeqLock)
+};
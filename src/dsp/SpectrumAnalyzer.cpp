@@ -0,0 +1,183 @@
+#include "SpectrumAnalyzer.h"
+#include <cmath>
+
+SpectrumAnalyzer::SpectrumAnalyzer()
+{
+    smoothedInputDb.fill(MIN_DB);
+    smoothedOutputDb.fill(MIN_DB);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    setActive(false);
+}
+
+void SpectrumAnalyzer::prepare(double sampleRate)
+{
+    // The analysis thread picks this up and rebuilds its bin table
+    currentSampleRate.store(sampleRate);
+}
+
+void SpectrumAnalyzer::setActive(bool shouldBeActive)
+{
+    if (shouldBeActive == isActive())
+        return;
+
+    if (shouldBeActive)
+    {
+        if (analysis == nullptr)
+        {
+            analysis = std::make_unique<Analysis>();
+        }
+        else
+        {
+            // Not registered with the thread yet, so this thread is the only reader:
+            // drop anything left over from the last time the analyzer was shown
+            analysis->inputRing.fifo.finishedRead(analysis->inputRing.fifo.getNumReady());
+            analysis->outputRing.fifo.finishedRead(analysis->outputRing.fifo.getNumReady());
+            analysis->inputWindow.fill(0.0f);
+            analysis->outputWindow.fill(0.0f);
+        }
+
+        smoothedInputDb.fill(MIN_DB);
+        smoothedOutputDb.fill(MIN_DB);
+
+        active.store(true, std::memory_order_release);
+        analysisThread->addClient(this);
+    }
+    else
+    {
+        active.store(false);
+        analysisThread->removeClient(this);
+    }
+}
+
+float SpectrumAnalyzer::getFrequencyForPoint(int point)
+{
+    const float position = static_cast<float>(point) / static_cast<float>(NUM_DISPLAY_POINTS - 1);
+    return MIN_FREQUENCY * std::pow(MAX_FREQUENCY / MIN_FREQUENCY, position);
+}
+
+void SpectrumAnalyzer::pushTo(SampleRing Analysis::* member, const juce::AudioBuffer<float>& buffer)
+{
+    // Acquire: once active has been seen, the analysis state is too
+    if (! active.load(std::memory_order_acquire))
+        return;
+
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0)
+        return;
+
+    // Writes what fits; if the analysis thread has fallen behind the rest is dropped
+    auto& ring = (*analysis).*member;
+    const auto scope = ring.fifo.write(buffer.getNumSamples());
+    const float channelScale = 1.0f / static_cast<float>(numChannels);
+
+    auto writeMono = [&](int destStart, int sourceStart, int num) {
+        auto* dest = ring.samples.data() + destStart;
+        juce::FloatVectorOperations::copyWithMultiply(dest, buffer.getReadPointer(0, sourceStart), channelScale, num);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::addWithMultiply(dest, buffer.getReadPointer(ch, sourceStart), channelScale, num);
+    };
+
+    if (scope.blockSize1 > 0)
+        writeMono(scope.startIndex1, 0, scope.blockSize1);
+
+    if (scope.blockSize2 > 0)
+        writeMono(scope.startIndex2, scope.blockSize1, scope.blockSize2);
+}
+
+bool SpectrumAnalyzer::readHops(SampleRing& ring, std::array<float, FFT_SIZE>& window)
+{
+    bool readAny = false;
+
+    while (ring.fifo.getNumReady() >= HOP_SIZE)
+    {
+        // Slide the window along by one hop and append the new samples
+        std::copy(window.begin() + HOP_SIZE, window.end(), window.begin());
+
+        const auto scope = ring.fifo.read(HOP_SIZE);
+        auto* dest = window.data() + (FFT_SIZE - HOP_SIZE);
+        std::copy_n(ring.samples.data() + scope.startIndex1, scope.blockSize1, dest);
+        std::copy_n(ring.samples.data() + scope.startIndex2, scope.blockSize2, dest + scope.blockSize1);
+
+        readAny = true;
+    }
+
+    return readAny;
+}
+
+void SpectrumAnalyzer::updateBinRanges(double sampleRate)
+{
+    auto& binRanges = analysis->binRanges;
+    analysis->binRangeSampleRate = sampleRate;
+    const double binWidth = sampleRate / FFT_SIZE;
+    const int maxBin = FFT_SIZE / 2 - 1;
+
+    // Each display point covers the bins between it and its upper neighbour,
+    // so low points interpolate a single bin and high points take a bin maximum
+    for (int point = 0; point < NUM_DISPLAY_POINTS; ++point)
+    {
+        const double lower = getFrequencyForPoint(point) / binWidth;
+        const double upper = getFrequencyForPoint(juce::jmin(point + 1, NUM_DISPLAY_POINTS - 1)) / binWidth;
+
+        auto& range = binRanges[static_cast<size_t>(point)];
+        range.first = juce::jlimit(1, maxBin, static_cast<int>(std::round(lower)));
+        range.last = juce::jlimit(range.first, maxBin, static_cast<int>(std::round(upper)) - 1);
+    }
+}
+
+void SpectrumAnalyzer::analyse(const std::array<float, FFT_SIZE>& samples,
+                               std::array<float, NUM_DISPLAY_POINTS>& smoothed)
+{
+    auto& fftData = analysis->fftData;
+    std::copy(samples.begin(), samples.end(), fftData.begin());
+    std::fill(fftData.begin() + FFT_SIZE, fftData.end(), 0.0f);
+
+    analysis->window.multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(FFT_SIZE));
+    analysis->fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // A full-scale sine reads 0 dBFS (the normalised Hann window sums to FFT_SIZE)
+    const float magnitudeScale = 2.0f / static_cast<float>(FFT_SIZE);
+
+    for (int point = 0; point < NUM_DISPLAY_POINTS; ++point)
+    {
+        const auto& range = analysis->binRanges[static_cast<size_t>(point)];
+
+        float magnitude = 0.0f;
+        for (int bin = range.first; bin <= range.last; ++bin)
+            magnitude = juce::jmax(magnitude, fftData[static_cast<size_t>(bin)]);
+
+        const float dB = juce::Decibels::gainToDecibels(magnitude * magnitudeScale, MIN_DB);
+
+        auto& value = smoothed[static_cast<size_t>(point)];
+        value = dB > value ? dB : RELEASE_COEFF * value + (1.0f - RELEASE_COEFF) * dB;
+    }
+}
+
+int SpectrumAnalyzer::useTimeSlice()
+{
+    if (! isActive())
+        return -1;
+
+    if (const double sampleRate = currentSampleRate.load(); ! juce::exactlyEqual(sampleRate, analysis->binRangeSampleRate))
+        updateBinRanges(sampleRate);
+
+    // Only the newest window of each ring is analysed, however far behind we are
+    const bool newInput = readHops(analysis->inputRing, analysis->inputWindow);
+    const bool newOutput = readHops(analysis->outputRing, analysis->outputWindow);
+
+    if (newInput || newOutput)
+    {
+        analyse(analysis->inputWindow, smoothedInputDb);
+        analyse(analysis->outputWindow, smoothedOutputDb);
+
+        auto& frame = frames.getWriteBuffer();
+        frame.inputDb = smoothedInputDb;
+        frame.outputDb = smoothedOutputDb;
+        frames.publish();
+    }
+
+    return FRAME_INTERVAL_MS;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include "AnalysisThread.h"
+#include "TripleBuffer.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Input/Output Spectrum Analyzer
+ *
+ * - Audio thread: pushInput()/pushOutput() copy a mono sum into lock-free rings.
+ *   While the analyzer is inactive they return after a single atomic load.
+ * - Analysis thread: windowed FFTs of both rings, smoothed and resampled onto
+ *   log-spaced display points, published through a triple buffer.
+ * - Message thread: setActive(); no FFT work happens there.
+ * - fetchFrame() is for a single consumer (AnalyzerDisplay rasterises frames
+ *   on the analysis thread).
+ *
+ * The rings, FFT and window tables are built by the first setActive(true), so
+ * instances whose editor is never opened don't pay for them.
+ */
+class SpectrumAnalyzer : private juce::TimeSliceClient
+{
+public:
+    static constexpr int FFT_ORDER = 11;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int HOP_SIZE = FFT_SIZE / 4;
+    static constexpr int NUM_DISPLAY_POINTS = 256;
+    static constexpr float MIN_FREQUENCY = 20.0f;
+    static constexpr float MAX_FREQUENCY = 20000.0f;
+    static constexpr float MIN_DB = -90.0f;
+
+    // Spectrum magnitudes in dBFS at NUM_DISPLAY_POINTS log-spaced frequencies
+    struct Frame
+    {
+        std::array<float, NUM_DISPLAY_POINTS> inputDb {};
+        std::array<float, NUM_DISPLAY_POINTS> outputDb {};
+    };
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
+
+    void prepare(double sampleRate);
+
+    // Audio thread
+    void pushInput(const juce::AudioBuffer<float>& buffer) { pushTo(&Analysis::inputRing, buffer); }
+    void pushOutput(const juce::AudioBuffer<float>& buffer) { pushTo(&Analysis::outputRing, buffer); }
+
+    // Message thread: starts/stops capture and analysis
+    void setActive(bool shouldBeActive);
+    bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+    // Consumer thread. Returns true if a new frame is available in getFrame().
+    bool fetchFrame() { return frames.fetch(); }
+    const Frame& getFrame() const { return frames.getReadBuffer(); }
+
+    // Display point index to frequency in Hz
+    static float getFrequencyForPoint(int point);
+
+private:
+    // Mono sample ring: written by the audio thread, read by the analysis thread
+    struct SampleRing
+    {
+        static constexpr int CAPACITY = FFT_SIZE * 4;
+
+        juce::AbstractFifo fifo { CAPACITY };
+        std::vector<float> samples = std::vector<float>(static_cast<size_t>(CAPACITY), 0.0f);
+    };
+
+    struct BinRange
+    {
+        int first = 0;
+        int last = 0;
+    };
+
+    int useTimeSlice() override;
+
+    // Everything the analysis needs, built on first activation and kept from
+    // then on (the audio thread may still be pushing when deactivated)
+    struct Analysis
+    {
+        SampleRing inputRing;
+        SampleRing outputRing;
+
+        juce::dsp::FFT fft { FFT_ORDER };
+        juce::dsp::WindowingFunction<float> window { static_cast<size_t>(FFT_SIZE),
+                                                     juce::dsp::WindowingFunction<float>::hann };
+        std::array<float, FFT_SIZE> inputWindow {};
+        std::array<float, FFT_SIZE> outputWindow {};
+        std::array<float, FFT_SIZE * 2> fftData {};
+        std::array<BinRange, NUM_DISPLAY_POINTS> binRanges {};
+        double binRangeSampleRate = 0.0;
+    };
+
+    void pushTo(SampleRing Analysis::* ring, const juce::AudioBuffer<float>& buffer);
+    static bool readHops(SampleRing& ring, std::array<float, FFT_SIZE>& window);
+    void analyse(const std::array<float, FFT_SIZE>& samples, std::array<float, NUM_DISPLAY_POINTS>& smoothed);
+    void updateBinRanges(double sampleRate);
+
+    std::atomic<bool> active { false };
+    std::atomic<double> currentSampleRate { 44100.0 };
+
+    // Null until first activated; published to the audio thread by the
+    // release store of active
+    std::unique_ptr<Analysis> analysis;
+
+    // Analysis thread state
+    std::array<float, NUM_DISPLAY_POINTS> smoothedInputDb {};
+    std::array<float, NUM_DISPLAY_POINTS> smoothedOutputDb {};
+
+    TripleBuffer<Frame> frames;
+
+    juce::SharedResourcePointer<AnalysisThread> analysisThread;
+
+    // Smoothing: rises instantly, falls by this factor per analysis frame
+    static constexpr float RELEASE_COEFF = 0.8f;
+    static constexpr int FRAME_INTERVAL_MS = 16;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
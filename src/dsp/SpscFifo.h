@@ -0,0 +1,76 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+/**
+ * Single-producer/single-consumer FIFO of trivially-copyable records
+ *
+ * Storage is preallocated (a fixed std::array), and juce::AbstractFifo keeps
+ * the read/write positions, so push() and pop() never lock or allocate and
+ * are safe to call from the audio thread. When full, push() drops the record.
+ */
+template <typename Record, int Capacity>
+class SpscFifo
+{
+public:
+    SpscFifo() = default;
+
+    // Producer side. Returns false (and drops the record) if the FIFO is full.
+    bool push(const Record& record)
+    {
+        const auto scope = fifo.write(1);
+
+        if (scope.blockSize1 > 0)
+            records[static_cast<size_t>(scope.startIndex1)] = record;
+        else if (scope.blockSize2 > 0)
+            records[static_cast<size_t>(scope.startIndex2)] = record;
+        else
+            return false;
+
+        return true;
+    }
+
+    // Consumer side. Returns false if there was nothing to read.
+    bool pop(Record& record)
+    {
+        const auto scope = fifo.read(1);
+
+        if (scope.blockSize1 > 0)
+            record = records[static_cast<size_t>(scope.startIndex1)];
+        else if (scope.blockSize2 > 0)
+            record = records[static_cast<size_t>(scope.startIndex2)];
+        else
+            return false;
+
+        return true;
+    }
+
+    // Consumer side. Calls fn for every queued record, oldest first.
+    template <typename Fn>
+    int popAll(Fn&& fn)
+    {
+        const auto scope = fifo.read(fifo.getNumReady());
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            fn(records[static_cast<size_t>(scope.startIndex1 + i)]);
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            fn(records[static_cast<size_t>(scope.startIndex2 + i)]);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    int getNumReady() const { return fifo.getNumReady(); }
+
+    // Only safe while neither side is running
+    void reset() { fifo.reset(); }
+
+private:
+    static_assert(std::is_trivially_copyable_v<Record>, "SpscFifo records are copied by value");
+
+    juce::AbstractFifo fifo { Capacity };
+    std::array<Record, static_cast<size_t>(Capacity)> records {};
+
+    JUCE_DECLARE_NON_COPYABLE(SpscFifo)
+};
@@ -0,0 +1,77 @@
+#include "TelemetryLogger.h"
+
+TelemetryLogger::TelemetryLogger(const juce::File& file)
+{
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+
+    stream = std::make_unique<juce::FileOutputStream>(file);
+
+    if (stream->failedToOpen())
+    {
+        DBG("TelemetryLogger: could not open " + file.getFullPathName());
+        stream.reset();
+        return;
+    }
+
+    stream->writeText("block,channels,samples,input_peak,input_rms,output_peak,output_rms,"
+                      "gr_min_db,gr_max_db,processing_ns,non_finite_events,dropped\n", false, false, nullptr);
+
+    analysisThread->addClient(this);
+}
+
+TelemetryLogger::~TelemetryLogger()
+{
+    if (stream != nullptr)
+    {
+        analysisThread->removeClient(this);
+        useTimeSlice();  // Write whatever is still queued
+    }
+}
+
+std::unique_ptr<TelemetryLogger> TelemetryLogger::createFromEnvironment()
+{
+    const auto path = juce::SystemStats::getEnvironmentVariable("LA2A_TELEMETRY_LOG", {});
+
+    if (path.isEmpty() || ! juce::File::isAbsolutePath(path))
+        return nullptr;
+
+    // One file per instance: <name>-<instance>.csv next to the requested path
+    static std::atomic<int> instanceCounter { 0 };
+    const juce::File requested(path);
+    const auto file = requested.getSiblingFile(requested.getFileNameWithoutExtension()
+                                               + "-" + juce::String(++instanceCounter) + ".csv");
+
+    return std::make_unique<TelemetryLogger>(file);
+}
+
+int TelemetryLogger::useTimeSlice()
+{
+    if (stream == nullptr)
+        return -1;
+
+    // Records dropped since the last drain are reported on the next line written
+    int dropped = droppedRecords.exchange(0);
+
+    const int numWritten = fifo.popAll([this, &dropped](const BlockTelemetry& record) {
+        *stream << juce::String(blockIndex++) << ','
+                << juce::String(record.numChannels) << ','
+                << juce::String(record.numSamples) << ','
+                << juce::String(record.inputPeak, 6) << ','
+                << juce::String(record.inputRms, 6) << ','
+                << juce::String(record.outputPeak, 6) << ','
+                << juce::String(record.outputRms, 6) << ','
+                << juce::String(record.minGainDb, 3) << ','
+                << juce::String(record.maxGainDb, 3) << ','
+                << juce::String(record.processingNs) << ','
+                << juce::String(record.nonFiniteEvents) << ','
+                << juce::String(dropped) << '\n';
+        dropped = 0;
+    });
+
+    if (numWritten == 0)
+        droppedRecords += dropped;
+
+    stream->flush();
+    return DRAIN_INTERVAL_MS;
+}
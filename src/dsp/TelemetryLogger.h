@@ -0,0 +1,47 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "AnalysisThread.h"
+#include "BlockTelemetry.h"
+
+/**
+ * CSV File Logger for Per-Block Telemetry
+ *
+ * Only compiled into builds configured with LA2A_ENABLE_TELEMETRY_LOG, and
+ * only created at runtime when the LA2A_TELEMETRY_LOG environment variable
+ * names a file (see createFromEnvironment()); otherwise the processor holds
+ * no logger and the audio thread does no logging work at all.
+ *
+ * The audio thread push()es records into the logger's own FIFO; the shared
+ * AnalysisThread drains it and appends one CSV line per block.
+ */
+class TelemetryLogger : private juce::TimeSliceClient
+{
+public:
+    explicit TelemetryLogger(const juce::File& file);
+    ~TelemetryLogger() override;
+
+    // Returns a logger writing to the file named by LA2A_TELEMETRY_LOG, or nullptr
+    static std::unique_ptr<TelemetryLogger> createFromEnvironment();
+
+    // Audio thread
+    void push(const BlockTelemetry& record)
+    {
+        if (! fifo.push(record))
+            ++droppedRecords;
+    }
+
+private:
+    int useTimeSlice() override;
+
+    TelemetryFifo fifo;
+    std::atomic<int> droppedRecords { 0 };
+    juce::int64 blockIndex = 0;
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    juce::SharedResourcePointer<AnalysisThread> analysisThread;
+
+    static constexpr int DRAIN_INTERVAL_MS = 100;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TelemetryLogger)
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Lock-free triple buffer for handing whole frames from one thread to another
+ *
+ * The writer fills getWriteBuffer() and calls publish(); the reader calls
+ * fetch() and, if it returns true, reads the newest frame from
+ * getReadBuffer(). Neither side ever waits or copies: the three slots are
+ * swapped through one atomic index, so the writer can always write and the
+ * reader always sees a complete frame (intermediate frames are skipped).
+ */
+template <typename Frame>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // Writer side
+    Frame& getWriteBuffer() { return frames[static_cast<size_t>(writeIndex)]; }
+
+    void publish()
+    {
+        const int previous = middle.exchange(writeIndex | NEW_DATA_FLAG, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Reader side. Returns true if a newer frame than the last one fetched is now readable.
+    bool fetch()
+    {
+        if ((middle.load(std::memory_order_relaxed) & NEW_DATA_FLAG) == 0)
+            return false;
+
+        const int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    const Frame& getReadBuffer() const { return frames[static_cast<size_t>(readIndex)]; }
+
+private:
+    static constexpr int INDEX_MASK = 3;
+    static constexpr int NEW_DATA_FLAG = 4;
+
+    std::array<Frame, 3> frames {};
+    int writeIndex = 0;                 // Owned by the writer
+    std::atomic<int> middle { 1 };      // Slot being handed over, plus NEW_DATA_FLAG
+    int readIndex = 2;                  // Owned by the reader
+
+    JUCE_DECLARE_NON_COPYABLE(TripleBuffer)
+};
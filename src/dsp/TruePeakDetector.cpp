@@ -0,0 +1,138 @@
+#include "TruePeakDetector.h"
+
+namespace
+{
+    // BS.1770-4 Annex 2 interpolation filter, arranged as [tap][phase]
+    alignas(16) const float phaseCoefficients[TruePeakDetector::TAPS_PER_PHASE][TruePeakDetector::OVERSAMPLING] = {
+        {  0.0017089843750f, -0.0291748046875f, -0.0189208984375f, -0.0083007812500f },
+        {  0.0109863281250f,  0.0292968750000f,  0.0330810546875f,  0.0148925781250f },
+        { -0.0196533203125f, -0.0517578125000f, -0.0582275390625f, -0.0266113281250f },
+        {  0.0332031250000f,  0.0891113281250f,  0.1015625000000f,  0.0476074218750f },
+        { -0.0594482421875f, -0.1665039062500f, -0.2003173828125f, -0.1022949218750f },
+        {  0.1373291015625f,  0.4650878906250f,  0.7797851562500f,  0.9721679687500f },
+        {  0.9721679687500f,  0.7797851562500f,  0.4650878906250f,  0.1373291015625f },
+        { -0.1022949218750f, -0.2003173828125f, -0.1665039062500f, -0.0594482421875f },
+        {  0.0476074218750f,  0.1015625000000f,  0.0891113281250f,  0.0332031250000f },
+        { -0.0266113281250f, -0.0582275390625f, -0.0517578125000f, -0.0196533203125f },
+        {  0.0148925781250f,  0.0330810546875f,  0.0292968750000f,  0.0109863281250f },
+        { -0.0083007812500f, -0.0189208984375f, -0.0291748046875f,  0.0017089843750f },
+    };
+
+    float maxOfLanes(juce::dsp::SIMDRegister<float> v)
+    {
+        float result = v.get(0);
+        for (size_t lane = 1; lane < juce::dsp::SIMDRegister<float>::SIMDNumElements; ++lane)
+            result = juce::jmax(result, v.get(lane));
+
+        return result;
+    }
+}
+
+TruePeakDetector::TruePeakDetector()
+{
+    for (size_t k = 0; k < taps.size(); ++k)
+    {
+        alignas(Vec::SIMDRegisterSize) float lanes[LANES];
+        for (int lane = 0; lane < LANES; ++lane)
+            lanes[lane] = phaseCoefficients[k][lane % OVERSAMPLING];
+
+        taps[k] = Vec::fromRawArray(lanes);
+    }
+}
+
+void TruePeakDetector::prepare(int numChannels)
+{
+    numPrepared = juce::jmax(0, numChannels);
+    history.resize(static_cast<size_t>((numPrepared + CHANNELS_PER_VEC - 1) / CHANNELS_PER_VEC));
+    reset();
+}
+
+void TruePeakDetector::reset()
+{
+    for (auto& past : history)
+        past.fill(Vec::expand(0.0f));
+}
+
+float TruePeakDetector::process(const float* const* channels, int numChannels, int numSamples,
+                                float* perSamplePeaks)
+{
+    numChannels = juce::jmin(numChannels, numPrepared);
+    float peak = 0.0f;
+
+    // Work through the block in chunks that fit the stack buffers
+    for (int start = 0; start < numSamples; start += CHUNK_SIZE)
+    {
+        const int num = juce::jmin(CHUNK_SIZE, numSamples - start);
+        peak = juce::jmax(peak, processChunk(channels, numChannels, start, num,
+                                             perSamplePeaks != nullptr ? perSamplePeaks + start : nullptr));
+    }
+
+    return peak;
+}
+
+float TruePeakDetector::processChunk(const float* const* channels, int numChannels, int start, int numSamples,
+                                     float* perSamplePeaks)
+{
+    const Vec zero = Vec::expand(0.0f);
+    std::array<Vec, CHUNK_SIZE> samplePeaks;
+    std::fill_n(samplePeaks.begin(), numSamples, zero);
+
+    const auto numGroups = static_cast<size_t>((numChannels + CHANNELS_PER_VEC - 1) / CHANNELS_PER_VEC);
+
+    for (size_t group = 0; group < numGroups; ++group)
+    {
+        // x[HISTORY + n] is input sample n; x[HISTORY + n - k] the one k samples earlier
+        std::array<Vec, HISTORY + CHUNK_SIZE> x;
+        std::copy(history[group].begin(), history[group].end(), x.begin());
+
+        const int firstChannel = static_cast<int>(group) * CHANNELS_PER_VEC;
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            if constexpr (CHANNELS_PER_VEC == 1)
+            {
+                x[static_cast<size_t>(HISTORY + n)] = Vec::expand(channels[firstChannel][start + n]);
+            }
+            else
+            {
+                alignas(Vec::SIMDRegisterSize) float lanes[LANES];
+                for (int slot = 0; slot < CHANNELS_PER_VEC; ++slot)
+                {
+                    const int ch = firstChannel + slot;
+                    const float sample = ch < numChannels ? channels[ch][start + n] : 0.0f;
+                    std::fill_n(lanes + slot * OVERSAMPLING, OVERSAMPLING, sample);
+                }
+
+                x[static_cast<size_t>(HISTORY + n)] = Vec::fromRawArray(lanes);
+            }
+        }
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const Vec* newest = x.data() + HISTORY + n;
+
+            Vec y = taps[0] * newest[0];
+            for (int k = 1; k < TAPS_PER_PHASE; ++k)
+                y = Vec::multiplyAdd(y, taps[static_cast<size_t>(k)], newest[-k]);
+
+            auto& samplePeak = samplePeaks[static_cast<size_t>(n)];
+            samplePeak = Vec::max(samplePeak, Vec::max(y, zero - y));
+        }
+
+        // Keep the last HISTORY samples for the next chunk
+        std::copy_n(x.begin() + numSamples, HISTORY, history[group].begin());
+    }
+
+    // Reduce over lanes: all phases of all channels
+    Vec blockPeak = zero;
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const auto& samplePeak = samplePeaks[static_cast<size_t>(n)];
+        blockPeak = Vec::max(blockPeak, samplePeak);
+
+        if (perSamplePeaks != nullptr)
+            perSamplePeaks[n] = maxOfLanes(samplePeak);
+    }
+
+    return maxOfLanes(blockPeak);
+}
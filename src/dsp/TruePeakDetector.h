@@ -0,0 +1,58 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <vector>
+
+/**
+ * ITU-R BS.1770-4 True-Peak Detector
+ *
+ * 4x oversampling with the 48-tap interpolation filter from BS.1770-4 Annex 2,
+ * split into four 12-tap polyphase branches. The four branches are evaluated
+ * together, one SIMD lane per phase; a register wider than four lanes (AVX)
+ * holds the phases of more than one channel. Each input sample costs 12 vector
+ * multiply-adds per register's worth of channels.
+ *
+ * This is a detector only: the audio itself is never oversampled.
+ */
+class TruePeakDetector
+{
+public:
+    static constexpr int OVERSAMPLING = 4;
+    static constexpr int TAPS_PER_PHASE = 12;
+
+    // Interpolated values for input sample n describe the signal around n - DELAY_SAMPLES
+    static constexpr int DELAY_SAMPLES = TAPS_PER_PHASE / 2;
+
+    TruePeakDetector();
+
+    void prepare(int numChannels);
+    void reset();
+
+    // Returns the true peak of the block (linear, over all channels).
+    // If perSamplePeaks is given, each input sample's true peak across channels
+    // is written there too (numSamples values).
+    float process(const float* const* channels, int numChannels, int numSamples,
+                  float* perSamplePeaks = nullptr);
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int LANES = static_cast<int>(Vec::SIMDNumElements);
+    static_assert(LANES % OVERSAMPLING == 0, "Whole sets of polyphase branches per SIMD register");
+    static constexpr int CHANNELS_PER_VEC = LANES / OVERSAMPLING;
+
+    static constexpr int HISTORY = TAPS_PER_PHASE - 1;
+    static constexpr int CHUNK_SIZE = 32;
+
+    float processChunk(const float* const* channels, int numChannels, int start, int numSamples,
+                       float* perSamplePeaks);
+
+    // taps[k] = { phase0[k], phase1[k], phase2[k], phase3[k] }, repeated for each channel in a register
+    std::array<Vec, TAPS_PER_PHASE> taps;
+
+    // Per register of channels: the last HISTORY input samples, each channel's
+    // sample repeated across its OVERSAMPLING lanes
+    std::vector<std::array<Vec, HISTORY>> history;
+    int numPrepared = 0;
+};
@@ -0,0 +1,163 @@
+#include "TruePeakLimiter.h"
+#include <cmath>
+
+void TruePeakLimiter::prepare(double sampleRate, int numChannels, int maxBlockSize)
+{
+    numPrepared = numChannels;
+
+    // 1.5 ms lookahead, 50 ms release
+    lookahead = juce::jmax(1, juce::roundToInt(sampleRate * 0.0015));
+    releaseCoeff = std::exp(-1.0f / (0.05f * static_cast<float>(sampleRate)));
+
+    ceilingDetector.prepare(numChannels);
+    outputDetector.prepare(numChannels);
+
+    delayLines.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(getLatencySamples()), 0.0f));
+    detectorPeaks.assign(static_cast<size_t>(juce::jmax(1, maxBlockSize)), 0.0f);
+
+    // The minimum covers lookahead + 2 detector outputs: the two that describe
+    // the intervals either side of the sample leaving the delay line
+    minWindow = lookahead + 2;
+    minQueue.assign(static_cast<size_t>(minWindow), {});
+    boxRing.assign(static_cast<size_t>(lookahead + 1), 1.0f);
+
+    reset();
+}
+
+void TruePeakLimiter::reset()
+{
+    ceilingDetector.reset();
+    outputDetector.reset();
+
+    for (auto& line : delayLines)
+        std::fill(line.begin(), line.end(), 0.0f);
+
+    delayPosition = 0;
+    minHead = 0;
+    minSize = 0;
+    sampleIndex = 0;
+    std::fill(boxRing.begin(), boxRing.end(), 1.0f);
+    boxPosition = 0;
+    boxSum = static_cast<double>(boxRing.size());
+    gain = 1.0f;
+    stats = {};
+}
+
+void TruePeakLimiter::setCeiling(bool shouldBeEnabled, float ceilingDb)
+{
+    ceiling = juce::Decibels::decibelsToGain(ceilingDb);
+
+    if (shouldBeEnabled == enabled)
+        return;
+
+    enabled = shouldBeEnabled;
+
+    // Start from unity with an empty detector history
+    ceilingDetector.reset();
+    minHead = 0;
+    minSize = 0;
+    std::fill(boxRing.begin(), boxRing.end(), 1.0f);
+    boxSum = static_cast<double>(boxRing.size());
+    gain = 1.0f;
+}
+
+float TruePeakLimiter::pushRequiredGain(float requiredGain)
+{
+    const auto capacity = static_cast<int>(minQueue.size());
+
+    // Drop queued entries that can no longer be the minimum, then expired ones
+    while (minSize > 0 && minQueue[static_cast<size_t>((minHead + minSize - 1) % capacity)].gain >= requiredGain)
+        --minSize;
+
+    minQueue[static_cast<size_t>((minHead + minSize) % capacity)] = { sampleIndex, requiredGain };
+    ++minSize;
+
+    while (minQueue[static_cast<size_t>(minHead)].index <= sampleIndex - minWindow)
+    {
+        minHead = (minHead + 1) % capacity;
+        --minSize;
+    }
+
+    ++sampleIndex;
+    const float windowMin = minQueue[static_cast<size_t>(minHead)].gain;
+
+    // Box filter: every value averaged in is at or below the requirement of the
+    // sample now leaving the delay line, so the average is too
+    boxSum += static_cast<double>(windowMin) - static_cast<double>(boxRing[static_cast<size_t>(boxPosition)]);
+    boxRing[static_cast<size_t>(boxPosition)] = windowMin;
+    boxPosition = (boxPosition + 1) % static_cast<int>(boxRing.size());
+
+    const auto smoothed = static_cast<float>(boxSum / static_cast<double>(boxRing.size()));
+
+    if (smoothed < gain)
+        gain = smoothed;
+    else
+        gain = smoothed + releaseCoeff * (gain - smoothed);
+
+    return gain;
+}
+
+void TruePeakLimiter::process(juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), numPrepared);
+    const int numSamples = buffer.getNumSamples();
+    const int numMetered = juce::jmin(numChannels, MeterSnapshot::MAX_CHANNELS);
+    const int delayLength = getLatencySamples();
+    auto* const* channels = buffer.getArrayOfWritePointers();
+
+    stats = {};
+
+    for (int start = 0; start < numSamples; start += static_cast<int>(detectorPeaks.size()))
+    {
+        const int num = juce::jmin(static_cast<int>(detectorPeaks.size()), numSamples - start);
+
+        if (enabled)
+        {
+            const float* chunk[MeterSnapshot::MAX_CHANNELS] = {};
+
+            // Detector sees the chunk before it is overwritten with delayed output
+            for (int ch = 0; ch < numMetered; ++ch)
+                chunk[ch] = channels[ch] + start;
+
+            ceilingDetector.process(chunk, numMetered, num, detectorPeaks.data());
+        }
+
+        int position = delayPosition;
+
+        for (int n = 0; n < num; ++n)
+        {
+            float sampleGain = 1.0f;
+
+            if (enabled)
+            {
+                const float peak = detectorPeaks[static_cast<size_t>(n)];
+                sampleGain = pushRequiredGain(peak > ceiling ? ceiling / peak : 1.0f);
+                stats.minGain = juce::jmin(stats.minGain, sampleGain);
+            }
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto& line = delayLines[static_cast<size_t>(ch)];
+                const float delayed = line[static_cast<size_t>(position)];
+                line[static_cast<size_t>(position)] = channels[ch][start + n];
+
+                const float output = delayed * sampleGain;
+                channels[ch][start + n] = output;
+
+                if (ch < numMetered)
+                {
+                    const auto index = static_cast<size_t>(ch);
+                    stats.peak[index] = juce::jmax(stats.peak[index], std::abs(output));
+                    stats.sumSquares[index] += output * output;
+                }
+            }
+
+            if (++position == delayLength)
+                position = 0;
+        }
+
+        delayPosition = position;
+    }
+
+    stats.truePeak = outputDetector.process(channels, numMetered, numSamples);
+}
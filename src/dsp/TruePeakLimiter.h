@@ -0,0 +1,89 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "MeterSnapshot.h"
+#include "TruePeakDetector.h"
+#include <array>
+#include <vector>
+
+/**
+ * Output Stage: Lookahead True-Peak Ceiling and Output Metering
+ *
+ * Runs after the compressor on every block:
+ * - Delays the audio by a fixed lookahead (reported to the host as latency,
+ *   whether or not the ceiling is engaged, so latency never changes at runtime)
+ * - When enabled, detects the true peak of the incoming signal and applies a
+ *   smooth, linked gain that keeps it under the ceiling by the time it leaves
+ *   the delay line
+ * - Measures per-channel output peak/RMS while writing the final samples, and
+ *   the true peak of the final output
+ *
+ * The gain is the lookahead-window minimum of the required gain, box-filtered
+ * over the lookahead, so it is fully down at every detected overshoot without
+ * stepping; after that it releases exponentially.
+ */
+class TruePeakLimiter
+{
+public:
+    struct OutputStats
+    {
+        std::array<float, MeterSnapshot::MAX_CHANNELS> peak {};
+        std::array<float, MeterSnapshot::MAX_CHANNELS> sumSquares {};
+        float truePeak = 0.0f;          // Linear, all channels
+        float minGain = 1.0f;           // Deepest ceiling gain in the block
+    };
+
+    TruePeakLimiter() = default;
+
+    void prepare(double sampleRate, int numChannels, int maxBlockSize);
+    void reset();
+
+    void setCeiling(bool enabled, float ceilingDb);
+
+    // Total delay added to the audio, in samples
+    int getLatencySamples() const { return lookahead + TruePeakDetector::DELAY_SAMPLES; }
+
+    void process(juce::AudioBuffer<float>& buffer);
+
+    const OutputStats& getLastStats() const { return stats; }
+
+private:
+    float pushRequiredGain(float requiredGain);
+
+    TruePeakDetector ceilingDetector;   // On the incoming signal (only while enabled)
+    TruePeakDetector outputDetector;    // On the final output, for metering
+
+    int lookahead = 0;
+    int numPrepared = 0;
+    bool enabled = false;
+    float ceiling = 1.0f;
+    float releaseCoeff = 0.0f;
+
+    // Audio delay, one ring per channel
+    std::vector<std::vector<float>> delayLines;
+    int delayPosition = 0;
+
+    // Per-sample true peaks of the incoming block
+    std::vector<float> detectorPeaks;
+
+    // Sliding minimum of the required gain (monotonic queue in a fixed ring)
+    struct MinEntry
+    {
+        juce::int64 index = 0;
+        float gain = 1.0f;
+    };
+
+    std::vector<MinEntry> minQueue;
+    int minHead = 0;
+    int minSize = 0;
+    int minWindow = 0;
+    juce::int64 sampleIndex = 0;
+
+    // Box filter over the sliding minimum
+    std::vector<float> boxRing;
+    int boxPosition = 0;
+    double boxSum = 0.0;
+
+    float gain = 1.0f;
+    OutputStats stats;
+};
@@ -0,0 +1,303 @@
+#include "AnalyzerDisplay.h"
+#include "../dsp/OptoCompressor.h"
+
+AnalyzerDisplay::AnalyzerDisplay(SpectrumAnalyzer& a)
+    : analyzer(a)
+{
+    setOpaque(true);
+}
+
+AnalyzerDisplay::~AnalyzerDisplay()
+{
+    spectrumRenderer.setActive(false);
+    analyzer.setActive(false);
+}
+
+void AnalyzerDisplay::visibilityChanged()
+{
+    updateActiveState();
+}
+
+void AnalyzerDisplay::parentHierarchyChanged()
+{
+    updateActiveState();
+}
+
+void AnalyzerDisplay::updateActiveState()
+{
+    // Capture, FFTs and rendering only run while the display can actually be seen
+    const bool showing = isShowing();
+    analyzer.setActive(showing);
+    spectrumRenderer.setActive(showing);
+}
+
+void AnalyzerDisplay::setTransferCurve(float peakReduction, float ratio)
+{
+    if (juce::exactlyEqual(peakReduction, curvePeakReduction) && juce::exactlyEqual(ratio, curveRatio))
+        return;
+
+    curvePeakReduction = peakReduction;
+    curveRatio = ratio;
+    curveDirty = true;
+}
+
+void AnalyzerDisplay::setOperatingPoint(float inputDb, float gainReductionDb)
+{
+    inputDb = juce::jlimit(CURVE_MIN_DB, CURVE_MAX_DB, inputDb);
+
+    if (std::abs(inputDb - operatingInputDb) < 0.1f && std::abs(gainReductionDb - operatingGainReductionDb) < 0.1f)
+        return;
+
+    operatingInputDb = inputDb;
+    operatingGainReductionDb = gainReductionDb;
+
+    if (isShowing())
+        repaint(getCurveArea());
+}
+
+void AnalyzerDisplay::update()
+{
+    if (! isShowing())
+        return;
+
+    if (spectrumRenderer.fetchImage())
+        repaint(getSpectrumArea());
+
+    if (curveDirty)
+    {
+        renderCurve();
+        repaint(getCurveArea());
+    }
+}
+
+juce::Rectangle<int> AnalyzerDisplay::getSpectrumArea() const
+{
+    return getLocalBounds().withTrimmedRight(getCurveArea().getWidth());
+}
+
+juce::Rectangle<int> AnalyzerDisplay::getCurveArea() const
+{
+    return getLocalBounds().removeFromRight(juce::roundToInt(static_cast<float>(getWidth()) * CURVE_WIDTH_RATIO));
+}
+
+std::unique_ptr<juce::Graphics> AnalyzerDisplay::beginImage(juce::Image& image, RasterSize size)
+{
+    const int physicalWidth = juce::jmax(1, juce::roundToInt(static_cast<float>(size.width) * size.scaleFactor));
+    const int physicalHeight = juce::jmax(1, juce::roundToInt(static_cast<float>(size.height) * size.scaleFactor));
+
+    // Software images can be rendered on any thread
+    if (image.getWidth() != physicalWidth || image.getHeight() != physicalHeight)
+        image = juce::Image(juce::Image::RGB, physicalWidth, physicalHeight, false, juce::SoftwareImageType());
+
+    auto g = std::make_unique<juce::Graphics>(image);
+    g->addTransform(juce::AffineTransform::scale(static_cast<float>(physicalWidth) / static_cast<float>(size.width),
+                                                 static_cast<float>(physicalHeight) / static_cast<float>(size.height)));
+    return g;
+}
+
+//==============================================================================
+AnalyzerDisplay::SpectrumRenderer::SpectrumRenderer(SpectrumAnalyzer& a)
+    : analyzer(a)
+{
+}
+
+AnalyzerDisplay::SpectrumRenderer::~SpectrumRenderer()
+{
+    setActive(false);
+}
+
+void AnalyzerDisplay::SpectrumRenderer::setActive(bool shouldBeActive)
+{
+    if (shouldBeActive == active)
+        return;
+
+    active = shouldBeActive;
+
+    // removeClient() waits for a render in progress
+    if (active)
+        analysisThread->addClient(this);
+    else
+        analysisThread->removeClient(this);
+}
+
+void AnalyzerDisplay::SpectrumRenderer::setSize(RasterSize newSize)
+{
+    const juce::SpinLock::ScopedLockType lock(sizeLock);
+    requestedSize = newSize;
+}
+
+int AnalyzerDisplay::SpectrumRenderer::useTimeSlice()
+{
+    const bool newFrame = analyzer.fetchFrame();
+
+    RasterSize size;
+    {
+        const juce::SpinLock::ScopedLockType lock(sizeLock);
+        size = requestedSize;
+    }
+
+    // Re-rendered for a new frame, or for the last frame at a new size
+    if (! size.isEmpty() && (newFrame || size != renderedSize))
+    {
+        render(images.getWriteBuffer(), size, analyzer.getFrame());
+        images.publish();
+        renderedSize = size;
+    }
+
+    return RENDER_INTERVAL_MS;
+}
+
+void AnalyzerDisplay::SpectrumRenderer::render(juce::Image& image, RasterSize size,
+                                               const SpectrumAnalyzer::Frame& frame)
+{
+    const auto context = beginImage(image, size);
+    auto& g = *context;
+
+    const float width = static_cast<float>(size.width);
+    const float height = static_cast<float>(size.height);
+    const float k = height / 120.0f;
+
+    g.fillAll(juce::Colour(0xFF151515));
+
+    auto xForPoint = [width](int point) {
+        return width * static_cast<float>(point) / static_cast<float>(SpectrumAnalyzer::NUM_DISPLAY_POINTS - 1);
+    };
+    auto yForDb = [height](float dB) {
+        return juce::jmap(juce::jlimit(SPECTRUM_MIN_DB, SPECTRUM_MAX_DB, dB), SPECTRUM_MAX_DB, SPECTRUM_MIN_DB, 0.0f, height);
+    };
+
+    // Decade grid
+    g.setColour(juce::Colour(0xFF2A2A2A));
+    const float logRange = std::log10(SpectrumAnalyzer::MAX_FREQUENCY / SpectrumAnalyzer::MIN_FREQUENCY);
+    for (float frequency : { 100.0f, 1000.0f, 10000.0f })
+        g.fillRect(width * std::log10(frequency / SpectrumAnalyzer::MIN_FREQUENCY) / logRange, 0.0f, 1.0f, height);
+    for (float dB = -24.0f; dB > SPECTRUM_MIN_DB; dB -= 24.0f)
+        g.fillRect(0.0f, yForDb(dB), width, 1.0f);
+
+    auto buildPath = [&](const auto& values) {
+        juce::Path path;
+        path.startNewSubPath(0.0f, yForDb(values[0]));
+        for (int point = 1; point < SpectrumAnalyzer::NUM_DISPLAY_POINTS; ++point)
+            path.lineTo(xForPoint(point), yForDb(values[static_cast<size_t>(point)]));
+        return path;
+    };
+
+    // Input: filled
+    auto inputPath = buildPath(frame.inputDb);
+    inputPath.lineTo(width, height);
+    inputPath.lineTo(0.0f, height);
+    inputPath.closeSubPath();
+    g.setColour(juce::Colour(0xFF4A4A4A));
+    g.fillPath(inputPath);
+
+    // Output: line
+    g.setColour(juce::Colour(0xFF00DD00));
+    g.strokePath(buildPath(frame.outputDb), juce::PathStrokeType(1.2f * k));
+
+    // Legend
+    auto textArea = juce::Rectangle<float>(width, height).reduced(4.0f * k, 2.0f * k);
+    g.setFont(resources->getFont(9.0f * k));
+    g.setColour(juce::Colour(0xFF888888));
+    g.drawText("IN", textArea, juce::Justification::topLeft);
+    g.setColour(juce::Colour(0xFF00DD00));
+    g.drawText("OUT", textArea.withTrimmedLeft(18.0f * k), juce::Justification::topLeft);
+}
+
+//==============================================================================
+void AnalyzerDisplay::renderCurve()
+{
+    curveDirty = false;
+
+    const auto area = getCurveArea();
+    if (area.isEmpty())
+        return;
+
+    const auto context = beginImage(curveImage, { area.getWidth(), area.getHeight(), renderScale });
+    auto& g = *context;
+
+    const float width = static_cast<float>(area.getWidth());
+    const float height = static_cast<float>(area.getHeight());
+    const float k = height / 120.0f;
+    auto toX = [width](float dB) { return juce::jmap(dB, CURVE_MIN_DB, CURVE_MAX_DB, 0.0f, width); };
+    auto toY = [height](float dB) { return juce::jmap(dB, CURVE_MIN_DB, CURVE_MAX_DB, height, 0.0f); };
+
+    g.fillAll(juce::Colour(0xFF1B1B1B));
+
+    // Grid and unity line
+    g.setColour(juce::Colour(0xFF2A2A2A));
+    for (float dB = -12.0f; dB > CURVE_MIN_DB; dB -= 12.0f)
+    {
+        g.fillRect(toX(dB), 0.0f, 1.0f, height);
+        g.fillRect(0.0f, toY(dB), width, 1.0f);
+    }
+    g.drawLine(0.0f, height, width, 0.0f, 1.0f);
+
+    // Transfer curve: output level against input level (before makeup gain)
+    juce::Path curve;
+    constexpr int numSteps = 120;
+    for (int i = 0; i <= numSteps; ++i)
+    {
+        const float inputDb = juce::jmap(static_cast<float>(i), 0.0f, static_cast<float>(numSteps), CURVE_MIN_DB, CURVE_MAX_DB);
+        const float outputDb = inputDb - OptoCompressor::computeGainReductionDb(inputDb, curvePeakReduction, curveRatio);
+        const juce::Point<float> position(toX(inputDb), toY(outputDb));
+
+        if (i == 0)
+            curve.startNewSubPath(position);
+        else
+            curve.lineTo(position);
+    }
+
+    g.setColour(juce::Colour(0xFFFF8800));
+    g.strokePath(curve, juce::PathStrokeType(1.5f * k));
+
+    g.setColour(juce::Colour(0xFF0A0A0A));
+    g.fillRect(0.0f, 0.0f, 2.0f, height);
+}
+
+void AnalyzerDisplay::paint(juce::Graphics& g)
+{
+    // A new display scale is picked up by the next update(); until then the
+    // current images are drawn scaled
+    const auto scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (! juce::approximatelyEqual(scaleFactor, renderScale))
+    {
+        renderScale = scaleFactor;
+        curveDirty = true;
+        updateSpectrumSize();
+    }
+
+    // After a resize the previous raster is drawn scaled until the new one arrives
+    if (const auto& spectrumImage = spectrumRenderer.getImage(); spectrumImage.isValid())
+        g.drawImage(spectrumImage, getSpectrumArea().toFloat());
+    else
+        g.fillAll(juce::Colour(0xFF151515));
+
+    const auto curveArea = getCurveArea();
+    if (curveImage.isValid())
+        g.drawImage(curveImage, curveArea.toFloat());
+
+    // Live operating point on the transfer curve
+    const auto curveBounds = curveArea.toFloat();
+    const float x = juce::jmap(operatingInputDb, CURVE_MIN_DB, CURVE_MAX_DB, curveBounds.getX(), curveBounds.getRight());
+    const float y = juce::jmap(juce::jmax(CURVE_MIN_DB, operatingInputDb + operatingGainReductionDb),
+                               CURVE_MIN_DB, CURVE_MAX_DB, curveBounds.getBottom(), curveBounds.getY());
+    const float dotRadius = 2.5f * curveBounds.getHeight() / 120.0f;
+    g.setColour(juce::Colour(0xFFFFDD00));
+    g.fillEllipse(x - dotRadius, y - dotRadius, dotRadius * 2.0f, dotRadius * 2.0f);
+
+    g.setColour(juce::Colour(0xFF0A0A0A));
+    g.drawRect(getLocalBounds(), 2);
+}
+
+void AnalyzerDisplay::resized()
+{
+    curveDirty = true;
+    updateSpectrumSize();
+    update();
+}
+
+void AnalyzerDisplay::updateSpectrumSize()
+{
+    const auto area = getSpectrumArea();
+    spectrumRenderer.setSize({ area.getWidth(), area.getHeight(), renderScale });
+}
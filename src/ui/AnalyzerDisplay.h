@@ -0,0 +1,129 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "SharedGuiResources.h"
+#include "../dsp/AnalysisThread.h"
+#include "../dsp/SpectrumAnalyzer.h"
+#include "../dsp/TripleBuffer.h"
+
+/**
+ * Spectrum and Transfer Curve Display
+ *
+ * Left: input (grey fill) and output (green line) spectra from the
+ * SpectrumAnalyzer. Right: the static transfer curve for the current
+ * settings, with the live detector level marked on it.
+ *
+ * Both plots are rendered into cached images, at the physical pixel size of
+ * the last paint, only when their data changes (a new analyzer frame, new
+ * settings, a new display scale), so paint() just blits them. Spectrum frames
+ * are rasterised on the shared analysis thread right after the analyzer
+ * publishes them and handed over through a triple buffer; the message thread
+ * only renders the transfer curve, when the settings change. The analyzer and
+ * its renderer are active while this component is showing and deactivated as
+ * soon as it is hidden.
+ */
+class AnalyzerDisplay : public juce::Component
+{
+public:
+    explicit AnalyzerDisplay(SpectrumAnalyzer& analyzer);
+    ~AnalyzerDisplay() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+
+    // Transfer curve settings (see OptoCompressor::computeGainReductionDb)
+    void setTransferCurve(float peakReduction, float ratio);
+
+    // Live detector input level and resulting gain reduction, in dB
+    void setOperatingPoint(float inputDb, float gainReductionDb);
+
+    // Picks up new analyzer frames and re-renders what changed (message thread)
+    void update();
+
+private:
+    // Logical size and display scale of a raster
+    struct RasterSize
+    {
+        int width = 0;
+        int height = 0;
+        float scaleFactor = 1.0f;
+
+        bool isEmpty() const { return width <= 0 || height <= 0; }
+
+        bool operator==(const RasterSize& other) const
+        {
+            return width == other.width && height == other.height
+                && juce::exactlyEqual(scaleFactor, other.scaleFactor);
+        }
+
+        bool operator!=(const RasterSize& other) const { return ! operator==(other); }
+    };
+
+    // Rasterises each new analyzer frame on the analysis thread
+    class SpectrumRenderer : private juce::TimeSliceClient
+    {
+    public:
+        explicit SpectrumRenderer(SpectrumAnalyzer& analyzer);
+        ~SpectrumRenderer() override;
+
+        // Message thread
+        void setActive(bool shouldBeActive);
+        void setSize(RasterSize newSize);
+
+        // Message thread. Returns true if a new raster is available in getImage().
+        bool fetchImage() { return images.fetch(); }
+        const juce::Image& getImage() const { return images.getReadBuffer(); }
+
+    private:
+        int useTimeSlice() override;
+        void render(juce::Image& image, RasterSize size, const SpectrumAnalyzer::Frame& frame);
+
+        SpectrumAnalyzer& analyzer;
+        bool active = false;
+
+        juce::SpinLock sizeLock;
+        RasterSize requestedSize;       // Guarded by sizeLock
+        RasterSize renderedSize;        // Analysis thread
+
+        TripleBuffer<juce::Image> images;
+
+        juce::SharedResourcePointer<SharedGuiResources> resources;
+        juce::SharedResourcePointer<AnalysisThread> analysisThread;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumRenderer)
+    };
+
+    void updateActiveState();
+    void updateSpectrumSize();
+    void renderCurve();
+    juce::Rectangle<int> getSpectrumArea() const;
+    juce::Rectangle<int> getCurveArea() const;
+
+    // Sizes image for the raster and returns a context drawing in its logical coordinates
+    static std::unique_ptr<juce::Graphics> beginImage(juce::Image& image, RasterSize size);
+
+    SpectrumAnalyzer& analyzer;
+
+    juce::Image curveImage;
+    bool curveDirty = true;
+    float renderScale = 1.0f;   // Physical pixels per logical pixel, as last painted
+
+    float curvePeakReduction = -1.0f;
+    float curveRatio = 0.0f;
+    float operatingInputDb = CURVE_MIN_DB;
+    float operatingGainReductionDb = 0.0f;
+
+    SpectrumRenderer spectrumRenderer { analyzer };   // Stopped before anything it reads goes away
+
+    // Display ranges
+    static constexpr float SPECTRUM_MIN_DB = -84.0f;
+    static constexpr float SPECTRUM_MAX_DB = 0.0f;
+    static constexpr float CURVE_MIN_DB = -60.0f;
+    static constexpr float CURVE_MAX_DB = 0.0f;
+    static constexpr float CURVE_WIDTH_RATIO = 0.4f;   // Share of the width given to the curve
+    static constexpr int RENDER_INTERVAL_MS = 16;      // Analysis thread check for new frames
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyzerDisplay)
+};
@@ -0,0 +1,209 @@
+#include "HistoryGraph.h"
+#include "LA2ALookAndFeel.h"
+
+HistoryGraph::HistoryGraph()
+{
+    setOpaque(true);
+}
+
+void HistoryGraph::addFrame(const BlockTelemetry& frame, double sampleRate)
+{
+    pendingMinGainDb = juce::jmin(pendingMinGainDb, frame.minGainDb);
+    pendingMaxGainDb = juce::jmax(pendingMaxGainDb, frame.maxGainDb);
+    pendingInputPeak = juce::jmax(pendingInputPeak, frame.inputPeak);
+    pendingOutputPeak = juce::jmax(pendingOutputPeak, frame.outputPeak);
+    pendingInputSumSquares += static_cast<double>(frame.inputRms * frame.inputRms) * frame.numSamples;
+    pendingOutputSumSquares += static_cast<double>(frame.outputRms * frame.outputRms) * frame.numSamples;
+    pendingSamples += frame.numSamples;
+
+    const int samplesPerColumn = juce::jmax(1, static_cast<int>(sampleRate * COLUMN_MS / 1000.0));
+    if (pendingSamples < samplesPerColumn)
+        return;
+
+    auto toDb = [](double gain) {
+        return gain > 0.0 ? juce::jmax(MIN_LEVEL_DB, static_cast<float>(20.0 * std::log10(gain))) : MIN_LEVEL_DB;
+    };
+
+    auto& column = columns[static_cast<size_t>(nextColumn)];
+    column.minGainDb = pendingMinGainDb;
+    column.maxGainDb = juce::jmin(pendingMaxGainDb, 0.0f);
+    column.inputPeakDb = toDb(pendingInputPeak);
+    column.inputRmsDb = toDb(std::sqrt(pendingInputSumSquares / pendingSamples));
+    column.outputPeakDb = toDb(pendingOutputPeak);
+    column.outputRmsDb = toDb(std::sqrt(pendingOutputSumSquares / pendingSamples));
+
+    nextColumn = (nextColumn + 1) % MAX_COLUMNS;
+    numColumns = juce::jmin(numColumns + 1, MAX_COLUMNS);
+    ++columnsToDraw;
+
+    pendingMinGainDb = 0.0f;
+    pendingMaxGainDb = -1000.0f;
+    pendingInputPeak = 0.0f;
+    pendingOutputPeak = 0.0f;
+    pendingInputSumSquares = 0.0;
+    pendingOutputSumSquares = 0.0;
+    pendingSamples = 0;
+}
+
+void HistoryGraph::update()
+{
+    // Hidden: keep collecting columns, draw them all when shown again
+    if (! isVisible())
+    {
+        if (columnsToDraw > 0)
+            needsFullRedraw = true;
+
+        columnsToDraw = 0;
+        return;
+    }
+
+    if (needsFullRedraw || ! historyImage.isValid())
+    {
+        redrawAll();
+        repaint();
+        return;
+    }
+
+    if (columnsToDraw == 0)
+        return;
+
+    const int width = getWidth();
+    const int newColumns = juce::jmin(columnsToDraw, width);
+    columnsToDraw = 0;
+
+    // Scroll the existing columns left, then draw only the new ones at the right edge
+    if (newColumns < width)
+    {
+        const int shift = newColumns * columnPixels;
+        historyImage.moveImageSection(0, 0, shift, 0, historyImage.getWidth() - shift, historyImage.getHeight());
+    }
+
+    juce::Graphics g(historyImage);
+    for (int i = 0; i < newColumns; ++i)
+    {
+        const int age = newColumns - 1 - i;
+        const int index = (nextColumn - 1 - age + MAX_COLUMNS) % MAX_COLUMNS;
+        drawColumn(g, width - newColumns + i, columns[static_cast<size_t>(index)]);
+    }
+
+    repaint();
+}
+
+void HistoryGraph::redrawAll()
+{
+    needsFullRedraw = false;
+    columnsToDraw = 0;
+
+    if (getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    // One column per logical pixel, at least as many image pixels wide as the scale
+    columnPixels = juce::jmax(1, juce::roundToInt(renderScale));
+    const int imageWidth = getWidth() * columnPixels;
+    const int imageHeight = juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * renderScale));
+
+    if (historyImage.getWidth() != imageWidth || historyImage.getHeight() != imageHeight)
+        historyImage = juce::Image(juce::Image::RGB, imageWidth, imageHeight, false);
+
+    juce::Graphics g(historyImage);
+    const int width = getWidth();
+
+    for (int x = width - 1, age = 0; x >= 0; --x, ++age)
+    {
+        if (age < numColumns)
+        {
+            const int index = (nextColumn - 1 - age + MAX_COLUMNS) % MAX_COLUMNS;
+            drawColumn(g, x, columns[static_cast<size_t>(index)]);
+        }
+        else
+        {
+            drawColumn(g, x, Column{});
+        }
+    }
+}
+
+// Both in image pixels
+float HistoryGraph::gainToY(float dB) const
+{
+    // 0 dB GR at the top, MAX_GR_DB at the bottom
+    return juce::jlimit(0.0f, 1.0f, -dB / MAX_GR_DB) * static_cast<float>(historyImage.getHeight());
+}
+
+float HistoryGraph::levelToY(float dB) const
+{
+    // 0 dBFS at the top, MIN_LEVEL_DB at the bottom
+    return juce::jlimit(0.0f, 1.0f, dB / MIN_LEVEL_DB) * static_cast<float>(historyImage.getHeight());
+}
+
+void HistoryGraph::drawColumn(juce::Graphics& g, int x, const Column& column) const
+{
+    const float height = static_cast<float>(historyImage.getHeight());
+    const float left = static_cast<float>(x * columnPixels);
+    const float width = static_cast<float>(columnPixels);
+    const float line = juce::jmax(1.0f, std::round(renderScale));
+
+    // Background
+    g.setColour(juce::Colour(0xFF151515));
+    g.fillRect(left, 0.0f, width, height);
+
+    // Level grid every 12 dB (drawn per column, so it scrolls with the data)
+    g.setColour(juce::Colour(0xFF2A2A2A));
+    for (float dB = -12.0f; dB > MIN_LEVEL_DB; dB -= 12.0f)
+        g.fillRect(left, levelToY(dB), width, line);
+
+    // Input peak and RMS, rising from the bottom
+    g.setColour(juce::Colour(0xFF3A3A3A));
+    g.fillRect(left, levelToY(column.inputPeakDb), width, height - levelToY(column.inputPeakDb));
+    g.setColour(juce::Colour(0xFF555555));
+    g.fillRect(left, levelToY(column.inputRmsDb), width, height - levelToY(column.inputRmsDb));
+
+    // Output RMS and peak marks
+    g.setColour(juce::Colour(0xFF007700));
+    g.fillRect(left, levelToY(column.outputRmsDb) - line, width, 2.0f * line);
+    g.setColour(juce::Colour(0xFF00DD00));
+    g.fillRect(left, levelToY(column.outputPeakDb), width, line);
+
+    // Gain reduction hanging from the top: solid to the shallowest, lighter to the deepest
+    g.setColour(juce::Colour(0xFFFF3300).withAlpha(0.85f));
+    g.fillRect(left, 0.0f, width, gainToY(column.maxGainDb));
+    g.setColour(juce::Colour(0xFFFFAA00).withAlpha(0.6f));
+    g.fillRect(left, gainToY(column.maxGainDb), width, gainToY(column.minGainDb) - gainToY(column.maxGainDb));
+}
+
+void HistoryGraph::paint(juce::Graphics& g)
+{
+    // A new display scale is picked up by the next update(); until then the
+    // current image is drawn scaled
+    const auto scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (! juce::approximatelyEqual(scaleFactor, renderScale))
+    {
+        renderScale = scaleFactor;
+        needsFullRedraw = true;
+    }
+
+    if (historyImage.isValid())
+        g.drawImage(historyImage, getLocalBounds().toFloat());
+    else
+        g.fillAll(juce::Colour(0xFF151515));
+
+    // Legend
+    const float k = static_cast<float>(getHeight()) / 120.0f;
+    auto textArea = getLocalBounds().reduced(juce::roundToInt(4.0f * k), juce::roundToInt(2.0f * k));
+    g.setFont(sharedResources->getFont(9.0f * k));
+    g.setColour(juce::Colour(0xFFFF6600));
+    g.drawText("GR", textArea, juce::Justification::topLeft);
+    g.setColour(juce::Colour(0xFF00DD00));
+    g.drawText("OUT", textArea, juce::Justification::bottomLeft);
+    g.setColour(juce::Colour(0xFF888888));
+    g.drawText(juce::String(static_cast<int>(getWidth() * COLUMN_MS / 1000.0)) + " s",
+               textArea, juce::Justification::bottomRight);
+
+    g.setColour(juce::Colour(0xFF0A0A0A));
+    g.drawRect(getLocalBounds(), 2);
+}
+
+void HistoryGraph::resized()
+{
+    needsFullRedraw = true;
+    update();
+}
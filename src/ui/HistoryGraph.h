@@ -0,0 +1,79 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "SharedGuiResources.h"
+#include "../dsp/BlockTelemetry.h"
+#include <array>
+
+/**
+ * Scrolling Gain Reduction / Level History
+ *
+ * Shows the last several seconds of metering as fixed-duration columns:
+ * - Gain reduction hanging from the top (deepest and shallowest per column)
+ * - Input peak/RMS and output peak/RMS rising from the bottom
+ *
+ * Columns are drawn into a cached image once; each update scrolls the image
+ * left and draws only the columns completed since the previous update. The
+ * image is kept at the physical pixel size of the last paint, with each column
+ * a whole number of pixels wide so scrolling stays exact at any scale.
+ */
+class HistoryGraph : public juce::Component
+{
+public:
+    HistoryGraph();
+    ~HistoryGraph() override = default;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    // Accumulates one audio block into the current column (message thread)
+    void addFrame(const BlockTelemetry& frame, double sampleRate);
+
+    // Draws newly completed columns into the cached image and repaints
+    void update();
+
+private:
+    struct Column
+    {
+        float minGainDb = 0.0f;
+        float maxGainDb = 0.0f;
+        float inputPeakDb = MIN_LEVEL_DB;
+        float inputRmsDb = MIN_LEVEL_DB;
+        float outputPeakDb = MIN_LEVEL_DB;
+        float outputRmsDb = MIN_LEVEL_DB;
+    };
+
+    void drawColumn(juce::Graphics& g, int x, const Column& column) const;
+    void redrawAll();
+    float gainToY(float dB) const;
+    float levelToY(float dB) const;
+
+    // Timing and ranges
+    static constexpr double COLUMN_MS = 100.0;
+    static constexpr int MAX_COLUMNS = 1024;
+    static constexpr float MAX_GR_DB = 20.0f;
+    static constexpr float MIN_LEVEL_DB = -60.0f;
+
+    // Column ring (kept so a resize or re-show can redraw without losing history)
+    std::array<Column, MAX_COLUMNS> columns;
+    int nextColumn = 0;
+    int numColumns = 0;
+    int columnsToDraw = 0;
+    bool needsFullRedraw = true;
+
+    // Column being accumulated
+    float pendingMinGainDb = 0.0f;
+    float pendingMaxGainDb = -1000.0f;
+    float pendingInputPeak = 0.0f;
+    float pendingOutputPeak = 0.0f;
+    double pendingInputSumSquares = 0.0;
+    double pendingOutputSumSquares = 0.0;
+    int pendingSamples = 0;
+
+    juce::Image historyImage;
+    float renderScale = 1.0f;   // Physical pixels per logical pixel, as last painted
+    int columnPixels = 1;       // Image pixels per column
+    juce::SharedResourcePointer<SharedGuiResources> sharedResources;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HistoryGraph)
+};
@@ -1,6 +1,8 @@
 #include "LA2ALookAndFeel.h"
+#include "RasterCache.h"
 
-LA2ALookAndFeel::LA2ALookAndFeel()
+LA2ALookAndFeel::LA2ALookAndFeel(RasterCache* cache)
+    : rasterCache(cache)
 {
     setColour(juce::Label::textColourId, TEXT_DARK);
     setColour(juce::Slider::textBoxTextColourId, TEXT_DARK);
@@ -10,7 +12,7 @@ LA2ALookAndFeel::LA2ALookAndFeel()
 
 void LA2ALookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
                                        float sliderPos, float rotaryStartAngle,
-                                       float rotaryEndAngle, juce::Slider& /*slider*/)
+                                       float rotaryEndAngle, juce::Slider& slider)
 {
     auto bounds = juce::Rectangle<int>(x, y, width, height).toFloat();
     auto centerX = bounds.getCentreX();
@@ -27,11 +29,42 @@ void LA2ALookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int widt
 
     auto angle = startAngle + sliderPos * (endAngle - startAngle);
 
-    drawDialKnob(g, centerX, centerY, radius, angle, sliderPos);
+    if (rasterCache == nullptr)
+    {
+        drawDialKnob(g, centerX, centerY, radius, angle, sliderPos);
+        return;
+    }
+
+    // The face doesn't move, so it is rasterised (off the message thread) and only
+    // the pointer is drawn live. While a new size renders, the old face is scaled.
+    const auto scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+    juce::Component::SafePointer<juce::Slider> safeSlider(&slider);
+
+    auto face = rasterCache->getImageAsync("knob/dial", width, height, scaleFactor,
+                                           [w = static_cast<float>(width), h = static_cast<float>(height), radius](juce::Graphics& fg) {
+                                               drawDialFace(fg, w / 2.0f, h / 2.0f, radius);
+                                           },
+                                           [safeSlider] {
+                                               if (safeSlider != nullptr)
+                                                   safeSlider->repaint();
+                                           });
+
+    if (face.isValid())
+        g.drawImage(face, bounds);
+    else
+        drawDialFace(g, centerX, centerY, radius);
+
+    drawDialPointer(g, centerX, centerY, radius, angle);
 }
 
 void LA2ALookAndFeel::drawDialKnob(juce::Graphics& g, float centerX, float centerY,
-                                    float radius, float angle, float sliderPos)
+                                    float radius, float angle, float /*sliderPos*/)
+{
+    drawDialFace(g, centerX, centerY, radius);
+    drawDialPointer(g, centerX, centerY, radius, angle);
+}
+
+void LA2ALookAndFeel::drawDialFace(juce::Graphics& g, float centerX, float centerY, float radius)
 {
     // Custom range for scale drawing
     constexpr float startAngle = -5.0f * juce::MathConstants<float>::pi / 6.0f;
@@ -97,6 +130,13 @@ void LA2ALookAndFeel::drawDialKnob(juce::Graphics& g, float centerX, float cente
     g.setColour(juce::Colour(0x20FFFFFF));
     g.drawEllipse(centerX - knobRadius + 1.0f, centerY - knobRadius + 1.0f,
                   knobRadius * 2.0f - 2.0f, knobRadius * 2.0f - 2.0f, 1.5f);
+}
+
+void LA2ALookAndFeel::drawDialPointer(juce::Graphics& g, float centerX, float centerY,
+                                      float radius, float angle)
+{
+    float scaleRingOuter = radius - 3.0f;
+    float knobRadius = radius * 0.65f - 4.0f;
 
     // Red pointer/indicator line
     float pointerLength = scaleRingOuter - 4.0f;
@@ -138,7 +178,7 @@ void LA2ALookAndFeel::drawLinearSlider(juce::Graphics& g, int x, int y, int widt
 
     if (isHorizontal)
     {
-        float trackHeight = 6.0f;
+        float trackHeight = height * 0.3f;
         float trackY = bounds.getCentreY() - trackHeight / 2.0f;
 
         // Track background - dark
@@ -160,7 +200,7 @@ void LA2ALookAndFeel::drawLinearSlider(juce::Graphics& g, int x, int y, int widt
         }
 
         // Fader thumb - black with gradient
-        float thumbWidth = 14.0f;
+        float thumbWidth = height * 0.7f;
         float thumbHeight = height * 0.9f;
         float thumbX = sliderPos - thumbWidth / 2.0f;
         float thumbY = bounds.getCentreY() - thumbHeight / 2.0f;
@@ -241,7 +281,7 @@ void LA2ALookAndFeel::drawToggleButton(juce::Graphics& g, juce::ToggleButton& bu
 
     // Button text
     g.setColour(isOn ? juce::Colour(0xFF1A1A1A) : juce::Colour(0xFF888888));
-    g.setFont(juce::Font(juce::FontOptions(11.0f).withStyle("Bold")));
+    g.setFont(getPanelFont(bounds.getHeight() * 0.55f, juce::Font::bold));
     g.drawText(button.getButtonText(), bounds.toNearestInt(), juce::Justification::centred);
 }
 
@@ -256,5 +296,20 @@ void LA2ALookAndFeel::drawLabel(juce::Graphics& g, juce::Label& label)
 
 juce::Font LA2ALookAndFeel::getLabelFont(juce::Label& label)
 {
-    return juce::Font(label.getFont().getHeight(), juce::Font::bold);
+    return getPanelFont(label.getFont().getHeight(), juce::Font::bold);
+}
+
+void LA2ALookAndFeel::loadPanelTypefaces()
+{
+    for (const int styleFlags : { juce::Font::plain, juce::Font::bold })
+        typefaces[static_cast<size_t>(styleFlags)] = juce::Font(juce::FontOptions(12.0f, styleFlags)).getTypefacePtr();
+}
+
+juce::Font LA2ALookAndFeel::getPanelFont(float height, int styleFlags) const
+{
+    if (juce::isPositiveAndBelow(styleFlags, static_cast<int>(typefaces.size())))
+        if (const auto& typeface = typefaces[static_cast<size_t>(styleFlags)])
+            return juce::Font(juce::FontOptions(typeface).withHeight(height));
+
+    return juce::Font(juce::FontOptions(height, styleFlags));
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <array>
+
+class RasterCache;
 
 /**
  * LA-2A Vintage Look and Feel
@@ -9,11 +12,14 @@
  * - Silver/gray metal faceplate
  * - Black bakelite knobs with white pointer
  * - Vintage toggle switches
+ *
+ * Sizes are derived from the component bounds so the editor can scale. When
+ * given a RasterCache, the static knob face is rasterised once per size.
  */
 class LA2ALookAndFeel : public juce::LookAndFeel_V4
 {
 public:
-    LA2ALookAndFeel();
+    explicit LA2ALookAndFeel(RasterCache* rasterCache = nullptr);
     ~LA2ALookAndFeel() override = default;
 
     // Colors - Silver/Gray LA-2A scheme
@@ -46,11 +52,27 @@ public:
 
     juce::Font getLabelFont(juce::Label& label) override;
 
+    // Resolves the plain and bold panel typefaces. Call once, on the message
+    // thread, before the look-and-feel is shared (SharedGuiResources does).
+    void loadPanelTypefaces();
+
+    // Panel font from the loaded typefaces; safe on any thread once they are
+    // loaded. Other styles, or a call before loading, resolve the typeface each time.
+    juce::Font getPanelFont(float height, int styleFlags = juce::Font::plain) const;
+
 private:
+    static void drawDialFace(juce::Graphics& g, float centerX, float centerY, float radius);
+    static void drawDialPointer(juce::Graphics& g, float centerX, float centerY,
+                                float radius, float angle);
     void drawDialKnob(juce::Graphics& g, float centerX, float centerY,
                       float radius, float angle, float sliderPos);
     void drawBakeliteKnob(juce::Graphics& g, float centerX, float centerY,
                           float radius, float angle);
 
+    // Typefaces indexed by juce::Font style flags; written only by loadPanelTypefaces()
+    std::array<juce::Typeface::Ptr, 2> typefaces;
+
+    RasterCache* rasterCache = nullptr;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LA2ALookAndFeel)
 };
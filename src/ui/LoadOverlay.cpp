@@ -0,0 +1,64 @@
+#include "LoadOverlay.h"
+
+LoadOverlay::LoadOverlay()
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+juce::String LoadOverlay::formatNs(double ns)
+{
+    if (ns >= 1.0e6)
+        return juce::String(ns * 1.0e-6, 2) + " ms";
+
+    return juce::String(ns * 1.0e-3, 1) + " us";
+}
+
+void LoadOverlay::setStats(const DspLoadMonitor::Stats& stats)
+{
+    juce::StringArray newLines;
+    newLines.add("DSP " + juce::String(stats.loadProportion * 100.0, 1) + "%  overruns "
+                 + juce::String(stats.overruns));
+    newLines.add("p50 " + formatNs(stats.p50Ns) + "  p99 " + formatNs(stats.p99Ns));
+    newLines.add("worst " + formatNs(stats.worstNs) + " ("
+                 + juce::String(stats.worstBudgetProportion * 100.0, 1) + "% of block)");
+    newLines.add(juce::String(stats.lastBlockSize) + " smp (max " + juce::String(stats.maxBlockSize) + ") @ "
+                 + juce::String(stats.sampleRate / 1000.0, 1) + " kHz");
+
+    if (newLines == lines)
+        return;
+
+    lines = newLines;
+    repaint();
+}
+
+void LoadOverlay::setInputInfo(int numChannels, float peak)
+{
+    auto newLine = "in " + juce::String(numChannels) + " ch  peak " + juce::String(peak, 3);
+
+    if (newLine == inputLine)
+        return;
+
+    inputLine = newLine;
+    repaint();
+}
+
+void LoadOverlay::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+    const float k = bounds.getHeight() / 80.0f;
+
+    g.setColour(juce::Colour(0xD0101010));
+    g.fillRoundedRectangle(bounds, 4.0f * k);
+
+    g.setColour(juce::Colour(0xFF00DD00));
+    g.setFont(sharedResources->getFont(10.0f * k));
+
+    auto textArea = bounds.reduced(6.0f * k, 4.0f * k);
+    const float lineHeight = textArea.getHeight() / 5.0f;
+
+    for (const auto& line : lines)
+        g.drawText(line, textArea.removeFromTop(lineHeight), juce::Justification::centredLeft);
+
+    g.setColour(juce::Colour(0xFF888888));
+    g.drawText(inputLine, textArea.removeFromTop(lineHeight), juce::Justification::centredLeft);
+}
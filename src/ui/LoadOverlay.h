@@ -0,0 +1,35 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "SharedGuiResources.h"
+#include "../dsp/DspLoadMonitor.h"
+
+/**
+ * DSP Load Overlay
+ *
+ * Translucent panel listing this instance's audio thread statistics
+ * (load, overruns, block time percentiles, worst share of the block budget
+ * and block size / sample rate context). Toggled from the editor; it does
+ * not intercept mouse clicks.
+ */
+class LoadOverlay : public juce::Component
+{
+public:
+    LoadOverlay();
+    ~LoadOverlay() override = default;
+
+    void paint(juce::Graphics& g) override;
+
+    void setStats(const DspLoadMonitor::Stats& stats);
+    void setInputInfo(int numChannels, float peak);
+
+private:
+    static juce::String formatNs(double ns);
+
+    juce::StringArray lines;
+    juce::String inputLine;
+
+    juce::SharedResourcePointer<SharedGuiResources> sharedResources;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoadOverlay)
+};
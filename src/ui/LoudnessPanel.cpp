@@ -0,0 +1,77 @@
+#include "LoudnessPanel.h"
+
+namespace
+{
+    const char* const rowLabels[] = { "M", "S", "I", "LRA" };
+    const char* const rowUnits[] = { "LUFS", "LUFS", "LUFS", "LU" };
+}
+
+LoudnessPanel::LoudnessPanel()
+{
+    setOpaque(true);
+    setReadings({});
+}
+
+juce::String LoudnessPanel::formatLufs(float lufs)
+{
+    return lufs > LoudnessMeter::NO_LOUDNESS ? juce::String(lufs, 1) : juce::String("--");
+}
+
+void LoudnessPanel::setReadings(const LoudnessMeter::Readings& readings)
+{
+    juce::StringArray newValues;
+    newValues.add(formatLufs(readings.momentaryLufs));
+    newValues.add(formatLufs(readings.shortTermLufs));
+    newValues.add(formatLufs(readings.integratedLufs));
+    newValues.add(juce::String(readings.loudnessRange, 1));
+
+    const int seconds = static_cast<int>(readings.measuredSeconds);
+    newValues.add(juce::String(seconds / 60) + ":" + juce::String(seconds % 60).paddedLeft('0', 2));
+
+    if (newValues == values)
+        return;
+
+    values = newValues;
+    repaint();
+}
+
+void LoudnessPanel::mouseDown(const juce::MouseEvent&)
+{
+    if (onReset != nullptr)
+        onReset();
+}
+
+void LoudnessPanel::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+    const float k = bounds.getHeight() / 120.0f;
+
+    g.fillAll(juce::Colour(0xFF101010));
+
+    auto area = bounds.reduced(8.0f * k, 6.0f * k);
+    auto footer = area.removeFromBottom(14.0f * k);
+    const float rowHeight = area.getHeight() / 4.0f;
+
+    for (int row = 0; row < 4; ++row)
+    {
+        auto rowArea = area.removeFromTop(rowHeight);
+
+        // Integrated is the headline value
+        const bool headline = row == 2;
+        g.setColour(headline ? juce::Colour(0xFF00DD00) : juce::Colour(0xFF88CC88));
+
+        g.setFont(sharedResources->getFont(11.0f * k, juce::Font::bold));
+        g.drawText(rowLabels[row], rowArea.removeFromLeft(32.0f * k), juce::Justification::centredLeft);
+
+        g.setFont(sharedResources->getFont(10.0f * k));
+        g.drawText(rowUnits[row], rowArea.removeFromRight(34.0f * k), juce::Justification::centredRight);
+
+        g.setFont(sharedResources->getFont((headline ? 20.0f : 15.0f) * k, juce::Font::bold));
+        g.drawText(values[row], rowArea, juce::Justification::centredRight);
+    }
+
+    g.setColour(juce::Colour(0xFF888888));
+    g.setFont(sharedResources->getFont(9.0f * k));
+    g.drawText(values[4], footer, juce::Justification::centredLeft);
+    g.drawText("click to reset", footer, juce::Justification::centredRight);
+}
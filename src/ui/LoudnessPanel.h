@@ -0,0 +1,37 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "SharedGuiResources.h"
+#include "../dsp/LoudnessMeter.h"
+#include <functional>
+
+/**
+ * Loudness Readout
+ *
+ * Shown in place of the VU meter: momentary, short-term and integrated
+ * loudness (LUFS), loudness range (LU) and the integration time. Clicking
+ * the panel calls onReset to restart the integrated measurement.
+ */
+class LoudnessPanel : public juce::Component
+{
+public:
+    LoudnessPanel();
+    ~LoudnessPanel() override = default;
+
+    void paint(juce::Graphics& g) override;
+    void mouseDown(const juce::MouseEvent& event) override;
+
+    // Repaints only if the displayed text changes
+    void setReadings(const LoudnessMeter::Readings& readings);
+
+    std::function<void()> onReset;
+
+private:
+    static juce::String formatLufs(float lufs);
+
+    juce::StringArray values;
+
+    juce::SharedResourcePointer<SharedGuiResources> sharedResources;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessPanel)
+};
@@ -0,0 +1,211 @@
+#include "RasterCache.h"
+#include <algorithm>
+
+RasterCache::RasterCache()
+{
+}
+
+RasterCache::~RasterCache()
+{
+    waitForPendingRenders();
+}
+
+void RasterCache::waitForPendingRenders()
+{
+    // Painters only use captured values, so in-flight renders can simply finish
+    renderPool.removeAllJobs(true, 5000);
+}
+
+juce::Image RasterCache::render(const Request& request)
+{
+    const int physicalWidth = juce::roundToInt(static_cast<float>(request.width) * request.scaleFactor);
+    const int physicalHeight = juce::roundToInt(static_cast<float>(request.height) * request.scaleFactor);
+
+    // Software images can be rendered on any thread
+    juce::Image image(juce::Image::ARGB, physicalWidth, physicalHeight, true, juce::SoftwareImageType());
+
+    juce::Graphics g(image);
+    g.addTransform(juce::AffineTransform::scale(static_cast<float>(physicalWidth) / static_cast<float>(request.width),
+                                                static_cast<float>(physicalHeight) / static_cast<float>(request.height)));
+    request.painter(g);
+
+    return image;
+}
+
+RasterCache::Key RasterCache::makeKey(const juce::String& name, int width, int height, float scaleFactor)
+{
+    return { name, scaleKey(scaleFactor),
+             juce::roundToInt(static_cast<float>(width) * scaleFactor),
+             juce::roundToInt(static_cast<float>(height) * scaleFactor) };
+}
+
+juce::Image RasterCache::findExact(const juce::String& name, int width, int height, float scaleFactor)
+{
+    auto entry = entries.find(makeKey(name, width, height, scaleFactor));
+    if (entry == entries.end())
+        return {};
+
+    entry->second.lastUse = ++useCounter;
+    return entry->second.image;
+}
+
+juce::Image RasterCache::findAnySize(const juce::String& name, float scaleFactor) const
+{
+    const Entry* latest = nullptr;
+
+    for (auto it = entries.lower_bound({ name, scaleKey(scaleFactor), 0, 0 });
+         it != entries.end() && it->first.name == name && it->first.scale == scaleKey(scaleFactor); ++it)
+    {
+        if (latest == nullptr || it->second.lastUse > latest->lastUse)
+            latest = &it->second;
+    }
+
+    return latest != nullptr ? latest->image : juce::Image();
+}
+
+void RasterCache::store(const Request& request, juce::Image image)
+{
+    const auto key = makeKey(request.name, request.width, request.height, request.scaleFactor);
+    entries[key] = { std::move(image), ++useCounter };
+
+    // Evict the least recently used sizes beyond the cap for this name and scale
+    for (;;)
+    {
+        int numSizes = 0;
+        auto oldest = entries.end();
+
+        for (auto it = entries.lower_bound({ key.name, key.scale, 0, 0 });
+             it != entries.end() && it->first.name == key.name && it->first.scale == key.scale; ++it)
+        {
+            ++numSizes;
+
+            if (oldest == entries.end() || it->second.lastUse < oldest->second.lastUse)
+                oldest = it;
+        }
+
+        if (numSizes <= MAX_SIZES_PER_NAME)
+            break;
+
+        entries.erase(oldest);
+    }
+}
+
+juce::Image RasterCache::getImage(const juce::String& name, int width, int height,
+                                  float scaleFactor, const Painter& painter)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (width <= 0 || height <= 0)
+        return {};
+
+    if (auto image = findExact(name, width, height, scaleFactor); image.isValid())
+        return image;
+
+    Request request { name, width, height, scaleFactor, painter };
+    auto image = render(request);
+    store(request, image);
+    return image;
+}
+
+juce::Image RasterCache::getImageAsync(const juce::String& name, int width, int height,
+                                       float scaleFactor, Painter painter, std::function<void()> onReady)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (width <= 0 || height <= 0)
+        return {};
+
+    if (auto image = findExact(name, width, height, scaleFactor); image.isValid())
+        return image;
+
+    auto jobKey = name + "@" + juce::String(scaleKey(scaleFactor));
+    auto& job = jobs[jobKey];
+    Request request { name, width, height, scaleFactor, std::move(painter) };
+
+    if (onReady != nullptr)
+        job.waiters.push_back(std::move(onReady));
+
+    if (! job.inFlight)
+        launch(jobKey, std::move(request));
+    else if (job.running.isSameSize(request))
+        job.next.reset();       // Back to the size being rendered: a queued one is stale
+    else
+        job.next = std::make_unique<Request>(std::move(request));  // Only the latest size matters
+
+    return findAnySize(name, scaleFactor);
+}
+
+void RasterCache::launch(const juce::String& jobKey, Request request)
+{
+    auto& job = jobs[jobKey];
+    job.inFlight = true;
+    job.running = request;
+
+    juce::WeakReference<RasterCache> weakThis(this);
+
+    renderPool.addJob([weakThis, jobKey, request = std::move(request)]() mutable {
+        auto image = render(request);
+
+        juce::MessageManager::callAsync([weakThis, jobKey, request = std::move(request), image]() mutable {
+            if (auto* cache = weakThis.get())
+                cache->jobFinished(jobKey, request, std::move(image));
+        });
+    });
+}
+
+void RasterCache::jobFinished(const juce::String& jobKey, const Request& request, juce::Image image)
+{
+    store(request, std::move(image));
+
+    auto& job = jobs[jobKey];
+    job.inFlight = false;
+
+    auto waiters = std::move(job.waiters);
+    job.waiters.clear();
+
+    // A queued size that has just been rendered, or is cached already, is dropped
+    if (job.next != nullptr)
+    {
+        auto next = std::move(job.next);
+
+        if (! next->isSameSize(request) && ! findExact(next->name, next->width, next->height, next->scaleFactor).isValid())
+            launch(jobKey, std::move(*next));
+    }
+
+    for (auto& waiter : waiters)
+        waiter();
+}
+
+void RasterCache::invalidate(const juce::String& prefix)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->first.name.startsWith(prefix))
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+size_t RasterCache::getCachedImageBytes() const
+{
+    size_t bytes = 0;
+
+    for (const auto& [key, entry] : entries)
+        if (entry.image.isValid())
+            bytes += static_cast<size_t>(entry.image.getWidth()) * static_cast<size_t>(entry.image.getHeight()) * 4;
+
+    return bytes;
+}
+
+int RasterCache::getNumPendingRenders() const
+{
+    return static_cast<int>(std::count_if(jobs.begin(), jobs.end(), [](const auto& job) { return job.second.inFlight; }));
+}
+
+int RasterCache::getNumCachedImages() const
+{
+    return static_cast<int>(entries.size());
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <vector>
+
+/**
+ * Named raster cache keyed by pixel size and scale factor
+ *
+ * Rasters are stored per name, pixel size and display scale factor. Each name
+ * keeps its MAX_SIZES_PER_NAME most recently used sizes per scale, so editors
+ * open at different sizes each keep theirs while sizes passed through during a
+ * drag-resize are evicted. Rasters can be rendered synchronously, or on a
+ * background thread while callers keep drawing the previous raster scaled.
+ *
+ * All methods must be called on the message thread. Painters run on the
+ * background thread for async requests, so they must only use captured values.
+ */
+class RasterCache
+{
+public:
+    using Painter = std::function<void(juce::Graphics&)>;
+
+    // Sizes kept per name and scale factor, least recently used evicted first
+    static constexpr int MAX_SIZES_PER_NAME = 4;
+
+    RasterCache();
+    ~RasterCache();
+
+    // Returns the raster for name at the given logical size and scale,
+    // rendering it on this thread on a cache miss
+    juce::Image getImage(const juce::String& name, int width, int height,
+                         float scaleFactor, const Painter& painter);
+
+    // Returns the raster for name if it is cached at exactly this size and scale.
+    // Otherwise queues a background render and returns the most recently used
+    // raster for name at any size (invalid if there is none); onReady is called
+    // on the message thread once the new raster is stored.
+    juce::Image getImageAsync(const juce::String& name, int width, int height,
+                              float scaleFactor, Painter painter, std::function<void()> onReady);
+
+    // True if name has a raster at this scale factor (of any size)
+    bool contains(const juce::String& name, float scaleFactor) const
+    {
+        return findAnySize(name, scaleFactor).isValid();
+    }
+
+    // Blocks until background renders have finished (their results are discarded)
+    void waitForPendingRenders();
+
+    // Background renders whose result hasn't been stored yet
+    int getNumPendingRenders() const;
+
+    // Drops every cached raster whose name starts with prefix (all scales)
+    void invalidate(const juce::String& prefix);
+
+    // Memory reporting
+    size_t getCachedImageBytes() const;
+    int getNumCachedImages() const;
+
+private:
+    struct Request
+    {
+        juce::String name;
+        int width = 0;
+        int height = 0;
+        float scaleFactor = 1.0f;
+        Painter painter;
+
+        bool isSameSize(const Request& other) const
+        {
+            return width == other.width && height == other.height;
+        }
+    };
+
+    struct Key
+    {
+        juce::String name;
+        int scale = 100;            // scaleKey()
+        int pixelWidth = 0;
+        int pixelHeight = 0;
+
+        bool operator<(const Key& other) const
+        {
+            return std::tie(name, scale, pixelWidth, pixelHeight)
+                 < std::tie(other.name, other.scale, other.pixelWidth, other.pixelHeight);
+        }
+    };
+
+    struct Entry
+    {
+        juce::Image image;
+        juce::uint64 lastUse = 0;
+    };
+
+    struct Job
+    {
+        bool inFlight = false;
+        Request running;
+        std::unique_ptr<Request> next;  // Latest request that arrived while running
+        std::vector<std::function<void()>> waiters;
+    };
+
+    static int scaleKey(float scaleFactor) { return juce::roundToInt(scaleFactor * 100.0f); }
+    static Key makeKey(const juce::String& name, int width, int height, float scaleFactor);
+    static juce::Image render(const Request& request);
+
+    juce::Image findExact(const juce::String& name, int width, int height, float scaleFactor);
+    juce::Image findAnySize(const juce::String& name, float scaleFactor) const;
+    void store(const Request& request, juce::Image image);
+    void launch(const juce::String& jobKey, Request request);
+    void jobFinished(const juce::String& jobKey, const Request& request, juce::Image image);
+
+    std::map<Key, Entry> entries;
+    std::map<juce::String, Job> jobs;       // Keyed by name@scale
+    juce::uint64 useCounter = 0;
+
+    juce::ThreadPool renderPool { juce::ThreadPoolOptions{}
+                                      .withThreadName("LA2A raster cache")
+                                      .withNumberOfThreads(1) };
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(RasterCache)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RasterCache)
+};
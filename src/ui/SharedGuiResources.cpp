@@ -0,0 +1,14 @@
+#include "SharedGuiResources.h"
+
+SharedGuiResources::SharedGuiResources()
+{
+    // Loaded here, on the message thread, so getFont() never resolves a
+    // typeface on the analysis thread or in a background painter
+    lookAndFeel.loadPanelTypefaces();
+}
+
+SharedGuiResources::~SharedGuiResources()
+{
+    // Background painters may still be using the look-and-feel's fonts
+    rasterCache.waitForPendingRenders();
+}
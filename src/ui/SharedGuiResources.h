@@ -0,0 +1,60 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "LA2ALookAndFeel.h"
+#include "RasterCache.h"
+
+/**
+ * Process-wide GUI resources shared by every open editor
+ *
+ * Held through juce::SharedResourcePointer, so the first editor creates it and
+ * the last one to close destroys it. Owns:
+ * - The LA2ALookAndFeel (and with it the panel typefaces, loaded when this is
+ *   constructed)
+ * - The raster cache, keyed by pixel size and display scale factor
+ *
+ * Construct it on the message thread. getFont() is safe on any thread (the
+ * analysis thread and the background raster painters use it); everything
+ * else must be called on the message thread.
+ */
+class SharedGuiResources
+{
+public:
+    SharedGuiResources();
+    ~SharedGuiResources();
+
+    LA2ALookAndFeel& getLookAndFeel() { return lookAndFeel; }
+    RasterCache& getRasterCache() { return rasterCache; }
+
+    // Any thread
+    juce::Font getFont(float height, int styleFlags = juce::Font::plain) const
+    {
+        return lookAndFeel.getPanelFont(height, styleFlags);
+    }
+
+    using Painter = RasterCache::Painter;
+
+    // See RasterCache::getImage()
+    juce::Image getCachedImage(const juce::String& name, int width, int height,
+                               float scaleFactor, const Painter& painter)
+    {
+        return rasterCache.getImage(name, width, height, scaleFactor, painter);
+    }
+
+    // See RasterCache::getImageAsync()
+    juce::Image getCachedImageAsync(const juce::String& name, int width, int height,
+                                    float scaleFactor, Painter painter, std::function<void()> onReady)
+    {
+        return rasterCache.getImageAsync(name, width, height, scaleFactor, std::move(painter), std::move(onReady));
+    }
+
+    // Memory reporting
+    size_t getCachedImageBytes() const { return rasterCache.getCachedImageBytes(); }
+    int getNumCachedImages() const { return rasterCache.getNumCachedImages(); }
+
+private:
+    RasterCache rasterCache;              // Declared first: the look-and-feel renders into it
+    LA2ALookAndFeel lookAndFeel { &rasterCache };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedGuiResources)
+};
@@ -47,7 +47,79 @@ float VUMeter::levelToAngle(float dB)
 
 void VUMeter::paint(juce::Graphics& g)
 {
-    auto bounds = getLocalBounds().toFloat().reduced(2.0f);
+    const auto scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto localBounds = getLocalBounds().toFloat();
+    auto innerBounds = getInnerBounds(localBounds);
+    const int numLit = getNumLitSegments();
+
+    auto dimLayer = requestLayer("vumeter/dim", scaleFactor, false);
+    auto litLayer = requestLayer("vumeter/lit", scaleFactor, true);
+
+    if (dimLayer.isValid() && litLayer.isValid())
+    {
+        g.drawImage(dimLayer, localBounds);
+
+        if (numLit > 0)
+        {
+            // Reveal the lit arc up to halfway between the last lit and first dark segment
+            auto geometry = computeGeometry(innerBounds);
+            float boundary = (static_cast<float>(numLit) - 0.5f) / (NUM_SEGMENTS - 1);
+            float endAngle = ARC_START_DEGREES + boundary * (ARC_END_DEGREES - ARC_START_DEGREES);
+            float wedgeRadius = geometry.arcRadius + geometry.segmentHeight * 2.0f;
+
+            juce::Path wedge;
+            wedge.addPieSegment(geometry.centerX - wedgeRadius, geometry.centerY - wedgeRadius,
+                                wedgeRadius * 2.0f, wedgeRadius * 2.0f,
+                                juce::degreesToRadians(ARC_START_DEGREES - 10.0f),
+                                juce::degreesToRadians(endAngle), 0.0f);
+
+            g.saveState();
+            g.reduceClipRegion(wedge);
+            g.drawImage(litLayer, localBounds);
+            g.restoreState();
+        }
+    }
+    else
+    {
+        // First frame: draw the vector meter while the atlas renders
+        drawStaticLayer(g, localBounds, *sharedResources);
+        drawSegments(g, innerBounds, numLit, true);
+    }
+
+    drawModeText(g, innerBounds);
+}
+
+juce::Image VUMeter::requestLayer(const juce::String& name, float scaleFactor, bool lit)
+{
+    auto localBounds = getLocalBounds().toFloat();
+    auto* resources = &sharedResources.get();
+    juce::Component::SafePointer<VUMeter> safeThis(this);
+
+    SharedGuiResources::Painter painter;
+    if (lit)
+        painter = [innerBounds = getInnerBounds(localBounds)](juce::Graphics& g) {
+            drawSegments(g, innerBounds, NUM_SEGMENTS, true);
+        };
+    else
+        painter = [localBounds, resources](juce::Graphics& g) {
+            drawStaticLayer(g, localBounds, *resources);
+        };
+
+    return sharedResources->getCachedImageAsync(name, getWidth(), getHeight(), scaleFactor, std::move(painter),
+                                                [safeThis] {
+                                                    if (safeThis != nullptr)
+                                                        safeThis->repaint();
+                                                });
+}
+
+juce::Rectangle<float> VUMeter::getInnerBounds(juce::Rectangle<float> localBounds)
+{
+    return localBounds.reduced(2.0f).reduced(3.0f);
+}
+
+void VUMeter::drawStaticLayer(juce::Graphics& g, juce::Rectangle<float> localBounds, SharedGuiResources& resources)
+{
+    auto bounds = localBounds.reduced(2.0f);
 
     // Dark background
     g.setColour(juce::Colour(0xFF0A0A0A));
@@ -58,7 +130,7 @@ void VUMeter::paint(juce::Graphics& g)
     g.setColour(juce::Colour(0xFF151515));
     g.fillRoundedRectangle(innerBounds, 4.0f);
 
-    drawDorroughMeter(g, innerBounds);
+    drawDorroughMeter(g, innerBounds, resources);
 }
 
 void VUMeter::drawMeterFace(juce::Graphics& g, juce::Rectangle<float> bounds)
@@ -83,42 +155,58 @@ void VUMeter::drawNeedle(juce::Graphics& g, juce::Rectangle<float> bounds, float
     (void)angle;
 }
 
-void VUMeter::drawDorroughMeter(juce::Graphics& g, juce::Rectangle<float> bounds)
+VUMeter::ArcGeometry VUMeter::computeGeometry(juce::Rectangle<float> bounds)
 {
-    auto centerX = bounds.getCentreX();
-
-    // Calculate radius based on width to ensure it fits horizontally
-    // The arc spans from startAngle to endAngle, so we need to account for that
-    constexpr float startAngle = -55.0f;  // degrees from top
-    constexpr float endAngle = 55.0f;
+    ArcGeometry geometry;
+    geometry.centerX = bounds.getCentreX();
 
     // Calculate max radius that fits in width (considering the angle spread)
     // Use smaller multiplier to leave more black space on sides
-    float maxAngleRad = juce::degreesToRadians(std::max(std::abs(startAngle), std::abs(endAngle)));
+    float maxAngleRad = juce::degreesToRadians(std::max(std::abs(ARC_START_DEGREES), std::abs(ARC_END_DEGREES)));
     float maxRadiusForWidth = (bounds.getWidth() * 0.38f) / std::sin(maxAngleRad);
     float maxRadiusForHeight = bounds.getHeight() * 1.1f;
 
-    float arcRadius = std::min(maxRadiusForWidth, maxRadiusForHeight);
-    float segmentHeight = bounds.getHeight() * 0.16f;
+    geometry.arcRadius = std::min(maxRadiusForWidth, maxRadiusForHeight);
+    geometry.segmentHeight = bounds.getHeight() * 0.16f;
 
     // Position pivot so arc fits vertically
-    auto centerY = bounds.getBottom() + arcRadius - bounds.getHeight() + segmentHeight;
+    geometry.centerY = bounds.getBottom() + geometry.arcRadius - bounds.getHeight() + geometry.segmentHeight;
 
-    // Dorrough scale: -25 to +14 dB (40 segments)
-    constexpr int numSegments = 41;
-    constexpr float minDb = -25.0f;
-    constexpr float maxDb = 14.0f;
+    return geometry;
+}
 
-    // Get current level for display
+int VUMeter::getNumLitSegments() const
+{
     float displayLevel = currentLevel;
     if (mode == Mode::GainReduction)
     {
         displayLevel = -currentLevel;  // Invert for GR display
     }
 
+    // A segment is lit once the level reaches its dB value
+    float step = (SEGMENT_MAX_DB - SEGMENT_MIN_DB) / (NUM_SEGMENTS - 1);
+    float position = (displayLevel - SEGMENT_MIN_DB) / step;
+    if (position < 0.0f)
+        return 0;
+
+    return juce::jmin(NUM_SEGMENTS, static_cast<int>(std::floor(position)) + 1);
+}
+
+void VUMeter::drawDorroughMeter(juce::Graphics& g, juce::Rectangle<float> bounds, SharedGuiResources& resources)
+{
+    // Unlit segments plus the scale; lit segments are drawn on top
+    drawSegments(g, bounds, NUM_SEGMENTS, false);
+
+    auto geometry = computeGeometry(bounds);
+    auto centerX = geometry.centerX;
+    auto centerY = geometry.centerY;
+    auto arcRadius = geometry.arcRadius;
+    auto segmentHeight = geometry.segmentHeight;
+    auto k = bounds.getHeight() / REFERENCE_HEIGHT;
+
     // dB values for labels
     struct DbLabel { float dB; const char* label; };
-    std::vector<DbLabel> labels = {
+    static constexpr DbLabel labels[] = {
         {-25.0f, "-25"}, {-22.0f, "-22"}, {-20.0f, "-20"}, {-18.0f, "-18"},
         {-16.0f, "-16"}, {-14.0f, "-14"}, {-12.0f, "-12"}, {-10.0f, "-10"},
         {-8.0f, "-8"}, {-6.0f, "-6"}, {-4.0f, "-4"}, {-2.0f, "-2"},
@@ -126,17 +214,64 @@ void VUMeter::drawDorroughMeter(juce::Graphics& g, juce::Rectangle<float> bounds
         {8.0f, "+8"}, {10.0f, "+10"}, {12.0f, "+12"}, {14.0f, "+14"}
     };
 
+    // Draw dB labels (above the segments, inside the visible area)
+    g.setFont(resources.getFont(7.0f * k));
+    for (const auto& label : labels)
+    {
+        float normalizedPos = (label.dB - SEGMENT_MIN_DB) / (SEGMENT_MAX_DB - SEGMENT_MIN_DB);
+        float angle = ARC_START_DEGREES + normalizedPos * (ARC_END_DEGREES - ARC_START_DEGREES);
+        float radians = juce::degreesToRadians(angle - 90.0f);
+
+        // Labels positioned closer to segments
+        float labelRadius = arcRadius - segmentHeight * 0.5f - 10.0f * k;
+        float lx = centerX + labelRadius * std::cos(radians);
+        float ly = centerY + labelRadius * std::sin(radians);
+
+        // Color based on zone
+        if (label.dB < 0.0f)
+            g.setColour(juce::Colour(0xFFAAAA00));  // Yellow for negative dB
+        else
+            g.setColour(juce::Colour(0xFFFF6600));  // Orange for positive dB
+
+        g.drawText(label.label,
+                  juce::Rectangle<float>(lx - 14.0f * k, ly - 5.0f * k, 28.0f * k, 10.0f * k),
+                  juce::Justification::centred);
+    }
+
+    // "dB" labels on sides (at the arc level)
+    float dbLabelRadius = arcRadius - segmentHeight * 0.5f;
+    float leftAngle = juce::degreesToRadians(ARC_START_DEGREES - 90.0f);
+    float rightAngle = juce::degreesToRadians(ARC_END_DEGREES - 90.0f);
+
+    g.setColour(juce::Colour(0xFFAAAA00));
+    g.setFont(resources.getFont(9.0f * k));
+    g.drawText("dB", juce::Rectangle<float>(centerX + dbLabelRadius * std::cos(leftAngle) - 18.0f * k,
+                                            centerY + dbLabelRadius * std::sin(leftAngle) - 5.0f * k,
+                                            16.0f * k, 10.0f * k),
+               juce::Justification::centred);
+    g.drawText("dB", juce::Rectangle<float>(centerX + dbLabelRadius * std::cos(rightAngle) + 2.0f * k,
+                                            centerY + dbLabelRadius * std::sin(rightAngle) - 5.0f * k,
+                                            16.0f * k, 10.0f * k),
+               juce::Justification::centred);
+}
+
+void VUMeter::drawSegments(juce::Graphics& g, juce::Rectangle<float> bounds, int numSegments, bool lit)
+{
+    auto geometry = computeGeometry(bounds);
+    auto segmentHeight = geometry.segmentHeight;
+    auto k = bounds.getHeight() / REFERENCE_HEIGHT;
+
     // Draw LED segments
     for (int i = 0; i < numSegments; ++i)
     {
-        float segmentDb = minDb + (static_cast<float>(i) / (numSegments - 1)) * (maxDb - minDb);
-        float normalizedPos = static_cast<float>(i) / (numSegments - 1);
-        float angle = startAngle + normalizedPos * (endAngle - startAngle);
+        float segmentDb = SEGMENT_MIN_DB + (static_cast<float>(i) / (NUM_SEGMENTS - 1)) * (SEGMENT_MAX_DB - SEGMENT_MIN_DB);
+        float normalizedPos = static_cast<float>(i) / (NUM_SEGMENTS - 1);
+        float angle = ARC_START_DEGREES + normalizedPos * (ARC_END_DEGREES - ARC_START_DEGREES);
         float radians = juce::degreesToRadians(angle - 90.0f);
 
         // Segment position on arc
-        float segX = centerX + arcRadius * std::cos(radians);
-        float segY = centerY + arcRadius * std::sin(radians);
+        float segX = geometry.centerX + geometry.arcRadius * std::cos(radians);
+        float segY = geometry.centerY + geometry.arcRadius * std::sin(radians);
 
         // Determine segment color based on position
         juce::Colour segmentColor;
@@ -169,26 +304,23 @@ void VUMeter::drawDorroughMeter(juce::Graphics& g, juce::Rectangle<float> bounds
             dimColor = juce::Colour(0xFF3A0A0A).interpolatedWith(juce::Colour(0xFF3A3A0A), t);
         }
 
-        // Check if segment should be lit
-        bool isLit = displayLevel >= segmentDb;
-
         // Draw segment (rotated rectangle)
         juce::Path segment;
-        float segWidth = (bounds.getWidth() * 0.8f) / numSegments * 0.7f;
+        float segWidth = (bounds.getWidth() * 0.8f) / NUM_SEGMENTS * 0.7f;
 
         segment.addRoundedRectangle(-segWidth / 2.0f, -segmentHeight / 2.0f,
-                                     segWidth, segmentHeight, 1.5f);
+                                     segWidth, segmentHeight, 1.5f * k);
 
         g.saveState();
         g.addTransform(juce::AffineTransform::rotation(radians + juce::MathConstants<float>::halfPi)
                                              .translated(segX, segY));
 
-        if (isLit)
+        if (lit)
         {
             // Glow effect for lit segments
             g.setColour(segmentColor.withAlpha(0.3f));
-            g.fillRoundedRectangle(-segWidth / 2.0f - 2.0f, -segmentHeight / 2.0f - 2.0f,
-                                   segWidth + 4.0f, segmentHeight + 4.0f, 2.5f);
+            g.fillRoundedRectangle(-segWidth / 2.0f - 2.0f * k, -segmentHeight / 2.0f - 2.0f * k,
+                                   segWidth + 4.0f * k, segmentHeight + 4.0f * k, 2.5f * k);
 
             g.setColour(segmentColor);
         }
@@ -199,7 +331,7 @@ void VUMeter::drawDorroughMeter(juce::Graphics& g, juce::Rectangle<float> bounds
         g.fillPath(segment);
 
         // Segment highlight for lit segments
-        if (isLit)
+        if (lit)
         {
             g.setColour(segmentColor.brighter(0.3f));
             g.fillRoundedRectangle(-segWidth / 2.0f + 1.0f, -segmentHeight / 2.0f + 1.0f,
@@ -208,47 +340,12 @@ void VUMeter::drawDorroughMeter(juce::Graphics& g, juce::Rectangle<float> bounds
 
         g.restoreState();
     }
+}
 
-    // Draw dB labels (above the segments, inside the visible area)
-    g.setFont(7.0f);
-    for (const auto& label : labels)
-    {
-        float normalizedPos = (label.dB - minDb) / (maxDb - minDb);
-        float angle = startAngle + normalizedPos * (endAngle - startAngle);
-        float radians = juce::degreesToRadians(angle - 90.0f);
-
-        // Labels positioned closer to segments
-        float labelRadius = arcRadius - segmentHeight * 0.5f - 10.0f;
-        float lx = centerX + labelRadius * std::cos(radians);
-        float ly = centerY + labelRadius * std::sin(radians);
-
-        // Color based on zone
-        if (label.dB < 0.0f)
-            g.setColour(juce::Colour(0xFFAAAA00));  // Yellow for negative dB
-        else
-            g.setColour(juce::Colour(0xFFFF6600));  // Orange for positive dB
-
-        g.drawText(label.label,
-                  static_cast<int>(lx - 14), static_cast<int>(ly - 5), 28, 10,
-                  juce::Justification::centred);
-    }
-
-    // "dB" labels on sides (at the arc level)
-    float dbLabelRadius = arcRadius - segmentHeight * 0.5f;
-    float leftAngle = juce::degreesToRadians(startAngle - 90.0f);
-    float rightAngle = juce::degreesToRadians(endAngle - 90.0f);
-
-    g.setColour(juce::Colour(0xFFAAAA00));
-    g.setFont(9.0f);
-    g.drawText("dB", static_cast<int>(centerX + dbLabelRadius * std::cos(leftAngle) - 18),
-               static_cast<int>(centerY + dbLabelRadius * std::sin(leftAngle) - 5), 16, 10,
-               juce::Justification::centred);
-    g.drawText("dB", static_cast<int>(centerX + dbLabelRadius * std::cos(rightAngle) + 2),
-               static_cast<int>(centerY + dbLabelRadius * std::sin(rightAngle) - 5), 16, 10,
-               juce::Justification::centred);
-
+void VUMeter::drawModeText(juce::Graphics& g, juce::Rectangle<float> bounds)
+{
     // Mode indicator
-    g.setFont(9.0f);
+    g.setFont(sharedResources->getFont(9.0f * bounds.getHeight() / REFERENCE_HEIGHT));
     g.setColour(juce::Colour(0xFF888888));
     const char* modeText = (mode == Mode::GainReduction) ? "GR" : "OUT";
     g.drawText(modeText, bounds.toNearestInt(), juce::Justification::centredBottom);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <juce_gui_basics/juce_gui_basics.h>
+#include "SharedGuiResources.h"
 #include <functional>
 
 /**
@@ -11,6 +12,11 @@
  * - Cream face with dB scale
  * - Red zone for high levels
  * - Switchable between Gain Reduction and Output modes
+ *
+ * The static face and the fully-lit segment arc are rasterised into a shared
+ * atlas on a background thread after the first frame (and again after a resize).
+ * Until a raster is ready the meter draws its vector version, or the previous
+ * raster scaled.
  */
 class VUMeter : public juce::Component, private juce::Timer
 {
@@ -45,11 +51,39 @@ private:
     static constexpr float MIN_DB = -20.0f;
     static constexpr float MAX_DB = 3.0f;
 
-    // Drawing helpers
+    // Dorrough scale: -25 to +14 dB
+    static constexpr int NUM_SEGMENTS = 41;
+    static constexpr float SEGMENT_MIN_DB = -25.0f;
+    static constexpr float SEGMENT_MAX_DB = 14.0f;
+    static constexpr float ARC_START_DEGREES = -55.0f;  // degrees from top
+    static constexpr float ARC_END_DEGREES = 55.0f;
+
+    struct ArcGeometry
+    {
+        float centerX = 0.0f;
+        float centerY = 0.0f;
+        float arcRadius = 0.0f;
+        float segmentHeight = 0.0f;
+    };
+
+    // Inner meter height the fixed sizes below were designed for
+    static constexpr float REFERENCE_HEIGHT = 110.0f;
+
+    // Shared raster atlas
+    juce::SharedResourcePointer<SharedGuiResources> sharedResources;
+    juce::Image requestLayer(const juce::String& name, float scaleFactor, bool lit);
+
+    // Drawing helpers (static, so they can run on the raster cache's thread)
     void drawMeterFace(juce::Graphics& g, juce::Rectangle<float> bounds);
     void drawNeedle(juce::Graphics& g, juce::Rectangle<float> bounds, float angle);
     void drawScale(juce::Graphics& g, juce::Rectangle<float> bounds);
-    void drawDorroughMeter(juce::Graphics& g, juce::Rectangle<float> bounds);
+    static void drawDorroughMeter(juce::Graphics& g, juce::Rectangle<float> bounds, SharedGuiResources& resources);
+    static void drawStaticLayer(juce::Graphics& g, juce::Rectangle<float> localBounds, SharedGuiResources& resources);
+    static void drawSegments(juce::Graphics& g, juce::Rectangle<float> bounds, int numSegments, bool lit);
+    void drawModeText(juce::Graphics& g, juce::Rectangle<float> bounds);
+    static juce::Rectangle<float> getInnerBounds(juce::Rectangle<float> localBounds);
+    static ArcGeometry computeGeometry(juce::Rectangle<float> bounds);
+    int getNumLitSegments() const;
     float levelToAngle(float dB);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VUMeter)
@@ -0,0 +1,95 @@
+#include "dsp/ABCompressor.h"
+
+/**
+ * A/B slot tests
+ *
+ * - Switching slots crossfades: no step in the output, and the result settles
+ *   on the selected slot's settings
+ * - Each slot keeps its own settings across switches
+ * - Switching back mid-fade reverses the fade without a jump
+ */
+class ABCompressorTests : public juce::UnitTest
+{
+public:
+    ABCompressorTests() : juce::UnitTest("A/B compressor", "LA2ATero") {}
+
+    void runTest() override
+    {
+        constexpr float input = 0.5f;
+        const float gainA = juce::Decibels::decibelsToGain(-6.0f);
+        const float gainB = juce::Decibels::decibelsToGain(6.0f);
+
+        beginTest("Crossfade between slots");
+        {
+            ABCompressor compressor;
+            compressor.getActive().setGain(-6.0f);
+            compressor.prepare(48000.0, 64, 2);
+
+            run(compressor, 60);
+            expectWithinAbsoluteError(lastSample, input * gainA, 1.0e-4f);
+
+            compressor.select(1);
+            expect(compressor.isCrossfading());
+            compressor.getActive().setGain(6.0f);
+
+            largestStep = 0.0f;
+            run(compressor, 60);
+            expect(! compressor.isCrossfading());
+            expectWithinAbsoluteError(lastSample, input * gainB, 1.0e-4f);
+            expectLessThan(largestStep, 0.01f, "Slot switch should be crossfaded");
+
+            // Slot A still holds its own gain
+            compressor.select(0);
+            largestStep = 0.0f;
+            run(compressor, 60);
+            expectWithinAbsoluteError(lastSample, input * gainA, 1.0e-4f);
+            expectLessThan(largestStep, 0.01f);
+        }
+
+        beginTest("Reversing mid-fade");
+        {
+            ABCompressor compressor;
+            compressor.getActive().setGain(-6.0f);
+            compressor.prepare(48000.0, 64, 2);
+            run(compressor, 60);
+
+            compressor.select(1);
+            compressor.getActive().setGain(6.0f);
+            run(compressor, 10);
+
+            expect(compressor.isCrossfading());
+            compressor.select(0);
+
+            largestStep = 0.0f;
+            run(compressor, 60);
+            expectWithinAbsoluteError(lastSample, input * gainA, 1.0e-4f);
+            expectLessThan(largestStep, 0.01f, "Reversal should continue from the current gains");
+        }
+    }
+
+private:
+    // Runs DC through 64-sample blocks, tracking the output and its largest step
+    void run(ABCompressor& compressor, int numBlocks)
+    {
+        juce::AudioBuffer<float> buffer(2, 64);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), 0.5f, buffer.getNumSamples());
+
+            compressor.processBlock(buffer);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                largestStep = juce::jmax(largestStep, std::abs(buffer.getSample(0, i) - lastSample));
+                lastSample = buffer.getSample(0, i);
+            }
+        }
+    }
+
+    float lastSample = 0.0f;
+    float largestStep = 0.0f;
+};
+
+static ABCompressorTests abCompressorTests;
@@ -0,0 +1,95 @@
+#include "AllocationCounter.h"
+
+#if LA2A_AUDIO_THREAD_GUARD
+
+// Guard builds already replace operator new and malloc (see AudioThreadGuard),
+// so counting goes through the guard's per-thread counter
+#include "dsp/AudioThreadGuard.h"
+
+AllocationCounter::ScopedCount::ScopedCount() : previous(AudioThreadGuard::setThreadAllocationCounter(&count))
+{
+}
+
+AllocationCounter::ScopedCount::~ScopedCount()
+{
+    AudioThreadGuard::setThreadAllocationCounter(previous);
+}
+
+#else
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+ #include <malloc.h>
+#endif
+
+namespace
+{
+    thread_local int* activeCount = nullptr;
+
+    void* allocate(std::size_t size)
+    {
+        if (activeCount != nullptr)
+            ++*activeCount;
+
+        if (auto* p = std::malloc(size == 0 ? 1 : size))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        if (activeCount != nullptr)
+            ++*activeCount;
+
+        const auto align = static_cast<std::size_t>(alignment);
+
+       #ifdef _WIN32
+        if (auto* p = _aligned_malloc(size == 0 ? 1 : size, align))
+            return p;
+       #else
+        void* p = nullptr;
+        if (posix_memalign(&p, align < sizeof(void*) ? sizeof(void*) : align, size == 0 ? 1 : size) == 0)
+            return p;
+       #endif
+
+        throw std::bad_alloc();
+    }
+
+    void freeAligned(void* p)
+    {
+       #ifdef _WIN32
+        _aligned_free(p);
+       #else
+        std::free(p);
+       #endif
+    }
+}
+
+AllocationCounter::ScopedCount::ScopedCount() : previous(activeCount)
+{
+    activeCount = &count;
+}
+
+AllocationCounter::ScopedCount::~ScopedCount()
+{
+    activeCount = previous;
+}
+
+//==============================================================================
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { freeAligned(p); }
+
+#endif
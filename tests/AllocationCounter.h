@@ -0,0 +1,28 @@
+#pragma once
+
+/**
+ * Heap allocation counter for real-time safety tests
+ *
+ * The test executable replaces the global operator new/delete (see
+ * AllocationCounter.cpp; audio thread guard builds use the guard's own
+ * replacement instead). While a ScopedCount exists, allocations made on the
+ * thread that created it are counted; other threads are not affected.
+ */
+namespace AllocationCounter
+{
+    class ScopedCount
+    {
+    public:
+        ScopedCount();
+        ~ScopedCount();
+
+        int getCount() const { return count; }
+
+    private:
+        int count = 0;
+        int* previous = nullptr;
+
+        ScopedCount(const ScopedCount&) = delete;
+        ScopedCount& operator=(const ScopedCount&) = delete;
+    };
+}
@@ -0,0 +1,127 @@
+#include "PluginProcessor.h"
+#include "dsp/AudioThreadGuard.h"
+#include "HarnessHelpers.h"
+
+using HarnessHelpers::setParameter;
+
+/**
+ * Audio thread guard harness (LA2A_ENABLE_AUDIO_THREAD_GUARD builds only)
+ *
+ * Checks that the guard sees allocations and locks, then drives processBlock
+ * through prepareToPlay cycles at several rates and block sizes, parameter
+ * automation, state loads, program changes and A/B switches, in the realtime
+ * and offline paths, and fails if the guard reported anything from inside
+ * processBlock. The guard prints each violation with a stack trace.
+ */
+class AudioThreadGuardTests : public juce::UnitTest
+{
+public:
+    AudioThreadGuardTests() : juce::UnitTest("Audio thread guard", "LA2ATero") {}
+
+    void runTest() override
+    {
+        beginTest("Guard sees violations");
+        {
+            AudioThreadGuard::setReportsEnabled(false);
+            const int before = AudioThreadGuard::getNumViolations();
+
+            {
+                const AudioThreadGuard::ScopedRealtime realtime;
+                probe = std::make_unique<juce::String>("allocates");
+            }
+            expectGreaterThan(AudioThreadGuard::getNumViolations(), before, "Allocation not reported");
+
+           #if JUCE_LINUX
+            const int beforeLock = AudioThreadGuard::getNumViolations();
+            {
+                const AudioThreadGuard::ScopedRealtime realtime;
+                const juce::ScopedLock lock(probeLock);
+            }
+            expectGreaterThan(AudioThreadGuard::getNumViolations(), beforeLock, "Mutex lock not reported");
+           #endif
+
+            // Outside a real-time scope nothing is reported
+            const int outside = AudioThreadGuard::getNumViolations();
+            probe.reset();
+            expectEquals(AudioThreadGuard::getNumViolations(), outside);
+
+            AudioThreadGuard::setReportsEnabled(true);
+        }
+
+        beginTest("processBlock under the guard");
+        {
+            const int before = AudioThreadGuard::getNumViolations();
+            juce::Random random(2468);
+
+            // Saved states to load between blocks
+            juce::MemoryBlock states[2];
+            {
+                AuDemoProcessor source;
+                setParameter(source, "peakReduction", 70.0f);
+                setParameter(source, "tpCeiling", 1.0f);
+                source.getStateInformation(states[0]);
+                setParameter(source, "limitMode", 1.0f);
+                setParameter(source, "mix", 40.0f);
+                source.getStateInformation(states[1]);
+            }
+
+            AuDemoProcessor processor;
+            juce::MidiBuffer midi;
+            int cycle = 0;
+
+            for (const double sampleRate : { 44100.0, 48000.0, 96000.0 })
+            {
+                for (const int blockSize : { 64, 512, 2048 })
+                {
+                    // prepareToPlay and releaseResources may allocate; only processBlock is guarded
+                    processor.setNonRealtime(cycle % 2 == 1);
+                    processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+                    processor.prepareToPlay(sampleRate, blockSize);
+
+                    juce::AudioBuffer<float> buffer(2, blockSize);
+
+                    for (int round = 0; round < 25; ++round)
+                    {
+                        setParameter(processor, "peakReduction", random.nextFloat() * 100.0f);
+                        setParameter(processor, "gain", random.nextFloat() * 30.0f - 10.0f);
+                        setParameter(processor, "compMode", random.nextBool() ? 1.0f : 0.0f);
+                        setParameter(processor, "tpCeiling", random.nextBool() ? 1.0f : 0.0f);
+
+                        if (round % 8 == 2)
+                            processor.setStateInformation(states[round % 2].getData(), static_cast<int>(states[round % 2].getSize()));
+
+                        if (round % 8 == 5)
+                            processor.setCurrentProgram(random.nextInt(processor.getNumPrograms()));
+
+                        if (round % 6 == 4)
+                            processor.selectABSlot(1 - processor.getABSlot());
+
+                        // Full blocks and host-split partial ones
+                        for (const int numSamples : { blockSize, juce::jmax(1, blockSize / 3), 1 })
+                        {
+                            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, 0, numSamples);
+
+                            for (int ch = 0; ch < 2; ++ch)
+                                for (int i = 0; i < numSamples; ++i)
+                                    block.setSample(ch, i, 0.8f * (2.0f * random.nextFloat() - 1.0f));
+
+                            processor.processBlock(block, midi);
+                        }
+                    }
+
+                    processor.releaseResources();
+                    ++cycle;
+                }
+            }
+
+            expectEquals(AudioThreadGuard::getNumViolations() - before, 0,
+                         "processBlock allocated or locked (see the guard's reports above)");
+        }
+    }
+
+private:
+    std::unique_ptr<juce::String> probe;
+    juce::CriticalSection probeLock;
+};
+
+static AudioThreadGuardTests audioThreadGuardTests;
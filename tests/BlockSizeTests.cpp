@@ -0,0 +1,177 @@
+#include "PluginProcessor.h"
+
+/**
+ * Block-size independence
+ *
+ * Renders deterministic stimuli through the whole processor at 20 host block
+ * sizes, in both the realtime and the offline (isNonRealtime) path, and checks
+ * that every render is bit-identical to the first, also with gain, mix and
+ * peak reduction automated at a fixed sample position.
+ */
+class BlockSizeTests : public juce::UnitTest
+{
+public:
+    BlockSizeTests() : juce::UnitTest("Block size independence", "LA2ATero") {}
+
+    void runTest() override
+    {
+        const Settings settings[] = {
+            { "comp",    65.0f, 6.0f,  false, true,  false, 100.0f },
+            { "limit",   70.0f, 10.0f, true,  false, true,  100.0f },
+            { "british", 80.0f, 4.0f,  true,  true,  false, 50.0f },
+        };
+
+        const juce::AudioBuffer<float> stimuli[] = { makeNoiseBursts(), makeSweep() };
+
+        for (const bool nonRealtime : { false, true })
+        {
+            for (const auto& setting : settings)
+            {
+                beginTest(juce::String(setting.name) + (nonRealtime ? " (offline)" : " (realtime)"));
+
+                for (const auto& stimulus : stimuli)
+                    checkBlockSizes(stimulus, setting, nonRealtime, nullptr);
+            }
+
+            // Automation at a fixed sample position: the host splits its block
+            // there, so every block size sees the change at the same sample
+            beginTest(juce::String("parameter change") + (nonRealtime ? " (offline)" : " (realtime)"));
+
+            const Settings changed { "changed", 30.0f, 12.0f, false, true, false, 60.0f };
+
+            for (const auto& stimulus : stimuli)
+                checkBlockSizes(stimulus, settings[0], nonRealtime, &changed);
+        }
+    }
+
+private:
+    static constexpr double SAMPLE_RATE = 44100.0;
+    static constexpr int LENGTH = 44100;
+    static constexpr int CHANGE_AT = 20011;    // Not a multiple of any block size tested
+
+    struct Settings
+    {
+        const char* name;
+        float peakReduction, gain;
+        bool limit, comp, tpCeiling;
+        float mix;
+    };
+
+    // Every block size must render bit-identically to the first. With a change,
+    // gain, mix and peak reduction switch to its values at CHANGE_AT.
+    void checkBlockSizes(const juce::AudioBuffer<float>& stimulus, const Settings& setting, bool nonRealtime, const Settings* change)
+    {
+        const int blockSizes[] = { 1, 2, 3, 5, 7, 16, 31, 32, 33, 63, 64, 65, 100, 128, 441, 480, 512, 1024, 4096, 65536 };
+
+        const auto reference = render(stimulus, blockSizes[0], setting, nonRealtime, change);
+
+        if (change != nullptr)
+            expect(! isBitIdentical(reference, render(stimulus, blockSizes[0], setting, nonRealtime, nullptr)), "The change should be audible");
+
+        for (int i = 1; i < juce::numElementsInArray(blockSizes); ++i)
+        {
+            const auto rendered = render(stimulus, blockSizes[i], setting, nonRealtime, change);
+            expect(isBitIdentical(reference, rendered),
+                   "Block size " + juce::String(blockSizes[i]) + " differs from block size " + juce::String(blockSizes[0]));
+        }
+    }
+
+    static juce::AudioBuffer<float> render(const juce::AudioBuffer<float>& stimulus, int blockSize,
+                                           const Settings& setting, bool nonRealtime, const Settings* change)
+    {
+        AuDemoProcessor processor;
+        auto& apvts = processor.getApvts();
+
+        auto set = [&apvts](const char* id, float value) {
+            auto* parameter = apvts.getParameter(id);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        };
+
+        set("peakReduction", setting.peakReduction);
+        set("gain", setting.gain);
+        set("limitMode", setting.limit ? 1.0f : 0.0f);
+        set("compMode", setting.comp ? 1.0f : 0.0f);
+        set("tpCeiling", setting.tpCeiling ? 1.0f : 0.0f);
+        set("mix", setting.mix);
+
+        processor.setNonRealtime(nonRealtime);
+        processor.setPlayConfigDetails(2, 2, SAMPLE_RATE, blockSize);
+        processor.prepareToPlay(SAMPLE_RATE, blockSize);
+
+        juce::AudioBuffer<float> output(stimulus);
+        juce::MidiBuffer midi;
+
+        for (int start = 0; start < output.getNumSamples();)
+        {
+            int num = juce::jmin(blockSize, output.getNumSamples() - start);
+
+            if (change != nullptr)
+            {
+                if (start == CHANGE_AT)
+                {
+                    set("peakReduction", change->peakReduction);
+                    set("gain", change->gain);
+                    set("mix", change->mix);
+                }
+                else if (start < CHANGE_AT && start + num > CHANGE_AT)
+                {
+                    num = CHANGE_AT - start;
+                }
+            }
+
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), output.getNumChannels(), start, num);
+            processor.processBlock(block, midi);
+            start += num;
+        }
+
+        return output;
+    }
+
+    static bool isBitIdentical(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            if (std::memcmp(a.getReadPointer(ch), b.getReadPointer(ch), sizeof(float) * static_cast<size_t>(a.getNumSamples())) != 0)
+                return false;
+
+        return true;
+    }
+
+    // Noise bursts of different levels with gaps, so attack and both release stages run
+    static juce::AudioBuffer<float> makeNoiseBursts()
+    {
+        juce::AudioBuffer<float> buffer(2, LENGTH);
+        juce::Random random(1234);
+
+        for (int i = 0; i < LENGTH; ++i)
+        {
+            const int burst = i / 4410;
+            const float level = (burst % 2 == 0) ? 0.2f + 0.15f * static_cast<float>(burst % 5) : 0.01f;
+
+            for (int ch = 0; ch < 2; ++ch)
+                buffer.setSample(ch, i, level * (2.0f * random.nextFloat() - 1.0f));
+        }
+
+        return buffer;
+    }
+
+    // Exponential sweep with a stepped envelope, slightly different per channel
+    static juce::AudioBuffer<float> makeSweep()
+    {
+        juce::AudioBuffer<float> buffer(2, LENGTH);
+        double phase = 0.0;
+
+        for (int i = 0; i < LENGTH; ++i)
+        {
+            const double t = i / SAMPLE_RATE;
+            phase += juce::MathConstants<double>::twoPi * 40.0 * std::pow(400.0, t) / SAMPLE_RATE;
+            const float envelope = (i / 11025) % 2 == 0 ? 0.9f : 0.3f;
+
+            buffer.setSample(0, i, envelope * static_cast<float>(std::sin(phase)));
+            buffer.setSample(1, i, envelope * 0.8f * static_cast<float>(std::sin(phase + 0.3)));
+        }
+
+        return buffer;
+    }
+};
+
+static BlockSizeTests blockSizeTests;
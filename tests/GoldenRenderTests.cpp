@@ -0,0 +1,348 @@
+#include "dsp/ABCompressor.h"
+#include "dsp/OptoCompressor.h"
+#include <functional>
+
+/**
+ * Golden renders
+ *
+ * Renders deterministic stimuli through OptoCompressor in every mode and
+ * compares the result with reference renders checked in under tests/golden,
+ * so optimisation work can't silently change the sound.
+ *
+ * References are raw little-endian float32, stereo interleaved, keeping every
+ * DECIMATION-th frame of the reference engine's output. Every engine variant
+ * in getEngines() is compared against the same references, with per-stimulus
+ * max-abs and RMS error limits; a new fast path is covered by adding it there.
+ *
+ * To regenerate the references after an intended change of sound, run the
+ * tests with LA2A_UPDATE_GOLDEN=1 in the environment and commit the files.
+ */
+class GoldenRenderTests : public juce::UnitTest
+{
+public:
+    GoldenRenderTests() : juce::UnitTest("Golden renders", "LA2ATero") {}
+
+    void runTest() override
+    {
+        const juce::File directory(LA2A_TEST_GOLDEN_DIR);
+        const bool update = juce::SystemStats::getEnvironmentVariable("LA2A_UPDATE_GOLDEN", {}).isNotEmpty();
+        const auto engines = getEngines();
+
+        for (const auto& stimulus : getStimuli())
+        {
+            const auto input = stimulus.generate();
+
+            for (const auto& mode : getModes())
+            {
+                const auto file = directory.getChildFile(juce::String(stimulus.name) + "_" + mode.name + ".f32");
+                beginTest(file.getFileName());
+
+                if (update)
+                {
+                    expect(saveReference(file, decimate(render(engines.front(), mode, input))),
+                           "Can't write " + file.getFullPathName());
+                    logMessage("Updated " + file.getFullPathName());
+                    continue;
+                }
+
+                const auto reference = loadReference(file);
+                if (reference.empty())
+                {
+                    expect(false, "Missing reference " + file.getFullPathName() + " (run with LA2A_UPDATE_GOLDEN=1 to create it)");
+                    continue;
+                }
+
+                for (const auto& engine : engines)
+                {
+                    const auto rendered = decimate(render(engine, mode, input));
+
+                    if (rendered.size() != reference.size())
+                    {
+                        expect(false, juce::String(engine.name) + ": reference length differs");
+                        continue;
+                    }
+
+                    double maxError = 0.0;
+                    double sumSquares = 0.0;
+
+                    for (size_t i = 0; i < rendered.size(); ++i)
+                    {
+                        const double error = std::abs(static_cast<double>(rendered[i]) - reference[i]);
+                        maxError = std::max(maxError, error);
+                        sumSquares += error * error;
+                    }
+
+                    const double rmsError = std::sqrt(sumSquares / static_cast<double>(rendered.size()));
+                    const juce::String context = juce::String(engine.name) + ": " + file.getFileNameWithoutExtension();
+
+                    expectLessOrEqual(maxError, stimulus.maxAbsError * engine.tolerance, context + " max-abs error");
+                    expectLessOrEqual(rmsError, stimulus.rmsError * engine.tolerance, context + " RMS error");
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int LENGTH = 96000;            // 2 s: long enough for the slow release to show
+    static constexpr int NUM_CHANNELS = 2;
+    // Prime, so the kept frames don't line up with OptoCompressor's 64-sample
+    // sub-blocks (or any power-of-two block split) and land at every phase of them
+    static constexpr int DECIMATION = 61;
+
+    // Engines that compute the same thing differently (vector paths, other
+    // block splits) must stay within the stimulus limits, which only allow
+    // for compiler and libm differences between platforms. The per-sample
+    // slow release changes the sound slightly by design, so it gets more room.
+    static constexpr double EXACT_TOLERANCE = 1.0;
+    static constexpr double HIGH_QUALITY_TOLERANCE = 100.0;
+
+    struct Mode
+    {
+        const char* name;
+        float peakReduction, gain;
+        bool limit, british, ceiling;
+        float mix;
+    };
+
+    struct Stimulus
+    {
+        const char* name;
+        std::function<juce::AudioBuffer<float>()> generate;
+        double maxAbsError;
+        double rmsError;
+    };
+
+    struct Engine
+    {
+        const char* name;
+        std::function<void(juce::AudioBuffer<float>&, const Mode&)> process;
+        double tolerance;       // Scales the stimulus' error limits
+    };
+
+    static std::vector<Mode> getModes()
+    {
+        return {
+            { "comp",    60.0f, 6.0f,  false, false, false, 100.0f },
+            { "limit",   65.0f, 8.0f,  true,  false, false, 100.0f },
+            { "british", 75.0f, 4.0f,  true,  true,  false, 70.0f },
+            { "ceiling", 70.0f, 14.0f, true,  false, true,  100.0f },
+        };
+    }
+
+    static std::vector<Stimulus> getStimuli()
+    {
+        return {
+            { "sinebursts", makeSineBursts, 1.0e-4, 1.0e-5 },
+            { "pinknoise",  makePinkNoise,  1.0e-4, 1.0e-5 },
+            { "drums",      makeDrums,      1.0e-4, 1.0e-5 },
+            { "steps",      makeSteps,      1.0e-4, 1.0e-5 },
+        };
+    }
+
+    static void configure(OptoCompressor& compressor, const Mode& mode)
+    {
+        compressor.setPeakReduction(mode.peakReduction);
+        compressor.setGain(mode.gain);
+        compressor.setLimitMode(mode.limit);
+        compressor.setBritishMode(mode.british);
+        compressor.setMix(mode.mix);
+        compressor.setTruePeakCeiling(mode.ceiling, -1.0f);
+    }
+
+    static void processInBlocks(juce::AudioBuffer<float>& buffer, int blockSize,
+                                const std::function<void(juce::AudioBuffer<float>&)>& process)
+    {
+        for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+        {
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start,
+                                           juce::jmin(blockSize, buffer.getNumSamples() - start));
+            process(block);
+        }
+    }
+
+    // The first engine renders the references
+    static std::vector<Engine> getEngines()
+    {
+        auto optoCompressor = [](int blockSize, bool highQuality) {
+            return [blockSize, highQuality](juce::AudioBuffer<float>& buffer, const Mode& mode) {
+                OptoCompressor compressor;
+                configure(compressor, mode);
+                compressor.setHighQuality(highQuality);
+                compressor.prepare(SAMPLE_RATE, blockSize, buffer.getNumChannels());
+                processInBlocks(buffer, blockSize, [&compressor](juce::AudioBuffer<float>& block) { compressor.processBlock(block); });
+            };
+        };
+
+        return {
+            { "OptoCompressor",                   optoCompressor(512, false), EXACT_TOLERANCE },
+            { "OptoCompressor (37-sample blocks)", optoCompressor(37, false),  EXACT_TOLERANCE },
+            { "ABCompressor",
+              [](juce::AudioBuffer<float>& buffer, const Mode& mode) {
+                  ABCompressor compressor;
+                  configure(compressor.getActive(), mode);
+                  compressor.prepare(SAMPLE_RATE, 512, buffer.getNumChannels());
+                  processInBlocks(buffer, 512, [&compressor](juce::AudioBuffer<float>& block) { compressor.processBlock(block); });
+              },
+              EXACT_TOLERANCE },
+            { "OptoCompressor (high quality)",    optoCompressor(512, true),  HIGH_QUALITY_TOLERANCE },
+        };
+    }
+
+    static juce::AudioBuffer<float> render(const Engine& engine, const Mode& mode, const juce::AudioBuffer<float>& input)
+    {
+        juce::AudioBuffer<float> output(input);
+        engine.process(output, mode);
+        return output;
+    }
+
+    static std::vector<float> decimate(const juce::AudioBuffer<float>& buffer)
+    {
+        std::vector<float> frames;
+        frames.reserve(static_cast<size_t>(buffer.getNumSamples() / DECIMATION + 1) * static_cast<size_t>(buffer.getNumChannels()));
+
+        for (int i = 0; i < buffer.getNumSamples(); i += DECIMATION)
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                frames.push_back(buffer.getSample(ch, i));
+
+        return frames;
+    }
+
+    static bool saveReference(const juce::File& file, const std::vector<float>& values)
+    {
+        juce::MemoryOutputStream stream;
+
+        for (auto value : values)
+            stream.writeFloat(value);       // Little-endian on every platform
+
+        return file.replaceWithData(stream.getData(), stream.getDataSize());
+    }
+
+    static std::vector<float> loadReference(const juce::File& file)
+    {
+        juce::MemoryBlock data;
+        if (! file.loadFileAsData(data))
+            return {};
+
+        std::vector<float> values(data.getSize() / sizeof(float));
+        juce::MemoryInputStream stream(data, false);
+
+        for (auto& value : values)
+            value = stream.readFloat();     // Little-endian on every platform
+
+        return values;
+    }
+
+    //==============================================================================
+    // 1 kHz / 3 kHz tone bursts of rising level with gaps, the channels a little apart
+    static juce::AudioBuffer<float> makeSineBursts()
+    {
+        juce::AudioBuffer<float> buffer(NUM_CHANNELS, LENGTH);
+
+        for (int i = 0; i < LENGTH; ++i)
+        {
+            const int burst = i / 6000;
+            const bool on = (i % 6000) < 4000;
+            const float level = on ? 0.05f + 0.12f * static_cast<float>(burst % 7) : 0.0f;
+            const double t = i / SAMPLE_RATE;
+            const double frequency = burst % 2 == 0 ? 1000.0 : 3000.0;
+
+            buffer.setSample(0, i, level * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * frequency * t)));
+            buffer.setSample(1, i, 0.9f * level * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * frequency * t + 0.5)));
+        }
+
+        return buffer;
+    }
+
+    // Pink noise (Paul Kellet's filter) at about -12 dBFS RMS, with a level swell
+    static juce::AudioBuffer<float> makePinkNoise()
+    {
+        juce::AudioBuffer<float> buffer(NUM_CHANNELS, LENGTH);
+        juce::Random random(2024);
+
+        for (int ch = 0; ch < NUM_CHANNELS; ++ch)
+        {
+            float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f, b3 = 0.0f, b4 = 0.0f, b5 = 0.0f, b6 = 0.0f;
+
+            for (int i = 0; i < LENGTH; ++i)
+            {
+                const float white = 2.0f * random.nextFloat() - 1.0f;
+                b0 = 0.99886f * b0 + white * 0.0555179f;
+                b1 = 0.99332f * b1 + white * 0.0750759f;
+                b2 = 0.96900f * b2 + white * 0.1538520f;
+                b3 = 0.86650f * b3 + white * 0.3104856f;
+                b4 = 0.55000f * b4 + white * 0.5329522f;
+                b5 = -0.7616f * b5 - white * 0.0168980f;
+                const float pink = b0 + b1 + b2 + b3 + b4 + b5 + b6 + white * 0.5362f;
+                b6 = white * 0.115926f;
+
+                const float swell = 0.5f + 0.5f * std::sin(juce::MathConstants<float>::pi * static_cast<float>(i) / LENGTH);
+                buffer.setSample(ch, i, 0.08f * swell * pink);
+            }
+        }
+
+        return buffer;
+    }
+
+    // Kick- and snare-like hits: fast attacks, exponential decays, accents
+    static juce::AudioBuffer<float> makeDrums()
+    {
+        juce::AudioBuffer<float> buffer(NUM_CHANNELS, LENGTH);
+        buffer.clear();
+        juce::Random random(77);
+
+        constexpr int STEP = 6000;      // Eighth notes at 120 bpm
+
+        for (int hit = 0; hit * STEP < LENGTH; ++hit)
+        {
+            const bool kick = hit % 2 == 0;
+            const float accent = hit % 4 == 0 ? 1.0f : 0.6f;
+            const int start = hit * STEP;
+
+            double phase = 0.0;
+            for (int i = 0; i < STEP && start + i < LENGTH; ++i)
+            {
+                const float t = static_cast<float>(i / SAMPLE_RATE);
+                float sample;
+
+                if (kick)
+                {
+                    phase += juce::MathConstants<double>::twoPi * (50.0 + 100.0 * std::exp(-t * 40.0)) / SAMPLE_RATE;
+                    sample = 0.9f * std::exp(-t * 12.0f) * static_cast<float>(std::sin(phase));
+                }
+                else
+                {
+                    phase += juce::MathConstants<double>::twoPi * 190.0 / SAMPLE_RATE;
+                    sample = 0.5f * std::exp(-t * 25.0f) * static_cast<float>(std::sin(phase))
+                           + 0.4f * std::exp(-t * 35.0f) * (2.0f * random.nextFloat() - 1.0f);
+                }
+
+                buffer.setSample(0, start + i, accent * sample);
+                buffer.setSample(1, start + i, accent * (kick ? sample : 0.8f * sample));
+            }
+        }
+
+        return buffer;
+    }
+
+    // Loud/quiet level steps of a 220 Hz tone: attack into deep reduction,
+    // then release, with short and long loud sections to vary the slow release
+    static juce::AudioBuffer<float> makeSteps()
+    {
+        juce::AudioBuffer<float> buffer(NUM_CHANNELS, LENGTH);
+
+        for (int i = 0; i < LENGTH; ++i)
+        {
+            const bool loud = i < 12000 || (i >= 48000 && i < 72000);
+            const float level = loud ? 0.7f : 0.03f;
+            const float sample = level * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 220.0 * i / SAMPLE_RATE));
+
+            for (int ch = 0; ch < NUM_CHANNELS; ++ch)
+                buffer.setSample(ch, i, sample);
+        }
+
+        return buffer;
+    }
+};
+
+static GoldenRenderTests goldenRenderTests;
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "PluginProcessor.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#if JUCE_LINUX
+ #include <unistd.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#endif
+
+/**
+ * Helpers shared by the tests, the soak harness and the benchmarks
+ *
+ * - Percentiles of a set of timings
+ * - Resident set size of the process
+ * - Setting a parameter by plain value, as host automation does
+ */
+namespace HarnessHelpers
+{
+    struct Percentiles
+    {
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        double total = 0.0;
+    };
+
+    inline Percentiles summarise(std::vector<double> samples)
+    {
+        Percentiles result;
+        if (samples.empty())
+            return result;
+
+        for (auto sample : samples)
+            result.total += sample;
+
+        std::sort(samples.begin(), samples.end());
+
+        auto at = [&samples](double fraction) {
+            auto index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1) + 0.5);
+            return samples[index];
+        };
+
+        result.p50 = at(0.5);
+        result.p99 = at(0.99);
+        result.max = samples.back();
+        return result;
+    }
+
+    // Resident set size of the process, 0 where it can't be read
+    inline size_t residentBytes()
+    {
+       #if JUCE_LINUX
+        if (auto* file = std::fopen("/proc/self/statm", "r"))
+        {
+            unsigned long size = 0, resident = 0;
+            const bool read = std::fscanf(file, "%lu %lu", &size, &resident) == 2;
+            std::fclose(file);
+
+            if (read)
+                return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        }
+       #elif JUCE_MAC
+        mach_task_basic_info_data_t info {};
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+            return static_cast<size_t>(info.resident_size);
+       #endif
+
+        return 0;
+    }
+
+    // Plain (not normalised) value, notifying the host
+    inline void setParameter(AuDemoProcessor& processor, juce::StringRef id, float value)
+    {
+        auto* parameter = processor.getApvts().getParameter(id);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+}
@@ -0,0 +1,269 @@
+#include "dsp/OptoCompressor.h"
+#include <algorithm>
+#include <chrono>
+
+/**
+ * OptoCompressor tests
+ *
+ * - Static curve: no reduction up to the knee start, the full ratio from the
+ *   knee end, continuous and monotonic in between
+ * - Time constants measured from step responses: attack from rest, and the
+ *   fast and slow release stages (the slow one lengthening after deeper
+ *   compression)
+ * - NaN/Inf: the vectorized check finds them at any position, a block that
+ *   drives the compressor non-finite is muted, and the next ones compress
+ * - Cost: ns per stereo sample frame must stay within
+ *   LA2A_TEST_NS_PER_SAMPLE_BUDGET (a CMake cache variable)
+ */
+class OptoCompressorTests : public juce::UnitTest
+{
+public:
+    OptoCompressorTests() : juce::UnitTest("OptoCompressor", "LA2ATero") {}
+
+    void runTest() override
+    {
+        beginTest("Ratios");
+        {
+            expectEquals(OptoCompressor::getRatio(false, false), 3.0f);
+            expectEquals(OptoCompressor::getRatio(true, false), 100.0f);
+            expectEquals(OptoCompressor::getRatio(true, true), 20.0f);
+            expectEquals(OptoCompressor::getRatio(false, true), 20.0f);
+        }
+
+        beginTest("Knee boundaries");
+        {
+            for (float level = -90.0f; level <= 0.0f; level += 1.0f)
+                expectEquals(OptoCompressor::computeGainReductionDb(level, 0.0f, 3.0f), 0.0f, "No reduction at peak reduction 0");
+
+            for (const float peakReduction : { 10.0f, 50.0f, 100.0f })
+            {
+                for (const float ratio : { 3.0f, 20.0f, 100.0f })
+                {
+                    const auto context = "PR " + juce::String(peakReduction) + ", ratio " + juce::String(ratio);
+                    const float threshold = -0.4f * peakReduction;
+                    const float kneeStart = threshold - KNEE_WIDTH_DB / 2.0f;
+                    const float kneeEnd = threshold + KNEE_WIDTH_DB / 2.0f;
+                    const float slope = 1.0f - 1.0f / ratio;
+                    auto gr = [&](float level) { return OptoCompressor::computeGainReductionDb(level, peakReduction, ratio); };
+
+                    expectEquals(gr(kneeStart - 20.0f), 0.0f, context + ": below the knee");
+                    expectEquals(gr(kneeStart), 0.0f, context + ": knee start");
+                    expectWithinAbsoluteError(gr(kneeEnd), (kneeEnd - threshold) * slope, 1.0e-4f, context + ": knee end");
+                    expectWithinAbsoluteError(gr(kneeEnd + 10.0f) - gr(kneeEnd), 10.0f * slope, 1.0e-3f, context + ": slope above the knee");
+
+                    // Inside the knee the curve is quadratic, and never below zero
+                    const float quarter = kneeStart + KNEE_WIDTH_DB / 4.0f;
+                    expectWithinAbsoluteError(gr(quarter), slope * KNEE_WIDTH_DB / 32.0f, 1.0e-4f, context + ": inside the knee");
+                    expectGreaterOrEqual(gr(threshold - 1.0f), 0.0f, context + ": below the threshold");
+
+                    // Continuous at both boundaries
+                    expectWithinAbsoluteError(gr(kneeStart + 1.0e-3f), 0.0f, 1.0e-4f, context + ": continuity at knee start");
+                    expectWithinAbsoluteError(gr(kneeEnd - 1.0e-3f), gr(kneeEnd + 1.0e-3f), 1.0e-2f, context + ": continuity at knee end");
+
+                    // Monotonic over the whole range
+                    float previous = 0.0f;
+                    bool monotonic = true;
+                    for (float level = kneeStart - 6.0f; level <= 0.0f; level += 0.05f)
+                    {
+                        const float value = gr(level);
+                        monotonic = monotonic && value >= previous - 1.0e-6f;
+                        previous = value;
+                    }
+                    expect(monotonic, context + ": curve should be monotonic");
+                }
+            }
+        }
+
+        beginTest("Attack time constant");
+        {
+            // From rest the slow release envelope is at unity, so the
+            // sustained (twice as fast) attack applies: 5 ms to 63%
+            for (const bool limit : { false, true })
+            {
+                OptoCompressor compressor;
+                compressor.setPeakReduction(80.0f);
+                compressor.setLimitMode(limit);
+                compressor.prepare(SAMPLE_RATE, 1, 1);
+
+                std::vector<float> gains;
+                for (int i = 0; i < static_cast<int>(SAMPLE_RATE / 10); ++i)
+                    gains.push_back(processSample(compressor, 0.5f));
+
+                const float ratio = OptoCompressor::getRatio(limit, false);
+                const float expected = juce::Decibels::decibelsToGain(
+                    -OptoCompressor::computeGainReductionDb(juce::Decibels::gainToDecibels(0.5f + 0.0001f), 80.0f, ratio));
+                expectWithinAbsoluteError(gains.back(), expected, 1.0e-4f, "Settles on the static curve");
+
+                const auto reached = std::find_if(gains.begin(), gains.end(), [&](float gain) {
+                    return 1.0f - gain >= 0.632f * (1.0f - expected);
+                });
+                const double attackMs = 1000.0 * static_cast<double>(std::distance(gains.begin(), reached) + 1) / SAMPLE_RATE;
+                expectWithinAbsoluteError(attackMs, 5.0, 0.25, limit ? "Limit mode attack" : "Compress mode attack");
+            }
+        }
+
+        beginTest("Release time constants");
+        {
+            // 40% of the release follows the 60 ms stage, 60% the adaptive
+            // 1-15 s stage, which is longer after deeper compression
+            double previousSlowMs = 0.0;
+
+            for (const float peakReduction : { 40.0f, 80.0f })
+            {
+                const auto context = "PR " + juce::String(peakReduction);
+                OptoCompressor compressor;
+                compressor.setPeakReduction(peakReduction);
+                compressor.prepare(SAMPLE_RATE, 1, 1);
+
+                float gain = 1.0f;
+                for (int i = 0; i < static_cast<int>(SAMPLE_RATE * 2); ++i)
+                    gain = processSample(compressor, 0.5f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 1000.0 * i / SAMPLE_RATE)));
+
+                const float depth = 1.0f - gain;
+                expectGreaterThan(depth, 0.3f, context + ": should be compressing");
+
+                std::vector<float> remaining;
+                for (int i = 0; i < static_cast<int>(SAMPLE_RATE * 1.5); ++i)
+                    remaining.push_back((1.0f - processSample(compressor, 0.0f)) / depth);
+
+                auto at = [&](double ms) { return static_cast<double>(remaining[static_cast<size_t>(ms * SAMPLE_RATE / 1000.0) - 1]); };
+
+                // One fast time constant in, the fast part is down to 1/e
+                expectWithinAbsoluteError(at(60.0), 0.4 * std::exp(-1.0) + 0.6, 0.03, context + ": fast stage at 60 ms");
+
+                // After five, only the slow part is left
+                expectWithinAbsoluteError(at(300.0), 0.6, 0.05, context + ": fast stage done by 300 ms");
+
+                const double slowMs = -1000.0 / std::log(at(1300.0) / at(300.0));
+                expect(slowMs >= 1000.0 && slowMs <= 15000.0, context + ": slow release " + juce::String(slowMs, 0) + " ms outside 1-15 s");
+                expectGreaterThan(slowMs, previousSlowMs, context + ": deeper compression should release more slowly");
+                previousSlowMs = slowMs;
+            }
+        }
+
+        beginTest("Non-finite detection");
+        {
+            std::vector<float> samples(37, 0.25f);
+            samples[5] = std::numeric_limits<float>::max();
+            samples[6] = std::numeric_limits<float>::denorm_min();
+            expect(! SampleSanitizer::containsNonFinite(samples.data(), static_cast<int>(samples.size())), "Finite samples flagged");
+
+            for (const float bad : { std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::quiet_NaN(),
+                                     std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() })
+            {
+                for (size_t position = 0; position < samples.size(); ++position)
+                {
+                    auto copy = samples;
+                    copy[position] = bad;
+                    expect(SampleSanitizer::containsNonFinite(copy.data(), static_cast<int>(copy.size())),
+                           juce::String(bad) + " missed at " + juce::String(static_cast<int>(position)));
+                }
+            }
+
+            expectEquals(SampleSanitizer::flushToZero(1.0e-20f), 0.0f);
+            expectEquals(SampleSanitizer::flushToZero(-1.0e-20f), 0.0f);
+            expectEquals(SampleSanitizer::flushToZero(1.0e-6f), 1.0e-6f);
+        }
+
+        beginTest("Non-finite recovery");
+        {
+            OptoCompressor compressor;
+            compressor.setPeakReduction(60.0f);
+            compressor.setTruePeakCeiling(true, -1.0f);
+            compressor.prepare(SAMPLE_RATE, 256, 2);
+
+            juce::AudioBuffer<float> buffer(2, 256);
+            auto fillSine = [&buffer] {
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < buffer.getNumSamples(); ++i)
+                        buffer.setSample(ch, i, 0.5f * static_cast<float>(std::sin(0.1 * i)));
+            };
+
+            // NaN, Inf, and finite input large enough to overflow the detector's
+            // sum of squares (which the curve and the ceiling absorb)
+            for (const float bad : { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), 1.0e30f })
+            {
+                const auto context = "After " + juce::String(bad);
+
+                for (int block = 0; block < 20; ++block)
+                {
+                    fillSine();
+                    compressor.processBlock(buffer);
+                }
+
+                fillSine();
+                buffer.setSample(1, 100, bad);
+                compressor.processBlock(buffer);
+                expect(compressor.getLastBlockStats().stateRecovered == ! std::isfinite(bad), context + ": recovery");
+                expect(! SampleSanitizer::containsNonFinite(buffer), context + ": non-finite output");
+
+                float outputPeak = 0.0f;
+                for (int block = 0; block < 20; ++block)
+                {
+                    fillSine();
+                    compressor.processBlock(buffer);
+                    expect(! compressor.getLastBlockStats().stateRecovered, context + ": recovered again on clean input");
+                    expect(! SampleSanitizer::containsNonFinite(buffer), context + ": non-finite output on clean input");
+                    outputPeak = buffer.getMagnitude(0, buffer.getNumSamples());
+                }
+
+                expectGreaterThan(outputPeak, 0.1f, context + ": channel silent after recovery");
+                expectLessThan(compressor.getLastBlockStats().minGainDb, -1.0f, context + ": not compressing after recovery");
+            }
+        }
+
+        beginTest("Per-sample cost");
+        {
+            OptoCompressor compressor;
+            compressor.setPeakReduction(60.0f);
+            compressor.setGain(6.0f);
+            compressor.setTruePeakCeiling(true, -1.0f);
+            compressor.prepare(SAMPLE_RATE, 512, 2);
+
+            juce::AudioBuffer<float> stimulus(2, static_cast<int>(SAMPLE_RATE));
+            juce::Random random(7);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < stimulus.getNumSamples(); ++i)
+                    stimulus.setSample(ch, i, 0.5f * (2.0f * random.nextFloat() - 1.0f));
+
+            // Best of five, so a preempted run doesn't fail the test
+            double bestNs = std::numeric_limits<double>::max();
+            juce::AudioBuffer<float> work(2, stimulus.getNumSamples());
+
+            for (int run = 0; run < 5; ++run)
+            {
+                work.makeCopyOf(stimulus, true);
+                const auto start = std::chrono::steady_clock::now();
+
+                for (int offset = 0; offset < work.getNumSamples(); offset += 512)
+                {
+                    juce::AudioBuffer<float> block(work.getArrayOfWritePointers(), 2, offset, juce::jmin(512, work.getNumSamples() - offset));
+                    compressor.processBlock(block);
+                }
+
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+                bestNs = std::min(bestNs, static_cast<double>(elapsed.count()) / work.getNumSamples());
+            }
+
+            logMessage("OptoCompressor: " + juce::String(bestNs, 1) + " ns per stereo sample (budget "
+                       + juce::String(LA2A_TEST_NS_PER_SAMPLE_BUDGET) + ")");
+            expectLessOrEqual(bestNs, static_cast<double>(LA2A_TEST_NS_PER_SAMPLE_BUDGET), "Per-sample cost over budget");
+        }
+    }
+
+private:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr float KNEE_WIDTH_DB = 6.0f;
+
+    // Processes one mono sample and returns the opto cell's gain for it
+    static float processSample(OptoCompressor& compressor, float input)
+    {
+        float sample = input;
+        float* channels[] = { &sample };
+        juce::AudioBuffer<float> buffer(channels, 1, 1);
+        compressor.processBlock(buffer);
+        return juce::Decibels::decibelsToGain(compressor.getLastBlockStats().minGainDb);
+    }
+};
+
+static OptoCompressorTests optoCompressorTests;
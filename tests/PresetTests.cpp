@@ -0,0 +1,195 @@
+#include "PluginProcessor.h"
+#include "PresetBank.h"
+#include <thread>
+
+/**
+ * Preset bank and program change tests
+ *
+ * - Factory presets are present and come first
+ * - User presets are listed from the index; only new or changed files are
+ *   parsed, and a file that doesn't parse is not read again until it changes
+ * - All processors share one bank, built on the first program query and
+ *   rescanned for all of them at once
+ * - A program change reaches the audio at the next block without waiting for
+ *   the message thread, and the gain change is ramped; on the message thread
+ *   the parameters follow at once
+ */
+class PresetBankTests : public juce::UnitTest
+{
+public:
+    PresetBankTests() : juce::UnitTest("Preset bank", "LA2ATero") {}
+
+    void runTest() override
+    {
+        beginTest("Factory presets");
+        {
+            const PresetBank bank { juce::File() };
+            expect(bank.getNumFactoryPresets() > 1);
+            expectEquals(bank.getNumPresets(), bank.getNumFactoryPresets());
+            expectEquals(bank.getPreset(0).name, juce::String("Init"));
+
+            for (int i = 0; i < bank.getNumPresets(); ++i)
+                expect(bank.getPreset(i).name.isNotEmpty());
+        }
+
+        beginTest("User presets and index");
+        {
+            const auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getNonexistentChildFile("la2a-presets", "");
+
+            PresetValues vocal;
+            vocal.peakReduction = 42.0f;
+            vocal.gain = 5.5f;
+
+            PresetValues bass;
+            bass.peakReduction = 60.0f;
+            bass.limitMode = true;
+            bass.mix = 80.0f;
+
+            expect(PresetBank::saveUserPreset(directory, "B Vocal", vocal));
+            expect(PresetBank::saveUserPreset(directory, "A Bass", bass));
+
+            {
+                const PresetBank bank(directory);
+                expectEquals(bank.getNumFilesParsed(), 2);
+                expectEquals(bank.getNumPresets(), bank.getNumFactoryPresets() + 2);
+
+                const auto& first = bank.getPreset(bank.getNumFactoryPresets());
+                expectEquals(first.name, juce::String("A Bass"));
+                expectEquals(first.values.peakReduction, 60.0f);
+                expect(first.values.limitMode);
+                expectEquals(first.values.mix, 80.0f);
+                expectEquals(bank.getPreset(bank.getNumFactoryPresets() + 1).values.gain, 5.5f);
+                expect(directory.getChildFile(PresetBank::INDEX_FILE_NAME).existsAsFile());
+            }
+
+            {
+                const PresetBank bank(directory);
+                expectEquals(bank.getNumFilesParsed(), 0, "Unchanged files should come from the index");
+                expectEquals(bank.getNumPresets(), bank.getNumFactoryPresets() + 2);
+            }
+
+            // A changed file is parsed again
+            bass.peakReduction = 30.0f;
+            expect(PresetBank::saveUserPreset(directory, "A Bass", bass));
+            directory.getChildFile(juce::String("A Bass") + PresetBank::FILE_EXTENSION)
+                .setLastModificationTime(juce::Time::getCurrentTime() + juce::RelativeTime::seconds(10.0));
+
+            {
+                const PresetBank bank(directory);
+                expectEquals(bank.getNumFilesParsed(), 1);
+                expectEquals(bank.getPreset(bank.getNumFactoryPresets()).values.peakReduction, 30.0f);
+            }
+
+            // A deleted file drops out
+            directory.getChildFile(juce::String("B Vocal") + PresetBank::FILE_EXTENSION).deleteFile();
+
+            {
+                const PresetBank bank(directory);
+                expectEquals(bank.getNumFilesParsed(), 0);
+                expectEquals(bank.getNumPresets(), bank.getNumFactoryPresets() + 1);
+            }
+
+            // A file that doesn't parse is read once, then skipped through the index
+            expect(directory.getChildFile(juce::String("Broken") + PresetBank::FILE_EXTENSION).replaceWithText("not a preset"));
+
+            {
+                const PresetBank bank(directory);
+                expectEquals(bank.getNumFilesParsed(), 1);
+                expectEquals(bank.getNumPresets(), bank.getNumFactoryPresets() + 1);
+            }
+
+            {
+                const PresetBank bank(directory);
+                expectEquals(bank.getNumFilesParsed(), 0, "Unreadable files should come from the index");
+                expectEquals(bank.getNumPresets(), bank.getNumFactoryPresets() + 1);
+            }
+
+            directory.deleteRecursively();
+        }
+
+        beginTest("One bank per process, built on the first query");
+        {
+            juce::SharedResourcePointer<SharedPresetBank> sharedBank;
+            AuDemoProcessor first;
+            AuDemoProcessor second;
+            expect(sharedBank->getBankIfBuilt() == nullptr, "Constructing a processor shouldn't build the bank");
+
+            expect(first.getNumPrograms() > 1);
+            expect(&first.getPresetBank() == &second.getPresetBank());
+
+            // A rescan (as after saving a preset) swaps the bank for every
+            // instance, and the program keeps its name
+            first.setCurrentProgram(2);
+            const auto name = first.getProgramName(2);
+            const auto* before = &first.getPresetBank();
+            sharedBank->rescan();
+
+            expect(&first.getPresetBank() != before);
+            expect(&first.getPresetBank() == &second.getPresetBank());
+            expectEquals(first.getProgramName(first.getCurrentProgram()), name);
+        }
+
+        beginTest("Program change at the block boundary");
+        {
+            AuDemoProcessor processor;
+            processor.setPlayConfigDetails(2, 2, 48000.0, 256);
+            processor.prepareToPlay(48000.0, 256);
+
+            auto* gain = processor.getApvts().getParameter("gain");
+            gain->setValueNotifyingHost(gain->convertTo0to1(-10.0f));
+
+            // DC through an uncompressed program: the output is the makeup gain
+            constexpr float input = 0.5f;
+            juce::AudioBuffer<float> buffer(2, 256);
+            juce::MidiBuffer midi;
+            float previous = 0.0f;
+            float largestStep = 0.0f;
+
+            auto run = [&](int numBlocks, bool trackSteps) {
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                        juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), input, buffer.getNumSamples());
+
+                    processor.processBlock(buffer, midi);
+
+                    for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    {
+                        const float sample = buffer.getSample(0, i);
+                        if (trackSteps)
+                            largestStep = juce::jmax(largestStep, std::abs(sample - previous));
+                        previous = sample;
+                    }
+                }
+            };
+
+            run(20, false);
+            expectWithinAbsoluteError(previous, input * juce::Decibels::decibelsToGain(-10.0f), 1.0e-3f);
+
+            // "Init" has 0 dB gain. Changed from another thread (as a host's
+            // audio thread would, after listing the programs), with no message
+            // loop running here, the parameters still say -10 dB: the audio can
+            // only follow the request.
+            expect(processor.getNumPrograms() > 1);
+            std::thread([&processor] { processor.setCurrentProgram(0); }).join();
+            expectEquals(processor.getCurrentProgram(), 0);
+
+            run(20, true);
+            expectWithinAbsoluteError(previous, input, 1.0e-3f);
+            expectWithinAbsoluteError(processor.getApvts().getRawParameterValue("gain")->load(), -10.0f, 1.0e-4f);
+            expectLessThan(largestStep, 0.01f, "Gain change should be ramped");
+
+            // On the message thread the parameters follow at once, and the
+            // automation after them is heard
+            processor.setCurrentProgram(0);
+            expectWithinAbsoluteError(processor.getApvts().getRawParameterValue("gain")->load(), 0.0f, 1.0e-4f);
+
+            gain->setValueNotifyingHost(gain->convertTo0to1(-10.0f));
+            run(20, false);
+            expectWithinAbsoluteError(previous, input * juce::Decibels::decibelsToGain(-10.0f), 1.0e-3f, "Automation after a program change");
+        }
+    }
+};
+
+static PresetBankTests presetBankTests;
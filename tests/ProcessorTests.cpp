@@ -0,0 +1,200 @@
+#include "PluginProcessor.h"
+#include "AllocationCounter.h"
+#include "HarnessHelpers.h"
+
+using HarnessHelpers::setParameter;
+
+/**
+ * AuDemoProcessor tests
+ *
+ * - Bus layouts: mono and stereo in = out are accepted, everything else is
+ *   refused, and an accepted layout processes
+ * - State round trip: loading saved state and saving again gives the same
+ *   bytes, and overrides whatever the instance had
+ * - Real-time safety: processBlock doesn't allocate, across block sizes,
+ *   parameter automation, program changes and A/B switches, in both the
+ *   realtime and the offline path
+ * - NaN/Inf input: bad samples are zeroed and counted, the output stays
+ *   finite and the next clean blocks are processed normally
+ */
+class ProcessorTests : public juce::UnitTest
+{
+public:
+    ProcessorTests() : juce::UnitTest("AuDemoProcessor", "LA2ATero") {}
+
+    void runTest() override
+    {
+        beginTest("Bus layout negotiation");
+        {
+            AuDemoProcessor processor;
+            const auto mono = juce::AudioChannelSet::mono();
+            const auto stereo = juce::AudioChannelSet::stereo();
+
+            expect(processor.checkBusesLayoutSupported(makeLayout(mono, mono)), "mono -> mono");
+            expect(processor.checkBusesLayoutSupported(makeLayout(stereo, stereo)), "stereo -> stereo");
+            expect(! processor.checkBusesLayoutSupported(makeLayout(mono, stereo)), "mono -> stereo");
+            expect(! processor.checkBusesLayoutSupported(makeLayout(stereo, mono)), "stereo -> mono");
+            expect(! processor.checkBusesLayoutSupported(makeLayout(juce::AudioChannelSet::create5point1(),
+                                                                     juce::AudioChannelSet::create5point1())), "5.1");
+            expect(! processor.checkBusesLayoutSupported(makeLayout(juce::AudioChannelSet::disabled(),
+                                                                     juce::AudioChannelSet::disabled())), "disabled");
+
+            for (const auto& set : { mono, stereo })
+            {
+                expect(processor.setBusesLayout(makeLayout(set, set)), "Applying " + set.getDescription());
+                expectEquals(processor.getTotalNumInputChannels(), set.size());
+                expectEquals(processor.getTotalNumOutputChannels(), set.size());
+
+                processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+                juce::AudioBuffer<float> buffer(set.size(), BLOCK_SIZE);
+                fill(buffer, 0.5f);
+                juce::MidiBuffer midi;
+                processor.processBlock(buffer, midi);
+
+                bool finite = true;
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    for (int i = 0; i < buffer.getNumSamples(); ++i)
+                        finite = finite && std::isfinite(buffer.getSample(ch, i));
+
+                expect(finite, set.getDescription() + " output should be finite");
+                processor.releaseResources();
+            }
+
+            expect(! processor.setBusesLayout(makeLayout(mono, stereo)), "Unsupported layout must be refused");
+        }
+
+        beginTest("State round trip");
+        {
+            AuDemoProcessor source;
+            setParameter(source, "peakReduction", 62.0f);
+            setParameter(source, "gain", 7.5f);
+            setParameter(source, "limitMode", 1.0f);
+            setParameter(source, "mix", 55.0f);
+            setParameter(source, "tpCeilingDb", -3.0f);
+
+            juce::MemoryBlock saved;
+            source.getStateInformation(saved);
+
+            AuDemoProcessor restored;
+            setParameter(restored, "peakReduction", 10.0f);
+            setParameter(restored, "gain", -4.0f);
+            setParameter(restored, "compMode", 0.0f);
+            restored.setStateInformation(saved.getData(), static_cast<int>(saved.getSize()));
+
+            juce::MemoryBlock resaved;
+            restored.getStateInformation(resaved);
+            expect(resaved == saved, "Saving loaded state should reproduce it byte for byte");
+
+            for (auto* parameter : source.getParameters())
+                expectEquals(restored.getParameters()[parameter->getParameterIndex()]->getValue(), parameter->getValue(),
+                             parameter->getName(64));
+        }
+
+        beginTest("No allocations in processBlock");
+        {
+            allocationProbe = {};
+            {
+                const AllocationCounter::ScopedCount count;
+                allocationProbe.resize(static_cast<size_t>(juce::Random::getSystemRandom().nextInt({ 16, 32 })));
+                expectGreaterThan(count.getCount(), 0, "The allocation counter should see allocations");
+            }
+
+            for (const bool nonRealtime : { false, true })
+            {
+                AuDemoProcessor processor;
+                processor.setNonRealtime(nonRealtime);
+                processor.setPlayConfigDetails(2, 2, SAMPLE_RATE, BLOCK_SIZE);
+                processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+
+                juce::AudioBuffer<float> buffer(2, BLOCK_SIZE);
+                juce::MidiBuffer midi;
+                juce::Random random(99);
+                const int blockSizes[] = { BLOCK_SIZE, 1, 17, 64, 300, BLOCK_SIZE };
+                int allocations = 0;
+
+                for (int round = 0; round < 40; ++round)
+                {
+                    // Host automation, program changes and A/B switches happen
+                    // off the audio thread, outside the counted scope
+                    setParameter(processor, "peakReduction", random.nextFloat() * 100.0f);
+                    setParameter(processor, "gain", random.nextFloat() * 20.0f - 5.0f);
+                    setParameter(processor, "tpCeiling", round % 3 == 0 ? 1.0f : 0.0f);
+
+                    if (round % 10 == 5)
+                        processor.setCurrentProgram(round % processor.getNumPrograms());
+
+                    if (round % 7 == 3)
+                        processor.selectABSlot(1 - processor.getABSlot());
+
+                    for (const int blockSize : blockSizes)
+                    {
+                        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, 0, blockSize);
+                        fill(block, 0.6f * random.nextFloat());
+
+                        const AllocationCounter::ScopedCount count;
+                        processor.processBlock(block, midi);
+                        allocations += count.getCount();
+                    }
+                }
+
+                expectEquals(allocations, 0, nonRealtime ? "Offline processBlock allocated" : "Realtime processBlock allocated");
+            }
+        }
+
+        beginTest("NaN/Inf input");
+        {
+            AuDemoProcessor processor;
+            processor.setPlayConfigDetails(2, 2, SAMPLE_RATE, BLOCK_SIZE);
+            processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+            setParameter(processor, "peakReduction", 60.0f);
+
+            juce::AudioBuffer<float> buffer(2, BLOCK_SIZE);
+            juce::MidiBuffer midi;
+            const int before = processor.getNumNonFiniteEvents();
+
+            for (const float bad : { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity() })
+            {
+                fill(buffer, 0.5f);
+                buffer.setSample(0, 3, bad);
+                buffer.setSample(1, BLOCK_SIZE - 1, -bad);
+                processor.processBlock(buffer, midi);
+                expect(! SampleSanitizer::containsNonFinite(buffer), "Non-finite output");
+            }
+
+            expectEquals(processor.getNumNonFiniteEvents() - before, 2);
+
+            for (int block = 0; block < 10; ++block)
+            {
+                fill(buffer, 0.5f);
+                processor.processBlock(buffer, midi);
+            }
+
+            expect(! SampleSanitizer::containsNonFinite(buffer), "Non-finite output on clean input");
+            expectGreaterThan(buffer.getMagnitude(0, BLOCK_SIZE), 0.1f, "Silent after NaN/Inf input");
+            expectEquals(processor.getNumNonFiniteEvents() - before, 2, "Clean input counted");
+        }
+    }
+
+private:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int BLOCK_SIZE = 512;
+
+    std::vector<float> allocationProbe;
+
+    static juce::AudioProcessor::BusesLayout makeLayout(const juce::AudioChannelSet& input, const juce::AudioChannelSet& output)
+    {
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(input);
+        layout.outputBuses.add(output);
+        return layout;
+    }
+
+    static void fill(juce::AudioBuffer<float>& buffer, float level)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(ch, i, level * static_cast<float>(std::sin(0.05 * i + ch)));
+    }
+};
+
+static ProcessorTests processorTests;
@@ -0,0 +1,733 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include "AllocationCounter.h"
+#include "HarnessHelpers.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+/**
+ * Soak and drift harness
+ *
+ * Streams synthetic broadcast program (speech, music, tones, transients and
+ * silence gaps at changing levels) through AuDemoProcessor for days of
+ * simulated time, as fast as the machine runs it, with parameter automation,
+ * program changes and A/B switches along the way. As in a host, processing
+ * runs on its own thread while the main thread runs the message loop, and a
+ * third thread reads the meters, loudness, DSP load and telemetry the way the
+ * editor does.
+ *
+ * At every checkpoint (default each 10 simulated minutes) a fixed probe runs:
+ * two minutes of silence, so the envelopes come to rest, then 3 s of 1 kHz at
+ * fixed settings. Per checkpoint it records:
+ * - envelope drift: gain reduction and output level at the end of the probe
+ * - denormals and NaN/Inf: in the output, the meters and the telemetry
+ * - CPU: mean and p99 time per block of program
+ * - memory: resident size, and allocations made inside processBlock
+ * - meters: values out of range, block counters going backwards
+ *
+ * Exits with 1 on any numeric anomaly or allocation, when the probe moves more
+ * than --drift-db from the first checkpoint, and on growth: median block time
+ * of the last quarter of checkpoints over the first quarter (the first
+ * checkpoint is warm-up) by more than --cpu-growth percent, or resident size
+ * by more than --memory-growth-kib.
+ *
+ * Usage: LA2ATeroSoak [--hours=H | --days=D] [--checkpoint-minutes=M]
+ *                     [--rate=Hz] [--block=N] [--seed=N] [--drift-db=dB]
+ *                     [--cpu-growth=%] [--memory-growth-kib=KiB] [--csv=<file>]
+ */
+namespace
+{
+using HarnessHelpers::residentBytes;
+using HarnessHelpers::setParameter;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double PROBE_SILENCE_SECONDS = 120.0;
+constexpr double PROBE_TONE_SECONDS = 3.0;
+
+bool isSubnormal(float value)
+{
+    return std::fpclassify(value) == FP_SUBNORMAL;
+}
+
+double median(std::vector<double> values)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// Runs a message-thread action and waits for it. Program changes and A/B
+// switches made on the message thread set the parameters before returning,
+// so nothing reaches them afterwards to overwrite the settings made next.
+void callOnMessageThread(std::function<void()> action)
+{
+    juce::WaitableEvent done;
+
+    juce::MessageManager::callAsync([&action, &done] {
+        action();
+        done.signal();
+    });
+
+    done.wait();
+}
+
+//==============================================================================
+/** Synthetic broadcast program, in segments of random kind, length and level */
+class ProgramSource
+{
+public:
+    ProgramSource(double sampleRateToUse, juce::int64 seed) : sampleRate(sampleRateToUse), random(seed)
+    {
+        nextSegment();
+    }
+
+    void render(juce::AudioBuffer<float>& buffer)
+    {
+        auto* left = buffer.getWritePointer(0);
+        auto* right = buffer.getWritePointer(buffer.getNumChannels() > 1 ? 1 : 0);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            if (--remaining <= 0)
+                nextSegment();
+
+            const float sample = level * nextSample();
+            left[i] = sample * (1.0f - pan);
+            right[i] = sample * (1.0f + pan);
+        }
+    }
+
+private:
+    enum class Kind { speech, music, tone, transients, silence };
+
+    double sampleRate;
+    juce::Random random;
+
+    Kind kind = Kind::silence;
+    juce::int64 remaining = 0;
+    float level = 0.0f;
+    float pan = 0.0f;
+
+    // Phases in cycles, kept in [0, 1) so days of running lose no precision
+    double phases[3] {};
+    double increments[3] {};
+    double modulationPhase = 0.0;
+    double modulationIncrement = 0.0;
+    float modulationDepth = 0.0f;
+    float syllableLevel = 0.0f;
+    float lowpassed = 0.0f;
+    float burst = 0.0f;
+    float burstDecay = 0.0f;
+    juce::int64 untilChange = 0;
+
+    static float cycleSin(double phase) { return static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * phase)); }
+
+    static void advance(double& phase, double increment)
+    {
+        phase += increment;
+        if (phase >= 1.0)
+            phase -= 1.0;
+    }
+
+    juce::int64 seconds(double lengthSeconds) const { return juce::jmax(juce::int64 { 1 }, static_cast<juce::int64>(lengthSeconds * sampleRate)); }
+    double range(double low, double high) { return low + (high - low) * random.nextDouble(); }
+
+    void nextSegment()
+    {
+        // Mostly speech and music, with gaps, line-up tones and hits
+        const int pick = random.nextInt(100);
+        kind = pick < 35 ? Kind::speech : pick < 75 ? Kind::music : pick < 80 ? Kind::tone : pick < 90 ? Kind::transients : Kind::silence;
+
+        switch (kind)
+        {
+            case Kind::speech:     remaining = seconds(range(5.0, 180.0)); level = juce::Decibels::decibelsToGain(static_cast<float>(range(-30.0, -6.0))); break;
+            case Kind::music:      remaining = seconds(range(5.0, 240.0)); level = juce::Decibels::decibelsToGain(static_cast<float>(range(-30.0, 3.0))); break;
+            case Kind::tone:       remaining = seconds(range(1.0, 10.0)); level = juce::Decibels::decibelsToGain(static_cast<float>(range(-24.0, -9.0))); break;
+            case Kind::transients: remaining = seconds(range(2.0, 30.0)); level = juce::Decibels::decibelsToGain(static_cast<float>(range(-18.0, 0.0))); break;
+            case Kind::silence:    remaining = seconds(range(0.5, 30.0)); level = 0.0f; break;
+        }
+
+        pan = static_cast<float>(range(-0.3, 0.3));
+        untilChange = 0;
+        increments[0] = range(100.0, 5000.0) / sampleRate;
+        burstDecay = std::exp(-1.0f / (0.03f * static_cast<float>(sampleRate)));
+    }
+
+    float nextSample()
+    {
+        const float white = 2.0f * random.nextFloat() - 1.0f;
+        lowpassed += 0.05f * (white - lowpassed);
+
+        switch (kind)
+        {
+            case Kind::speech:
+            {
+                // Syllables at 3-6 Hz over a voiced fundamental and breath noise, with word gaps
+                if (--untilChange <= 0)
+                {
+                    const double syllableHz = range(3.0, 6.0);
+                    untilChange = seconds(1.0 / syllableHz);
+                    modulationIncrement = syllableHz / sampleRate;
+                    modulationPhase = 0.0;
+                    syllableLevel = random.nextInt(5) == 0 ? 0.0f : static_cast<float>(range(0.5, 1.0));
+                    increments[0] = range(100.0, 220.0) / sampleRate;
+                }
+
+                advance(phases[0], increments[0]);
+                advance(modulationPhase, modulationIncrement);
+                const float envelope = 0.5f - 0.5f * cycleSin(modulationPhase + 0.25);
+                return syllableLevel * envelope * envelope * (0.6f * cycleSin(phases[0]) + 1.6f * lowpassed);
+            }
+
+            case Kind::music:
+            {
+                // A three-note chord that changes every 2 s, slow tremolo, a little noise
+                if (--untilChange <= 0)
+                {
+                    untilChange = seconds(2.0);
+                    const double root = range(110.0, 440.0);
+                    increments[0] = root / sampleRate;
+                    increments[1] = root * 1.25 / sampleRate;
+                    increments[2] = root * 1.5 / sampleRate;
+                    modulationIncrement = range(0.1, 0.5) / sampleRate;
+                    modulationDepth = static_cast<float>(range(0.0, 0.5));
+                }
+
+                float sum = 0.0f;
+                for (int voice = 0; voice < 3; ++voice)
+                {
+                    advance(phases[voice], increments[voice]);
+                    sum += cycleSin(phases[voice]);
+                }
+
+                advance(modulationPhase, modulationIncrement);
+                return (0.3f * sum + 0.4f * lowpassed) * (1.0f - modulationDepth * (0.5f + 0.5f * cycleSin(modulationPhase)));
+            }
+
+            case Kind::tone:
+                advance(phases[0], increments[0]);
+                return cycleSin(phases[0]);
+
+            case Kind::transients:
+                // Noise hits decaying over 30 ms, every 0.2-1 s
+                if (--untilChange <= 0)
+                {
+                    untilChange = seconds(range(0.2, 1.0));
+                    burst = 1.0f;
+                }
+
+                burst *= burstDecay;
+                return burst * white;
+
+            case Kind::silence:
+                break;
+        }
+
+        return 0.0f;
+    }
+};
+
+//==============================================================================
+/** Reads everything the editor reads, continuously, and checks it */
+class MeterReader : public juce::Thread
+{
+public:
+    // switchCounter is odd while an A/B switch is in progress: the metered
+    // slot, and with it the block sequence, changes then
+    MeterReader(AuDemoProcessor& processorToRead, const std::atomic<juce::uint32>& switchCounter)
+        : juce::Thread("Soak meter reader"), processor(processorToRead), slotSwitches(switchCounter)
+    {
+    }
+
+    ~MeterReader() override { stopThread(1000); }
+
+    int getNumAnomalies() const { return numAnomalies.load(); }
+    juce::int64 getNumReads() const { return numReads.load(); }
+    juce::int64 getNumTelemetryRecords() const { return numRecords.load(); }
+
+    juce::StringArray getReports() const
+    {
+        const juce::ScopedLock lock(reportLock);
+        return reports;
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            readOnce();
+            wait(2);
+        }
+    }
+
+private:
+    AuDemoProcessor& processor;
+    const std::atomic<juce::uint32>& slotSwitches;
+
+    std::atomic<int> numAnomalies { 0 };
+    std::atomic<juce::int64> numReads { 0 };
+    std::atomic<juce::int64> numRecords { 0 };
+    juce::CriticalSection reportLock;
+    juce::StringArray reports;
+
+    juce::uint32 lastSwitch = 0;
+    juce::uint64 lastSequence = 0;
+    juce::int64 lastLoadBlocks = 0;
+    float lastMeasuredSeconds = 0.0f;
+
+    void report(const juce::String& what)
+    {
+        ++numAnomalies;
+
+        const juce::ScopedLock lock(reportLock);
+        if (reports.size() < 20)
+            reports.add(what);
+    }
+
+    void check(float value, const char* name, float low, float high)
+    {
+        if (! std::isfinite(value) || isSubnormal(value) || value < low || value > high)
+            report(juce::String(name) + " = " + juce::String(value, 9));
+    }
+
+    void readOnce()
+    {
+        const auto switchBefore = slotSwitches.load();
+        const auto snapshot = processor.getMeterSnapshot();
+        const auto switchAfter = slotSwitches.load();
+
+        if ((switchBefore & 1) == 0 && switchBefore == switchAfter)
+        {
+            if (switchBefore != lastSwitch)
+            {
+                lastSwitch = switchBefore;
+                lastSequence = 0;
+            }
+
+            if (snapshot.blockSequence < lastSequence)
+                report("Meter block sequence went back from " + juce::String(lastSequence) + " to " + juce::String(snapshot.blockSequence));
+
+            lastSequence = snapshot.blockSequence;
+        }
+
+        for (size_t ch = 0; ch < static_cast<size_t>(snapshot.numChannels); ++ch)
+        {
+            check(snapshot.inputPeak[ch], "inputPeak", 0.0f, 100.0f);
+            check(snapshot.inputRms[ch], "inputRms", 0.0f, 100.0f);
+            check(snapshot.outputPeak[ch], "outputPeak", 0.0f, 100.0f);
+            check(snapshot.outputRms[ch], "outputRms", 0.0f, 100.0f);
+        }
+
+        check(snapshot.blockGainReductionDb, "blockGainReductionDb", -200.0f, 0.0f);
+        check(snapshot.gainReductionDb, "gainReductionDb", -200.0f, 0.0f);
+        check(snapshot.outputLevelDb, "outputLevelDb", -200.0f, 60.0f);
+        check(snapshot.truePeakDb, "truePeakDb", -200.0f, 60.0f);
+        check(snapshot.truePeakMaxDb, "truePeakMaxDb", -200.0f, 60.0f);
+        check(snapshot.ceilingGainDb, "ceilingGainDb", -200.0f, 0.0f);
+
+        const auto loudness = processor.getLoudnessReadings();
+        check(loudness.momentaryLufs, "momentaryLufs", -200.0f, 60.0f);
+        check(loudness.shortTermLufs, "shortTermLufs", -200.0f, 60.0f);
+        check(loudness.integratedLufs, "integratedLufs", -200.0f, 60.0f);
+        check(loudness.loudnessRange, "loudnessRange", 0.0f, 200.0f);
+
+        if (loudness.measuredSeconds < lastMeasuredSeconds)
+            report("Loudness measured time went back from " + juce::String(lastMeasuredSeconds) + " s");
+
+        lastMeasuredSeconds = loudness.measuredSeconds;
+
+        const auto load = processor.getDspLoadStats();
+        if (! std::isfinite(load.loadProportion) || ! std::isfinite(load.meanNs) || load.numBlocks < lastLoadBlocks)
+            report("DSP load stats: load " + juce::String(load.loadProportion) + ", blocks " + juce::String(load.numBlocks));
+
+        lastLoadBlocks = load.numBlocks;
+
+        // Telemetry as the editor drains it
+        numRecords += processor.getTelemetryFifo().popAll([this](const BlockTelemetry& record) {
+            check(record.inputPeak, "telemetry inputPeak", 0.0f, 100.0f);
+            check(record.outputPeak, "telemetry outputPeak", 0.0f, 100.0f);
+            check(record.outputRms, "telemetry outputRms", 0.0f, 100.0f);
+            check(record.minGainDb, "telemetry minGainDb", -200.0f, 0.0f);
+            check(record.maxGainDb, "telemetry maxGainDb", -200.0f, 0.0f);
+
+            if (record.nonFiniteEvents != 0)
+                report("Telemetry reports " + juce::String(record.nonFiniteEvents) + " NaN/Inf events");
+        });
+
+        ++numReads;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(MeterReader)
+};
+
+//==============================================================================
+struct Checkpoint
+{
+    double simulatedHours = 0.0;
+    double realSeconds = 0.0;
+    double meanBlockUs = 0.0;
+    double p99BlockUs = 0.0;
+    double residentKiB = 0.0;
+    float probeGainReductionDb = 0.0f;
+    float probeOutputDb = 0.0f;
+    int subnormals = 0;
+    int nonFinite = 0;
+    int allocations = 0;
+};
+
+struct SoakSettings
+{
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    juce::int64 seed = 1;
+    double checkpointMinutes = 10.0;
+    int numCheckpoints = 1;
+};
+
+/** The audio side of a playout host: drives the processor and collects the checkpoints */
+class SoakRun : public juce::Thread
+{
+public:
+    SoakRun(const SoakSettings& settingsToUse, juce::OutputStream* csvStream)
+        : juce::Thread("Soak audio"), settings(settingsToUse), sampleRate(settings.sampleRate), blockSize(settings.blockSize),
+          program(sampleRate, settings.seed), random(settings.seed + 1), buffer(2, blockSize),
+          reader(processor, slotSwitches), csv(csvStream)
+    {
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+        blockTimes.reserve(1 << 16);
+        reader.startThread();
+    }
+
+    ~SoakRun() override
+    {
+        stopThread(-1);
+        reader.stopThread(1000);
+    }
+
+    AuDemoProcessor& getProcessor() { return processor; }
+    const MeterReader& getReader() const { return reader; }
+    const std::vector<Checkpoint>& getCheckpoints() const { return checkpoints; }
+
+    // Stops the message loop when done
+    void run() override
+    {
+        const auto blocksPerCheckpoint = juce::jmax(juce::int64 { 1 }, static_cast<juce::int64>(settings.checkpointMinutes * 60.0 * sampleRate / blockSize));
+        const auto startTime = Clock::now();
+
+        for (int index = 0; index < settings.numCheckpoints && ! threadShouldExit(); ++index)
+        {
+            auto checkpoint = runCheckpoint(blocksPerCheckpoint);
+            checkpoint.simulatedHours = (index + 1) * settings.checkpointMinutes / 60.0;
+            checkpoint.realSeconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+            checkpoints.push_back(checkpoint);
+            print(checkpoint);
+        }
+
+        juce::MessageManager::getInstance()->stopDispatchLoop();
+    }
+
+private:
+    SoakSettings settings;
+    double sampleRate;
+    int blockSize;
+    AuDemoProcessor processor;
+    ProgramSource program;
+    juce::Random random;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+    std::atomic<juce::uint32> slotSwitches { 0 };
+    MeterReader reader;
+    juce::OutputStream* csv;
+    std::vector<double> blockTimes;
+    std::vector<Checkpoint> checkpoints;
+    juce::int64 blocksToAutomation = 0;
+    int automationEvents = 0;
+
+    void print(const Checkpoint& checkpoint)
+    {
+        std::cout << juce::String(checkpoint.simulatedHours, 2).paddedLeft(' ', 8) << " h"
+                  << "  block mean " << juce::String(checkpoint.meanBlockUs, 2).paddedLeft(' ', 8) << " us"
+                  << "  p99 " << juce::String(checkpoint.p99BlockUs, 2).paddedLeft(' ', 8) << " us"
+                  << "  rss " << juce::String(juce::roundToInt(checkpoint.residentKiB)).paddedLeft(' ', 7) << " KiB"
+                  << "  probe GR " << juce::String(checkpoint.probeGainReductionDb, 4) << " dB"
+                  << " out " << juce::String(checkpoint.probeOutputDb, 4) << " dB"
+                  << "  subnormal " << checkpoint.subnormals << " nan/inf " << checkpoint.nonFinite
+                  << " alloc " << checkpoint.allocations
+                  << "  (" << juce::String(juce::roundToInt(checkpoint.realSeconds)) << " s)" << std::endl;
+
+        if (csv != nullptr)
+        {
+            *csv << juce::String(checkpoint.simulatedHours, 4) << ',' << juce::String(checkpoint.realSeconds, 1) << ','
+                 << juce::String(checkpoint.meanBlockUs, 3) << ',' << juce::String(checkpoint.p99BlockUs, 3) << ','
+                 << juce::String(juce::roundToInt(checkpoint.residentKiB)) << ',' << juce::String(checkpoint.probeGainReductionDb, 6) << ','
+                 << juce::String(checkpoint.probeOutputDb, 6) << ',' << checkpoint.subnormals << ','
+                 << checkpoint.nonFinite << ',' << checkpoint.allocations << '\n';
+            csv->flush();
+        }
+    }
+
+    Checkpoint runCheckpoint(juce::int64 numBlocks)
+    {
+        Checkpoint checkpoint;
+        blockTimes.clear();
+
+        for (juce::int64 block = 0; block < numBlocks; ++block)
+        {
+            if (--blocksToAutomation <= 0)
+                automate();
+
+            program.render(buffer);
+            const auto start = Clock::now();
+            process(checkpoint);
+            blockTimes.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+
+        double sum = 0.0;
+        for (auto time : blockTimes)
+            sum += time;
+
+        checkpoint.meanBlockUs = sum / static_cast<double>(juce::jmax(size_t { 1 }, blockTimes.size()));
+        const auto p99 = blockTimes.begin() + static_cast<std::ptrdiff_t>(blockTimes.size() * 99 / 100);
+        std::nth_element(blockTimes.begin(), p99, blockTimes.end());
+        checkpoint.p99BlockUs = blockTimes.empty() ? 0.0 : *p99;
+
+        runProbe(checkpoint);
+        checkpoint.residentKiB = static_cast<double>(residentBytes()) / 1024.0;
+        return checkpoint;
+    }
+
+    void process(Checkpoint& checkpoint)
+    {
+        {
+            const AllocationCounter::ScopedCount count;
+            processor.processBlock(buffer, midi);
+            checkpoint.allocations += count.getCount();
+        }
+
+        if ((slotSwitches.load() & 1) != 0)
+            ++slotSwitches;   // The switch has been adopted
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            const auto* samples = buffer.getReadPointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                checkpoint.subnormals += isSubnormal(samples[i]) ? 1 : 0;
+                checkpoint.nonFinite += std::isfinite(samples[i]) ? 0 : 1;
+            }
+        }
+    }
+
+    void selectSlot(int slot)
+    {
+        if (slot == processor.getABSlot())
+            return;
+
+        ++slotSwitches;
+        callOnMessageThread([this, slot] { processor.selectABSlot(slot); });
+    }
+
+    // Host automation every 10-120 s; a program change or an A/B switch every tenth time
+    void automate()
+    {
+        blocksToAutomation = static_cast<juce::int64>((10.0 + 110.0 * random.nextDouble()) * sampleRate / blockSize);
+
+        if (++automationEvents % 10 == 0)
+        {
+            if (random.nextBool())
+            {
+                const int index = random.nextInt(processor.getNumPrograms());
+                callOnMessageThread([this, index] { processor.setCurrentProgram(index); });
+            }
+            else
+            {
+                selectSlot(1 - processor.getABSlot());
+            }
+
+            return;
+        }
+
+        setParameter(processor, "peakReduction", 20.0f + 60.0f * random.nextFloat());
+        setParameter(processor, "gain", 15.0f * random.nextFloat());
+        setParameter(processor, "limitMode", random.nextInt(4) == 0 ? 1.0f : 0.0f);
+        setParameter(processor, "mix", 70.0f + 30.0f * random.nextFloat());
+        setParameter(processor, "tpCeiling", random.nextBool() ? 1.0f : 0.0f);
+        setParameter(processor, "tpCeilingDb", -1.0f - 2.0f * random.nextFloat());
+    }
+
+    // The same settings and stimulus every time, after long enough silence for
+    // the slow release (15 s at most) to have settled
+    void runProbe(Checkpoint& checkpoint)
+    {
+        selectSlot(0);
+
+        setParameter(processor, "peakReduction", 50.0f);
+        setParameter(processor, "gain", 0.0f);
+        setParameter(processor, "limitMode", 0.0f);
+        setParameter(processor, "compMode", 1.0f);
+        setParameter(processor, "mix", 100.0f);
+        setParameter(processor, "tpCeiling", 0.0f);
+
+        const auto silenceBlocks = static_cast<juce::int64>(PROBE_SILENCE_SECONDS * sampleRate / blockSize);
+        for (juce::int64 block = 0; block < silenceBlocks; ++block)
+        {
+            buffer.clear();
+            process(checkpoint);
+        }
+
+        const auto toneBlocks = static_cast<juce::int64>(PROBE_TONE_SECONDS * sampleRate / blockSize);
+        double phase = 0.0;
+
+        for (juce::int64 block = 0; block < toneBlocks; ++block)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const auto sample = 0.25f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * phase));
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+                phase += 1000.0 / sampleRate;
+                phase -= std::floor(phase);
+            }
+
+            process(checkpoint);
+        }
+
+        const auto snapshot = processor.getMeterSnapshot();
+        checkpoint.probeGainReductionDb = snapshot.blockGainReductionDb;
+        checkpoint.probeOutputDb = juce::Decibels::gainToDecibels(snapshot.outputRms[0], -200.0f);
+
+        // Back to program with fresh automation
+        blocksToAutomation = 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(SoakRun)
+};
+
+// Median of the last quarter over the median of the first (after warm-up)
+bool grew(const std::vector<Checkpoint>& checkpoints, double Checkpoint::* field, double allowedIncrease, double& first, double& last)
+{
+    const size_t quarter = (checkpoints.size() - 1) / 4;
+    std::vector<double> early, late;
+
+    for (size_t i = 1; i <= quarter; ++i)
+        early.push_back(checkpoints[i].*field);
+
+    for (size_t i = checkpoints.size() - quarter; i < checkpoints.size(); ++i)
+        late.push_back(checkpoints[i].*field);
+
+    first = median(early);
+    last = median(late);
+    return last > first + allowedIncrease;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    auto option = [&args](const char* name, double fallback) {
+        return args.containsOption(name) ? args.getValueForOption(name).getDoubleValue() : fallback;
+    };
+
+    const double hours = args.containsOption("--days") ? 24.0 * option("--days", 1.0) : option("--hours", 24.0);
+    const double checkpointMinutes = juce::jmax(1.0, option("--checkpoint-minutes", 10.0));
+    const double sampleRate = juce::jmax(8000.0, option("--rate", 48000.0));
+    const int blockSize = juce::jmax(1, static_cast<int>(option("--block", 512.0)));
+    const double driftDb = option("--drift-db", 0.05);
+    const double cpuGrowth = option("--cpu-growth", 50.0);
+    const double memoryGrowthKiB = option("--memory-growth-kib", 1024.0);
+
+    SoakSettings settings;
+    settings.sampleRate = sampleRate;
+    settings.blockSize = blockSize;
+    settings.seed = static_cast<juce::int64>(option("--seed", 1.0));
+    settings.checkpointMinutes = checkpointMinutes;
+    settings.numCheckpoints = juce::jmax(1, static_cast<int>(std::ceil(hours * 60.0 / checkpointMinutes)));
+
+    std::unique_ptr<juce::FileOutputStream> csv;
+    if (args.containsOption("--csv"))
+    {
+        csv = std::make_unique<juce::FileOutputStream>(args.getFileForOption("--csv"));
+        csv->setPosition(0);
+        csv->truncate();
+        *csv << "simulated_hours,real_seconds,mean_block_us,p99_block_us,resident_kib,probe_gr_db,probe_output_db,subnormals,non_finite,allocations\n";
+    }
+
+    std::cout << "LA2ATero soak: " << juce::String(hours, 2) << " simulated hours at " << sampleRate << " Hz, "
+              << blockSize << "-sample blocks, checkpoint every " << checkpointMinutes << " min" << std::endl;
+
+    SoakRun run(settings, csv.get());
+    run.startThread();
+    juce::MessageManager::getInstance()->runDispatchLoop();
+    run.stopThread(-1);
+
+    const auto& checkpoints = run.getCheckpoints();
+    if (checkpoints.empty())
+        return 1;
+
+    // Verdict
+    juce::StringArray failures;
+    const auto& first = checkpoints.front();
+
+    for (const auto& checkpoint : checkpoints)
+    {
+        const auto at = " at " + juce::String(checkpoint.simulatedHours, 2) + " h";
+
+        if (checkpoint.allocations > 0)
+            failures.add(juce::String(checkpoint.allocations) + " allocations in processBlock" + at);
+
+        if (checkpoint.subnormals > 0 || checkpoint.nonFinite > 0)
+            failures.add(juce::String(checkpoint.subnormals) + " subnormal and " + juce::String(checkpoint.nonFinite) + " NaN/Inf output samples" + at);
+
+        if (std::abs(checkpoint.probeGainReductionDb - first.probeGainReductionDb) > driftDb
+            || std::abs(checkpoint.probeOutputDb - first.probeOutputDb) > driftDb)
+            failures.add("Probe drifted" + at + ": GR " + juce::String(first.probeGainReductionDb, 4) + " -> "
+                         + juce::String(checkpoint.probeGainReductionDb, 4) + " dB, output "
+                         + juce::String(first.probeOutputDb, 4) + " -> " + juce::String(checkpoint.probeOutputDb, 4) + " dB");
+    }
+
+    if (run.getProcessor().getNumNonFiniteEvents() > 0)
+        failures.add(juce::String(run.getProcessor().getNumNonFiniteEvents()) + " NaN/Inf events on clean program");
+
+    const auto& reader = run.getReader();
+    for (const auto& report : reader.getReports())
+        failures.add("Meters: " + report);
+
+    if (reader.getNumAnomalies() > reader.getReports().size())
+        failures.add("Meters: " + juce::String(reader.getNumAnomalies() - reader.getReports().size()) + " more anomalies");
+
+    std::cout << "meter reads " << reader.getNumReads() << ", telemetry records " << reader.getNumTelemetryRecords() << std::endl;
+
+    if (checkpoints.size() >= 5)
+    {
+        double early = 0.0, late = 0.0;
+
+        if (grew(checkpoints, &Checkpoint::meanBlockUs, 0.0, early, late) && late > early * (1.0 + cpuGrowth / 100.0))
+            failures.add("Block time grew from " + juce::String(early, 2) + " to " + juce::String(late, 2) + " us");
+
+        if (grew(checkpoints, &Checkpoint::residentKiB, memoryGrowthKiB, early, late))
+            failures.add("Resident memory grew from " + juce::String(juce::roundToInt(early)) + " to " + juce::String(juce::roundToInt(late)) + " KiB");
+    }
+    else
+    {
+        std::cout << "too few checkpoints for the growth checks (5 needed)" << std::endl;
+    }
+
+    for (const auto& failure : failures)
+        std::cout << "FAIL: " << failure << std::endl;
+
+    if (failures.isEmpty())
+        std::cout << "PASS" << std::endl;
+
+    return failures.isEmpty() ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+#include "PluginProcessor.h"
+#include "PluginState.h"
+#include "HarnessHelpers.h"
+
+using HarnessHelpers::setParameter;
+
+/**
+ * Plugin state tests
+ *
+ * - Round trip: every parameter, both A/B slots with the selection, and the
+ *   held true-peak maximum survive save/load through the binary format
+ * - Corpus: checked-in blobs from earlier versions (legacy XML) and from each
+ *   binary version load with the values in their .expected sidecar files;
+ *   parameters a blob doesn't mention load as defaults; a blob from a future
+ *   version is rejected
+ * - Malformed data leaves the current state untouched
+ */
+class PluginStateTests : public juce::UnitTest
+{
+public:
+    PluginStateTests() : juce::UnitTest("Plugin state", "LA2ATero") {}
+
+    void runTest() override
+    {
+        beginTest("Binary round trip");
+        {
+            AuDemoProcessor source;
+            prepare(source);
+
+            // Slot A keeps these; B starts as a copy and is changed below
+            setParameter(source, "peakReduction", 21.0f);
+            setParameter(source, "gain", 5.5f);
+            source.selectABSlot(1);
+
+            setParameter(source, "peakReduction", 47.3f);
+            setParameter(source, "gain", -3.2f);
+            setParameter(source, "limitMode", 1.0f);
+            setParameter(source, "compMode", 0.0f);
+            setParameter(source, "mix", 71.0f);
+            setParameter(source, "tpCeiling", 1.0f);
+            setParameter(source, "tpCeilingDb", -2.5f);
+            setParameter(source, "meterMode", 1.0f);
+            processBlock(source, 0.7f);
+
+            const float truePeakMaxDb = source.getMeterSnapshot().truePeakMaxDb;
+            expect(truePeakMaxDb > -10.0f, "Loud block should set a held true peak");
+
+            juce::MemoryBlock saved;
+            source.getStateInformation(saved);
+            expect(PluginState::isBinary(saved.getData(), static_cast<int>(saved.getSize())));
+
+            AuDemoProcessor restored;
+            prepare(restored);
+            restored.setStateInformation(saved.getData(), static_cast<int>(saved.getSize()));
+            processBlock(restored, 0.0f);
+
+            for (auto* parameter : source.getParameters())
+            {
+                const auto id = getParameterId(parameter);
+                expectWithinAbsoluteError(getParameter(restored, id), getParameter(source, id), 1.0e-4f, id);
+            }
+
+            expectWithinAbsoluteError(restored.getMeterSnapshot().truePeakMaxDb, truePeakMaxDb, 1.0e-4f);
+
+            // The selection and the other slot came along
+            expectEquals(restored.getABSlot(), 1);
+            source.selectABSlot(0);
+            restored.selectABSlot(0);
+            expectWithinAbsoluteError(getParameter(restored, "peakReduction"), 21.0f, 1.0e-4f);
+
+            for (auto* parameter : source.getParameters())
+            {
+                const auto id = getParameterId(parameter);
+                expectWithinAbsoluteError(getParameter(restored, id), getParameter(source, id), 1.0e-4f, "Slot A: " + id);
+            }
+        }
+
+        beginTest("Corpus");
+        {
+            const juce::File corpus(LA2A_TEST_CORPUS_DIR);
+            const auto blobs = corpus.findChildFiles(juce::File::findFiles, false, "*.bin");
+            expect(! blobs.isEmpty(), "No corpus blobs in " + corpus.getFullPathName());
+
+            for (const auto& blob : blobs)
+                checkCorpusBlob(blob);
+        }
+
+        beginTest("Malformed data is ignored");
+        {
+            AuDemoProcessor processor;
+            prepare(processor);
+            setParameter(processor, "peakReduction", 12.0f);
+
+            juce::MemoryBlock saved;
+            processor.getStateInformation(saved);
+
+            const juce::uint8 garbage[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+            processor.setStateInformation(garbage, static_cast<int>(sizeof(garbage)));
+            processor.setStateInformation(saved.getData(), PluginState::HEADER_SIZE + 4);   // Truncated
+            processor.setStateInformation(nullptr, 0);
+
+            expectWithinAbsoluteError(getParameter(processor, "peakReduction"), 12.0f, 1.0e-4f);
+        }
+    }
+
+private:
+    static void prepare(AuDemoProcessor& processor)
+    {
+        processor.setPlayConfigDetails(2, 2, 48000.0, 512);
+        processor.prepareToPlay(48000.0, 512);
+    }
+
+    static void processBlock(AuDemoProcessor& processor, float amplitude)
+    {
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::MidiBuffer midi;
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(ch, i, amplitude * std::sin(0.1f * static_cast<float>(i)));
+
+        processor.processBlock(buffer, midi);
+    }
+
+    static juce::String getParameterId(juce::AudioProcessorParameter* parameter)
+    {
+        if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+            return withId->paramID;
+
+        return {};
+    }
+
+    static float getParameter(AuDemoProcessor& processor, const juce::String& id)
+    {
+        return processor.getApvts().getRawParameterValue(id)->load();
+    }
+
+    void checkCorpusBlob(const juce::File& blob)
+    {
+        const auto blobName = blob.getFileNameWithoutExtension();
+
+        juce::MemoryBlock data;
+        expect(blob.loadFileAsData(data), blobName);
+
+        // Sidecar lines are id=value; # starts a comment
+        juce::StringPairArray expected;
+        juce::StringArray lines;
+        lines.addLines(blob.withFileExtension("expected").loadFileAsString());
+
+        for (const auto& line : lines)
+            if (line.isNotEmpty() && ! line.startsWith("#"))
+                expected.set(line.upToFirstOccurrenceOf("=", false, false).trim(),
+                             line.fromFirstOccurrenceOf("=", false, false).trim());
+
+        AuDemoProcessor processor;
+        prepare(processor);
+        processor.setStateInformation(data.getData(), static_cast<int>(data.getSize()));
+        processBlock(processor, 0.0f);
+
+        auto checkAll = [&](AuDemoProcessor& loaded, const juce::String& context) {
+            for (auto* parameter : loaded.getParameters())
+            {
+                const auto id = getParameterId(parameter);
+                auto* ranged = loaded.getApvts().getParameter(id);
+                const float value = expected.containsKey(id) ? expected[id].getFloatValue()
+                                                             : ranged->convertFrom0to1(ranged->getDefaultValue());
+
+                expectWithinAbsoluteError(getParameter(loaded, id), value, 1.0e-4f, context + ": " + id);
+            }
+
+            const float truePeakMaxDb = expected.containsKey("truePeakMaxDb") ? expected["truePeakMaxDb"].getFloatValue()
+                                                                             : -100.0f;
+            expectWithinAbsoluteError(loaded.getMeterSnapshot().truePeakMaxDb, truePeakMaxDb, 1.0e-4f,
+                                      context + ": truePeakMaxDb");
+        };
+
+        checkAll(processor, blobName);
+
+        // Re-saving always produces the current binary format, with the same values
+        juce::MemoryBlock resaved;
+        processor.getStateInformation(resaved);
+        expect(PluginState::isBinary(resaved.getData(), static_cast<int>(resaved.getSize())), blobName + ": resave format");
+
+        AuDemoProcessor reloaded;
+        prepare(reloaded);
+        reloaded.setStateInformation(resaved.getData(), static_cast<int>(resaved.getSize()));
+        processBlock(reloaded, 0.0f);
+        checkAll(reloaded, blobName + " (resaved)");
+    }
+};
+
+static PluginStateTests pluginStateTests;
@@ -0,0 +1,32 @@
+#include <juce_events/juce_events.h>
+#include <iostream>
+
+/**
+ * LA2ATero test runner
+ *
+ * Runs every juce::UnitTest registered in this executable (or only those in
+ * --category=<name>) and returns non-zero if any expectation failed, so it can
+ * be driven by CTest.
+ *
+ * Usage: LA2ATeroTests [--category=<name>]
+ */
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (args.containsOption("--category"))
+        runner.runTestsInCategory(args.getValueForOption("--category"));
+    else
+        runner.runAllTests();
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+
+    std::cout << (failures == 0 ? "All tests passed" : juce::String(failures) + " failure(s)") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,332 @@
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "dsp/OptoCompressor.h"
+#include "dsp/LoudnessMeter.h"
+#include "dsp/TruePeakDetector.h"
+#include "dsp/TruePeakLimiter.h"
+#include <algorithm>
+#include <iostream>
+
+/**
+ * Two-pass loudness-targeted offline render
+ *
+ * Pass 1 compresses the input with OptoCompressor and measures integrated
+ * loudness and true peak of the result. Pass 2 applies the static gain that
+ * brings it to the target loudness; if that gain would push the true peak
+ * over the ceiling, pass 2 also runs the true-peak limiter.
+ *
+ * The compressed audio between the passes lives in a memory-mapped temporary
+ * file (planar float32), so memory use does not grow with program length.
+ *
+ * Usage: LA2ATeroRender --input=in.wav --output=out.wav [--target=-16]
+ *                       [--ceiling=-1] [--peak-reduction=40] [--gain=0]
+ *                       [--mode=comp|limit|british] [--mix=100] [--bits=24]
+ */
+namespace
+{
+constexpr int BLOCK_SIZE = 4096;
+
+struct Settings
+{
+    juce::File input;
+    juce::File output;
+    float targetLufs = -16.0f;
+    float ceilingDb = -1.0f;
+    float peakReduction = 40.0f;
+    float gainDb = 0.0f;
+    juce::String mode = "comp";
+    float mix = 100.0f;
+    int bitsPerSample = 24;
+};
+
+struct Measurement
+{
+    float integratedLufs = LoudnessMeter::NO_LOUDNESS;
+    float loudnessRange = 0.0f;
+    float truePeakDb = -100.0f;
+};
+
+// Planar float32 audio in a memory-mapped temporary file
+class MappedAudio
+{
+public:
+    MappedAudio(int numChannelsIn, juce::int64 numSamplesIn)
+        : numChannels(numChannelsIn), numSamples(numSamplesIn)
+    {
+        const auto bytes = static_cast<juce::int64>(sizeof(float)) * numChannels * numSamples;
+
+        // Extend the file to its full size without writing every byte
+        {
+            juce::FileOutputStream stream(tempFile.getFile());
+            if (stream.failedToOpen() || ! stream.setPosition(std::max<juce::int64>(0, bytes - 1)))
+                return;
+
+            stream.writeByte(0);
+        }
+
+        map = std::make_unique<juce::MemoryMappedFile>(tempFile.getFile(), juce::MemoryMappedFile::readWrite);
+    }
+
+    ~MappedAudio()
+    {
+        map.reset();   // Unmap before the temporary file is deleted
+    }
+
+    bool isValid() const { return map != nullptr && map->getData() != nullptr; }
+
+    float* getChannel(int channel, juce::int64 position) const
+    {
+        return static_cast<float*>(map->getData()) + static_cast<juce::int64>(channel) * numSamples + position;
+    }
+
+    const int numChannels;
+    const juce::int64 numSamples;
+
+private:
+    juce::TemporaryFile tempFile { ".f32" };
+    std::unique_ptr<juce::MemoryMappedFile> map;
+};
+
+// Drops the first `latency` samples of a delayed stream and caps it at `length`,
+// so the rendered output lines up with the input
+class LatencyTrim
+{
+public:
+    LatencyTrim(int latency, juce::int64 length) : toSkip(latency), remaining(length) {}
+
+    // Calls write(buffer, startSample, numSamples) for the part of the block that is kept
+    template <typename Writer>
+    void push(const juce::AudioBuffer<float>& buffer, Writer&& write)
+    {
+        const int skip = static_cast<int>(std::min<juce::int64>(toSkip, buffer.getNumSamples()));
+        toSkip -= skip;
+
+        const auto keep = static_cast<int>(std::min<juce::int64>(remaining, buffer.getNumSamples() - skip));
+        if (keep > 0)
+            write(buffer, skip, keep);
+
+        remaining -= keep;
+    }
+
+    bool isComplete() const { return remaining <= 0; }
+
+private:
+    juce::int64 toSkip;
+    juce::int64 remaining;
+};
+
+void configureCompressor(OptoCompressor& compressor, const Settings& settings)
+{
+    compressor.setPeakReduction(settings.peakReduction);
+    compressor.setGain(settings.gainDb);
+    compressor.setMix(settings.mix);
+
+    // Same mapping as the plugin's LIMIT/COMP buttons
+    compressor.setBritishMode(settings.mode == "british");
+    compressor.setLimitMode(settings.mode == "limit");
+    compressor.setTruePeakCeiling(false, settings.ceilingDb);
+    compressor.setHighQuality(true);   // Offline: per-sample adaptive release
+}
+
+Measurement compressToMap(juce::AudioFormatReader& reader, const Settings& settings, MappedAudio& mapped)
+{
+    const int numChannels = mapped.numChannels;
+
+    OptoCompressor compressor;
+    compressor.prepare(reader.sampleRate, BLOCK_SIZE, numChannels);
+    configureCompressor(compressor, settings);
+
+    LoudnessMeter loudness;
+    loudness.prepare(reader.sampleRate, numChannels, false);
+
+    juce::AudioBuffer<float> block(numChannels, BLOCK_SIZE);
+    LatencyTrim trim(compressor.getLatencySamples(), mapped.numSamples);
+    juce::int64 readPosition = 0;
+    juce::int64 writePosition = 0;
+
+    auto store = [&](const juce::AudioBuffer<float>& buffer, int start, int num) {
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::copy(mapped.getChannel(ch, writePosition), buffer.getReadPointer(ch, start), num);
+
+        writePosition += num;
+    };
+
+    // Input, then silence to flush the compressor's output delay
+    while (! trim.isComplete())
+    {
+        const auto num = static_cast<int>(std::min<juce::int64>(BLOCK_SIZE, reader.lengthInSamples - readPosition));
+        block.clear();
+
+        if (num > 0)
+            reader.read(&block, 0, num, readPosition, true, numChannels > 1);
+
+        readPosition += BLOCK_SIZE;
+
+        compressor.processBlock(block);
+        loudness.process(block);
+        loudness.analyse();
+        trim.push(block, store);
+    }
+
+    Measurement result;
+    result.integratedLufs = loudness.getReadings().integratedLufs;
+    result.loudnessRange = loudness.getReadings().loudnessRange;
+    result.truePeakDb = compressor.getMeterSnapshot().truePeakMaxDb;
+    return result;
+}
+
+Measurement applyGainAndWrite(const MappedAudio& mapped, double sampleRate, float gainDb, bool limit,
+                              const Settings& settings, juce::AudioFormatWriter& writer)
+{
+    const int numChannels = mapped.numChannels;
+    const float gain = juce::Decibels::decibelsToGain(gainDb);
+
+    TruePeakLimiter limiter;
+    limiter.prepare(sampleRate, numChannels, BLOCK_SIZE);
+    limiter.setCeiling(limit, settings.ceilingDb);
+
+    LoudnessMeter loudness;
+    loudness.prepare(sampleRate, numChannels, false);
+    TruePeakDetector truePeak;
+    truePeak.prepare(numChannels);
+    float peak = 0.0f;
+
+    juce::AudioBuffer<float> block(numChannels, BLOCK_SIZE);
+    LatencyTrim trim(limit ? limiter.getLatencySamples() : 0, mapped.numSamples);
+    juce::int64 readPosition = 0;
+
+    auto write = [&](const juce::AudioBuffer<float>& buffer, int start, int num) {
+        const float* channels[LoudnessMeter::MAX_CHANNELS] = {};
+        for (int ch = 0; ch < juce::jmin(numChannels, LoudnessMeter::MAX_CHANNELS); ++ch)
+            channels[ch] = buffer.getReadPointer(ch, start);
+
+        peak = juce::jmax(peak, truePeak.process(channels, juce::jmin(numChannels, LoudnessMeter::MAX_CHANNELS), num));
+
+        const juce::AudioBuffer<float> kept(const_cast<float* const*>(buffer.getArrayOfReadPointers()), numChannels, start, num);
+        loudness.process(kept);
+        loudness.analyse();
+        writer.writeFromAudioSampleBuffer(kept, 0, num);
+    };
+
+    while (! trim.isComplete())
+    {
+        const auto num = static_cast<int>(std::min<juce::int64>(BLOCK_SIZE, mapped.numSamples - readPosition));
+        block.clear();
+
+        // Static gain, vectorized, straight out of the mapped file
+        for (int ch = 0; ch < numChannels && num > 0; ++ch)
+            juce::FloatVectorOperations::copyWithMultiply(block.getWritePointer(ch), mapped.getChannel(ch, readPosition), gain, num);
+
+        readPosition += BLOCK_SIZE;
+
+        if (limit)
+            limiter.process(block);
+
+        trim.push(block, write);
+    }
+
+    Measurement result;
+    result.integratedLufs = loudness.getReadings().integratedLufs;
+    result.loudnessRange = loudness.getReadings().loudnessRange;
+    result.truePeakDb = juce::Decibels::gainToDecibels(peak, -100.0f);
+    return result;
+}
+
+void printMeasurement(const char* label, const Measurement& m)
+{
+    std::cout << label << juce::String(m.integratedLufs, 1) << " LUFS integrated, "
+              << juce::String(m.loudnessRange, 1) << " LU range, "
+              << juce::String(m.truePeakDb, 1) << " dBTP" << std::endl;
+}
+
+int fail(const juce::String& message)
+{
+    std::cerr << message << std::endl;
+    return 1;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (! args.containsOption("--input") || ! args.containsOption("--output"))
+        return fail("Usage: LA2ATeroRender --input=in.wav --output=out.wav [--target=-16] [--ceiling=-1]\n"
+                    "                      [--peak-reduction=40] [--gain=0] [--mode=comp|limit|british]\n"
+                    "                      [--mix=100] [--bits=16|24|32]");
+
+    Settings settings;
+    settings.input = args.getFileForOption("--input");
+    settings.output = args.getFileForOption("--output");
+
+    auto floatOption = [&args](const char* option, float fallback) {
+        return args.containsOption(option) ? args.getValueForOption(option).getFloatValue() : fallback;
+    };
+
+    settings.targetLufs = floatOption("--target", settings.targetLufs);
+    settings.ceilingDb = juce::jlimit(-20.0f, 0.0f, floatOption("--ceiling", settings.ceilingDb));
+    settings.peakReduction = floatOption("--peak-reduction", settings.peakReduction);
+    settings.gainDb = floatOption("--gain", settings.gainDb);
+    settings.mix = floatOption("--mix", settings.mix);
+
+    if (args.containsOption("--mode"))
+        settings.mode = args.getValueForOption("--mode").toLowerCase();
+
+    if (args.containsOption("--bits"))
+        settings.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+
+    if (settings.mode != "comp" && settings.mode != "limit" && settings.mode != "british")
+        return fail("Unknown --mode " + settings.mode);
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(settings.input.existsAsFile() ? formats.createReaderFor(settings.input)
+                                                                                   : nullptr);
+    if (reader == nullptr)
+        return fail("Can't read " + settings.input.getFullPathName());
+
+    const auto numChannels = static_cast<int>(reader->numChannels);
+    if (numChannels < 1 || numChannels > LoudnessMeter::MAX_CHANNELS)
+        return fail("Only mono and stereo files are supported");
+
+    // Pass 1: compress into the mapped file and measure
+    MappedAudio mapped(numChannels, reader->lengthInSamples);
+    if (! mapped.isValid())
+        return fail("Can't map a temporary file for " + juce::String(reader->lengthInSamples) + " samples");
+
+    const auto pass1 = compressToMap(*reader, settings, mapped);
+    printMeasurement("Pass 1 (compressed): ", pass1);
+
+    if (pass1.integratedLufs <= LoudnessMeter::NO_LOUDNESS)
+        return fail("Program is below the loudness gate; nothing to normalise");
+
+    // Pass 2: static gain to the target, limiter only if the gain would break the ceiling
+    const float gainDb = settings.targetLufs - pass1.integratedLufs;
+    const bool limit = pass1.truePeakDb + gainDb > settings.ceilingDb;
+
+    std::cout << "Pass 2 gain " << juce::String(gainDb, 2) << " dB"
+              << (limit ? ", true-peak limiting to " + juce::String(settings.ceilingDb, 1) + " dBTP" : juce::String())
+              << std::endl;
+
+    settings.output.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream(settings.output.createOutputStream());
+    if (stream == nullptr)
+        return fail("Can't write " + settings.output.getFullPathName());
+
+    juce::WavAudioFormat wav;
+    const auto writerOptions = juce::AudioFormatWriterOptions{}
+                                   .withSampleRate(reader->sampleRate)
+                                   .withNumChannels(numChannels)
+                                   .withBitsPerSample(settings.bitsPerSample)
+                                   .withSampleFormat(settings.bitsPerSample == 32
+                                                         ? juce::AudioFormatWriterOptions::SampleFormat::floatingPoint
+                                                         : juce::AudioFormatWriterOptions::SampleFormat::integral);
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream, writerOptions));
+    if (writer == nullptr)
+        return fail("Unsupported output format (--bits " + juce::String(settings.bitsPerSample) + ")");
+
+    const auto pass2 = applyGainAndWrite(mapped, reader->sampleRate, gainDb, limit, settings, *writer);
+    printMeasurement("Pass 2 (output):     ", pass2);
+
+    return 0;
+}
@@ -0,0 +1,307 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#if JUCE_WINDOWS
+ #include <fcntl.h>
+ #include <io.h>
+#endif
+
+/**
+ * Headless raw PCM filter
+ *
+ * Reads interleaved little-endian PCM from stdin, runs it through the full
+ * plugin (AuDemoProcessor, offline quality path) and writes PCM in the same
+ * format to stdout, so the compressor can sit in an ffmpeg or sox pipeline
+ * without an audio device or a GUI.
+ *
+ * The byte buffers and the AudioBuffer are allocated once. Each block is
+ * converted straight from the stdin bytes into the processor's channel
+ * buffers and back into the stdout bytes by the AudioData converters, with no
+ * intermediate copies. The plugin's latency is trimmed from the start and
+ * flushed with silence at the end, so the output is exactly as long as the
+ * input. Messages go to stderr; stdout carries only audio.
+ *
+ * Usage: LA2ATeroPipe [--rate=48000] [--channels=2] [--format=f32|s16|s24]
+ *                     [--preset=name|index] [--block=16384] [--realtime]
+ *        LA2ATeroPipe --list-presets
+ */
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr int DEFAULT_BLOCK_SIZE = 16384;
+constexpr int MAX_CHANNELS = 2;
+
+struct Settings
+{
+    double sampleRate = 48000.0;
+    int numChannels = 2;
+    juce::String format = "f32";
+    juce::String preset;
+    int blockSize = DEFAULT_BLOCK_SIZE;
+    bool realtime = false;
+};
+
+// Converts between interleaved little-endian bytes and planar float channels
+struct PcmCodec
+{
+    int bytesPerSample = 0;
+    void (*deinterleave)(const void* source, float* const* channels, int numChannels, int numFrames) = nullptr;
+    void (*interleave)(const float* const* channels, void* dest, int numChannels, int numFrames) = nullptr;
+};
+
+template <typename SampleFormat>
+PcmCodec makeCodec(int bytesPerSample)
+{
+    using Interleaved = juce::AudioData::Format<SampleFormat, juce::AudioData::LittleEndian>;
+    using Planar = juce::AudioData::Format<juce::AudioData::Float32, juce::AudioData::NativeEndian>;
+    using Element = std::remove_pointer_t<decltype(SampleFormat::data)>;
+
+    PcmCodec codec;
+    codec.bytesPerSample = bytesPerSample;
+
+    codec.deinterleave = [](const void* source, float* const* channels, int numChannels, int numFrames) {
+        juce::AudioData::deinterleaveSamples(
+            juce::AudioData::InterleavedSource<Interleaved> { static_cast<const Element*>(source), numChannels },
+            juce::AudioData::NonInterleavedDest<Planar> { channels, numChannels },
+            numFrames);
+    };
+
+    codec.interleave = [](const float* const* channels, void* dest, int numChannels, int numFrames) {
+        juce::AudioData::interleaveSamples(
+            juce::AudioData::NonInterleavedSource<Planar> { channels, numChannels },
+            juce::AudioData::InterleavedDest<Interleaved> { static_cast<Element*>(dest), numChannels },
+            numFrames);
+    };
+
+    return codec;
+}
+
+bool getCodec(const juce::String& format, PcmCodec& codec)
+{
+    if (format == "f32")
+        codec = makeCodec<juce::AudioData::Float32>(4);
+    else if (format == "s16")
+        codec = makeCodec<juce::AudioData::Int16>(2);
+    else if (format == "s24")
+        codec = makeCodec<juce::AudioData::Int24>(3);
+    else
+        return false;
+
+    return true;
+}
+
+// Reads whole frames until the buffer is full or stdin ends; returns the number
+// of frames read. Bytes of a frame cut off by the end of input are counted in
+// partialBytes, not returned.
+int readFrames(char* dest, int frameBytes, int maxFrames, int& partialBytes)
+{
+    const auto wanted = static_cast<size_t>(frameBytes) * static_cast<size_t>(maxFrames);
+    size_t got = 0;
+
+    while (got < wanted)
+    {
+        const auto num = std::fread(dest + got, 1, wanted - got, stdin);
+        if (num == 0)
+            break;
+
+        got += num;
+    }
+
+    partialBytes = static_cast<int>(got % static_cast<size_t>(frameBytes));
+    return static_cast<int>(got / static_cast<size_t>(frameBytes));
+}
+
+// Looks a preset up by exact name, then case-insensitively, then by index
+int findPreset(const PresetBank& bank, const juce::String& preset)
+{
+    for (int i = 0; i < bank.getNumPresets(); ++i)
+        if (bank.getPreset(i).name == preset)
+            return i;
+
+    for (int i = 0; i < bank.getNumPresets(); ++i)
+        if (bank.getPreset(i).name.equalsIgnoreCase(preset))
+            return i;
+
+    if (preset.containsOnly("0123456789"))
+    {
+        const int index = preset.getIntValue();
+        if (juce::isPositiveAndBelow(index, bank.getNumPresets()))
+            return index;
+    }
+
+    return -1;
+}
+
+int fail(const juce::String& message)
+{
+    std::cerr << message << std::endl;
+    return 1;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    auto processor = std::make_unique<AuDemoProcessor>();
+    const auto& bank = processor->getPresetBank();
+
+    if (args.containsOption("--list-presets"))
+    {
+        for (int i = 0; i < bank.getNumPresets(); ++i)
+            std::cout << juce::String(i).paddedLeft(' ', 3) << "  " << bank.getPreset(i).name << std::endl;
+
+        return 0;
+    }
+
+    if (args.containsOption("--help|-h"))
+        return fail("Usage: LA2ATeroPipe [--rate=48000] [--channels=2] [--format=f32|s16|s24]\n"
+                    "                    [--preset=name|index] [--block=16384] [--realtime]\n"
+                    "       LA2ATeroPipe --list-presets\n"
+                    "Interleaved little-endian PCM in on stdin, processed PCM in the same format out on stdout.");
+
+    Settings settings;
+
+    if (args.containsOption("--rate"))
+        settings.sampleRate = args.getValueForOption("--rate").getDoubleValue();
+
+    if (args.containsOption("--channels"))
+        settings.numChannels = args.getValueForOption("--channels").getIntValue();
+
+    if (args.containsOption("--format"))
+        settings.format = args.getValueForOption("--format").toLowerCase();
+
+    if (args.containsOption("--preset"))
+        settings.preset = args.getValueForOption("--preset");
+
+    if (args.containsOption("--block"))
+        settings.blockSize = args.getValueForOption("--block").getIntValue();
+
+    settings.realtime = args.containsOption("--realtime");
+
+    if (settings.sampleRate < 8000.0 || settings.sampleRate > 384000.0)
+        return fail("--rate must be between 8000 and 384000");
+
+    if (settings.numChannels < 1 || settings.numChannels > MAX_CHANNELS)
+        return fail("Only mono and stereo (--channels=1|2) are supported");
+
+    if (settings.blockSize < 16 || settings.blockSize > 1 << 20)
+        return fail("--block must be between 16 and 1048576 frames");
+
+    PcmCodec codec;
+    if (! getCodec(settings.format, codec))
+        return fail("Unknown --format " + settings.format + " (f32, s16 or s24)");
+
+    if (settings.preset.isNotEmpty())
+    {
+        const int index = findPreset(bank, settings.preset);
+        if (index < 0)
+            return fail("Unknown --preset " + settings.preset + " (see --list-presets)");
+
+        // This is the message thread, so the parameters take the preset at once
+        processor->setCurrentProgram(index);
+    }
+
+   #if JUCE_WINDOWS
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+   #endif
+
+    const int numChannels = settings.numChannels;
+    const int blockSize = settings.blockSize;
+    const int frameBytes = codec.bytesPerSample * numChannels;
+
+    processor->setNonRealtime(! settings.realtime);
+    processor->setPlayConfigDetails(numChannels, numChannels, settings.sampleRate, blockSize);
+    processor->prepareToPlay(settings.sampleRate, blockSize);
+
+    // Everything the loop touches is allocated here
+    std::vector<char> inputBytes(static_cast<size_t>(frameBytes) * static_cast<size_t>(blockSize));
+    std::vector<char> outputBytes(inputBytes.size());
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::MidiBuffer midi;
+
+    juce::int64 toSkip = processor->getLatencySamples();
+    juce::int64 framesIn = 0;
+    juce::int64 framesOut = 0;
+    int partialBytes = 0;
+    bool endOfInput = false;
+    const auto start = Clock::now();
+
+    // Input, then silence to flush the plugin's output delay
+    while (! endOfInput || framesOut < framesIn)
+    {
+        int numFrames = blockSize;
+
+        if (! endOfInput)
+        {
+            numFrames = readFrames(inputBytes.data(), frameBytes, blockSize, partialBytes);
+            endOfInput = numFrames < blockSize;
+            framesIn += numFrames;
+
+            if (numFrames == 0)
+                continue;
+
+            codec.deinterleave(inputBytes.data(), buffer.getArrayOfWritePointers(), numChannels, numFrames);
+        }
+        else
+        {
+            buffer.clear();
+        }
+
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, 0, numFrames);
+        processor->processBlock(block, midi);
+
+        // Drop the latency, stop at the input length
+        const int skip = static_cast<int>(std::min<juce::int64>(toSkip, numFrames));
+        toSkip -= skip;
+
+        const auto keep = static_cast<int>(std::min<juce::int64>(framesIn - framesOut, numFrames - skip));
+        if (keep <= 0)
+            continue;
+
+        const float* channels[MAX_CHANNELS] = {};
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels[ch] = block.getReadPointer(ch, skip);
+
+        codec.interleave(channels, outputBytes.data(), numChannels, keep);
+
+        const auto bytes = static_cast<size_t>(keep) * static_cast<size_t>(frameBytes);
+        if (std::fwrite(outputBytes.data(), 1, bytes, stdout) != bytes)
+            return fail("Write to stdout failed");
+
+        framesOut += keep;
+    }
+
+    std::fflush(stdout);
+    processor->releaseResources();
+
+    if (std::ferror(stdin))
+        return fail("Read from stdin failed");
+
+    // Truncated input, or the wrong --format/--channels for it
+    if (partialBytes > 0)
+        return fail("Input ended inside a frame: " + juce::String(partialBytes)
+                    + (partialBytes == 1 ? " trailing byte" : " trailing bytes") + " dropped (frames are "
+                    + juce::String(frameBytes) + " bytes; check --format and --channels)");
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const double audioSeconds = static_cast<double>(framesIn) / settings.sampleRate;
+
+    std::cerr << "LA2ATeroPipe: " << framesIn << " frames (" << juce::String(audioSeconds, 1) << " s) in "
+              << juce::String(seconds, 2) << " s, "
+              << juce::roundToInt(audioSeconds / juce::jmax(seconds, 1.0e-6)) << "x real time";
+
+    if (processor->getNumNonFiniteEvents() > 0)
+        std::cerr << ", " << processor->getNumNonFiniteEvents() << " blocks with NaN/Inf input (bad samples zeroed) or state resets";
+
+    std::cerr << std::endl;
+    return 0;
+}